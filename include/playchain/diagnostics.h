@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tp {
+
+//Error caught by parser or builder method that returned empty result
+struct PlaychainDiagnosticRecord
+{
+    std::chrono::system_clock::time_point time;
+    //function name
+    std::string method;
+    //exception text, truncated to MAX_ERROR_LENGTH
+    std::string error;
+    //member of response that failed to decode (like "result[3].name"),
+    //innermost part is kept if path is longer than MAX_JSON_PATH_LENGTH,
+    //empty if error is not related to member
+    std::string json_path;
+    //errors of the same thread not recorded before this one (sampled out or ring was full)
+    uint64_t skipped = 0;
+};
+
+//Diagnostics of swallowed errors.
+//Every thread writes records to own ring buffer without locks and allocations,
+//records are moved out by drain. If ring of thread is full new records are skipped
+//(and counted) until it is drained, so error storm does not slow down caller.
+class PlaychainDiagnostics
+{
+public:
+    static const size_t RING_CAPACITY = 256;
+    static const size_t MAX_ERROR_LENGTH = 127;
+    static const size_t MAX_JSON_PATH_LENGTH = 63;
+
+    //1 to record every error (default)
+    static void setSampling(const size_t every_nth_error);
+
+    //records of all threads, ordered by thread and then by time
+    static std::vector<PlaychainDiagnosticRecord> drain();
+
+    //errors caught since start, recorded or not
+    static uint64_t errors();
+};
+
+} // namespace tp
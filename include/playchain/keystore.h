@@ -0,0 +1,53 @@
+#pragma once
+
+#include <playchain/playchain_types.h>
+#include <playchain/playchain_user.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tp {
+struct PlaychainKeystoreContext;
+
+struct PlaychainKeystoreRecord
+{
+    std::string name;
+    PlaychainUserId id;
+    std::string private_key_wif;
+};
+
+//File of many accounts for fast startup. Public keys are precomputed,
+//private keys are encrypted by key derived from password (PBKDF2,
+//AES-256-CTR). File is mapped to memory, opening reads only header and
+//every private key is decrypted when its user is requested.
+//Users are found by id or by name with binary search.
+class PlaychainKeystore
+{
+public:
+    static const uint32_t DEFAULT_KDF_ITERATIONS = 10000;
+
+    //parses WIF keys and computes public keys, ids and names must be unique
+    static void create(const std::string& path,
+                       const std::vector<PlaychainKeystoreRecord>& records,
+                       const std::string& password,
+                       const uint32_t kdf_iterations = DEFAULT_KDF_ITERATIONS);
+
+    PlaychainKeystore(const std::string& path, const std::string& password);
+    ~PlaychainKeystore();
+
+    size_t size() const;
+
+    //nullptr if there is no such user
+    std::unique_ptr<PlaychainUser> findUser(const PlaychainUserId& id) const;
+    std::unique_ptr<PlaychainUser> findUser(const std::string& name) const;
+
+    //without decryption of private key
+    bool findPublicKey(const PlaychainUserId& id, CompressedPublicKey& public_key) const;
+
+private:
+    std::unique_ptr<PlaychainKeystoreContext> m_context;
+};
+
+} // namespace tp
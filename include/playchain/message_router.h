@@ -0,0 +1,110 @@
+#pragma once
+
+#include <playchain/playchain_types.h>
+#include <playchain/parse_arena.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace tp {
+struct PlaychainParsedMessageContext;
+
+//JSON-RPC message parsed by PlaychainMessageRouter.
+//It is valid during handler call only, pass it to PlaychainResponseParser
+//overloads taking PlaychainParsedMessage to decode it without parsing again.
+class PlaychainParsedMessage
+{
+public:
+    enum class Kind : int
+    {
+        INVALID = 0,
+        RESPONSE,
+        NOTICE,
+    };
+
+    PlaychainParsedMessage() = default;
+    PlaychainParsedMessage(const PlaychainParsedMessageContext* context, const Kind kind,
+                           const int64_t id, const bool error)
+        : m_context(context)
+        , m_kind(kind)
+        , m_id(id)
+        , m_error(error)
+    {
+    }
+
+    Kind kind() const
+    {
+        return m_kind;
+    }
+
+    //JSON-RPC id of response or subscription identifier (cookie) of notice
+    int64_t id() const
+    {
+        return m_id;
+    }
+
+    //response with "error" instead of "result"
+    bool error() const
+    {
+        return m_error;
+    }
+
+    const PlaychainParsedMessageContext* context() const
+    {
+        return m_context;
+    }
+
+private:
+    const PlaychainParsedMessageContext* m_context = nullptr;
+    Kind m_kind = Kind::INVALID;
+    int64_t m_id = 0;
+    bool m_error = false;
+};
+
+//Parses every incoming message once and passes it to handler
+//registered for response id or notice subscription identifier.
+//Router is not thread safe.
+class PlaychainMessageRouter
+{
+public:
+    using Handler = std::function<void(const PlaychainParsedMessage&)>;
+
+    PlaychainMessageRouter() = default;
+
+    //one-shot handler of response with JSON-RPC id
+    void expectResponse(const int64_t id, const Handler&);
+    void cancelResponse(const int64_t id);
+
+    //handler of every notice with subscription identifier
+    void subscribe(const int64_t identifier, const Handler&);
+    void unsubscribe(const int64_t identifier);
+
+    //handler of messages without registered handler and invalid messages
+    void setDefaultHandler(const Handler&);
+
+    //Use own arena instead of default arena of calling thread
+    void setParseArena(const std::shared_ptr<PlaychainParseArena>&);
+
+    //Routes single message or every element of batch response
+    //(see BlockchainBatchRequest). Returns false if message (any element of batch)
+    //is invalid or there is no handler for it.
+    bool route(const BlockchainResponseView&);
+
+    size_t pendingResponses() const
+    {
+        return m_responses.size();
+    }
+
+private:
+    PlaychainParseArena& arena() const;
+    bool dispatch(const PlaychainParsedMessage&);
+
+    std::unordered_map<int64_t, Handler> m_responses;
+    std::unordered_map<int64_t, Handler> m_subscriptions;
+    Handler m_default;
+    std::shared_ptr<PlaychainParseArena> m_arena;
+};
+
+} // namespace tp
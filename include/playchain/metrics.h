@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tp {
+
+struct PlaychainMethodMetrics
+{
+    static const size_t LATENCY_BUCKETS = 32;
+
+    //builder, parser or signer
+    std::string category;
+    std::string method;
+
+    uint64_t calls = 0;
+    //errors reported by method: failed parses and builds, signing errors
+    uint64_t failures = 0;
+    //transactions made by builder, responses read by parser, digests signed
+    uint64_t bytes = 0;
+    //of sampled calls, clock is read only for every n-th call of thread
+    std::chrono::nanoseconds total_latency { 0 };
+    uint64_t latency_samples = 0;
+    //sampled calls with latency in [2^(i-1), 2^i) ns, the last bucket has all slower ones
+    std::array<uint64_t, LATENCY_BUCKETS> latency_histogram {};
+};
+
+//Calls of request builder, response parser and signing helpers.
+//Counters are collected only if library is built with PLAYCHAIN_METRICS,
+//otherwise calls are not instrumented and snapshot is empty.
+//Every thread counts own calls, counters are merged when they are read.
+class PlaychainMetrics
+{
+public:
+    //reading of clock costs more than counting for short calls
+    static const size_t DEFAULT_LATENCY_SAMPLING = 16;
+
+    static bool enabled();
+
+    //1 to measure latency of every call
+    static void setLatencySampling(const size_t every_nth_call);
+
+    //methods called since start or reset
+    static std::vector<PlaychainMethodMetrics> snapshot();
+    static void reset();
+
+    //Prometheus text exposition format
+    static std::string toPrometheus(const std::vector<PlaychainMethodMetrics>& metrics = snapshot());
+};
+
+} // namespace tp
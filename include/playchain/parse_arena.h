@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace tp {
+struct PlaychainParseArenaContext;
+
+struct PlaychainParseArenaStats
+{
+    //bytes of reusable buffers
+    size_t capacity = 0;
+    //max bytes used by single parse
+    size_t high_water_mark = 0;
+    size_t parses = 0;
+    //parses that did not fit into buffers (buffers are grown after them)
+    size_t overflows = 0;
+    //parses made with temporary heap memory because arena was in use
+    size_t fallbacks = 0;
+};
+
+//Memory for parsing JSON responses. It is reset rather than freed
+//between parses, so after warming up parse does not use heap.
+//Arena is not thread safe. Every thread has own default arena
+//that is used by PlaychainResponseParser if other one is not set.
+class PlaychainParseArena
+{
+public:
+    static const size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit PlaychainParseArena(const size_t initial_capacity = DEFAULT_CAPACITY);
+    ~PlaychainParseArena();
+
+    PlaychainParseArenaStats stats() const;
+
+    static PlaychainParseArena& threadDefault();
+
+    PlaychainParseArenaContext& context() const
+    {
+        return *m_context;
+    }
+
+private:
+    std::unique_ptr<PlaychainParseArenaContext> m_context;
+};
+
+} // namespace tp
@@ -3,14 +3,19 @@
 #include <playchain/playchain_types.h>
 
 #include <array>
+#include <vector>
 
 namespace tp {
 
 PrivateKey priv_key_from_brain_key(const std::string& brain_key);
 std::string priv_key_to_wif(const PrivateKey& key);
 PrivateKey priv_key_from_wif(const std::string& wif_key);
+///bulk import, checksums of all keys are computed at once
+std::vector<PrivateKey> priv_keys_from_wif(const std::vector<std::string>& wif_keys);
 
 CompressedPublicKey public_key_from_key(const PrivateKey& key);
+///bulk derivation, all keys share one secp256k1 context
+std::vector<CompressedPublicKey> public_keys_from_keys(const std::vector<PrivateKey>& keys);
 ///pub_key - ex. 02aa923ff63544ea12f0057dd81830db49cf590ba52ee7ae7e004b3f4fc06be56f
 ///              PLC6BcNK8CWGj6herX8nvhwEJ625QuaPAtmZPZ6yxQafFnSFnX9VY (wellformatted)
 CompressedPublicKey public_key_from_string(const std::string& pub_key);
@@ -25,7 +30,12 @@ Digest convert_digest(const std::string& hex_digest);
 CompactSignature convert_signature(const std::string& hex_sign);
 
 CompactSignature sign_digest(const Digest& digest, const PrivateKey& key, bool check_canonical = true);
+///bulk signing by one key, all digests share one secp256k1 context
+std::vector<CompactSignature> sign_digests(const std::vector<Digest>& digests, const PrivateKey& key, bool check_canonical = true);
 bool check_signature(const CompactSignature& sign, const Digest& digest, const CompressedPublicKey& key, bool check_canonical = true);
+///key that made signature of digest (signature carries recovery id),
+///signature is valid if it is the expected key
+CompressedPublicKey recover_public_key(const CompactSignature& sign, const Digest& digest, bool check_canonical = true);
 
 std::string to_hex(const char* d, uint32_t s);
 std::string to_hex(const uint8_t* d, uint32_t s);
@@ -103,6 +103,11 @@ struct PlaychainSettings
     bool all_legacy_from_wallet_api = false;
     //randomize transaction to make uniq for same data
     bool make_same_transactions_uniq = true;
+    //accept objects with absent fields (they keep default values)
+    bool lenient_json_decoding = false;
+    //reject objects with duplicated fields, otherwise the first one is decoded
+    //(it is not applied to lenient decoding)
+    bool unique_json_keys = false;
 };
 
 } // namespace tp
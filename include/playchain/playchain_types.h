@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <array>
 #include <map>
 #include <set>
+#include <stdexcept>
 #include <vector>
 
 namespace tp {
@@ -35,6 +37,8 @@ namespace tp {
         operator std::string() const;                                     \
                                                                           \
         static Playchain##OBJECT##Id from_string(const std::string& id);  \
+        static Playchain##OBJECT##Id from_string(const char* id,          \
+                                                 const size_t size);      \
     }
 
 DECLARE_PLAYCHAIN_ID(User, 1, 2, 0);
@@ -65,6 +69,14 @@ struct PlaychainPLC
     static const char* PLC();
 
     static PlaychainPLC from_string(const std::string& manual_plc_str);
+    static PlaychainPLC from_string(const char* manual_plc_str, const size_t size);
+
+    //digits of 64-bit amount with decimal point, space and PLC
+    static constexpr size_t max_chars = 32;
+
+    //writes string without terminating zero to buffer of max_chars,
+    //returns number of written characters
+    size_t format(char* out) const;
 
     operator PlaychainMoney() const
     {
@@ -88,7 +100,9 @@ private:
 struct ProtocolVersion
 {
     ProtocolVersion() {}
+    //"major.hardfork.revision[+metadata]", throws std::logic_error if version is invalid
     ProtocolVersion(const std::string& version);
+    ProtocolVersion(const char* version, const size_t size);
     ProtocolVersion(uint8_t m, uint8_t h, uint16_t r)
     {
         v_num = (0 | m) << 8;
@@ -127,6 +141,13 @@ struct ProtocolVersion
 
     operator std::string() const;
 
+    //"255.255.65535"
+    static constexpr size_t number_max_chars = 3 + 1 + 3 + 1 + 5;
+
+    //writes version number without metadata to buffer of number_max_chars,
+    //returns number of written characters
+    size_t format_number(char* out) const;
+
     uint32_t v_num = 0;
     std::string metadata;
 };
@@ -247,6 +268,34 @@ struct PlaychainTableInfoExt : public PlaychainTableInfo
     bool free() const;
 };
 
+//Fields of PlaychainTableInfoExt to decode. Members of fields
+//that are not requested are skipped while reading JSON
+//and fields keep default values.
+struct PlaychainTableFields
+{
+    enum : uint32_t
+    {
+        ID = 1u << 0,
+        METADATA = 1u << 1,
+        REQUIRED_WITNESSES = 1u << 2,
+        OWNER = 1u << 3,
+        OWNER_NAME = 1u << 4,
+        STATE = 1u << 5,
+        SERVER_URL = 1u << 6,
+        MIN_ACCEPTED_PROPOSAL_ASSET = 1u << 7,
+        PENDING_PROPOSALS = 1u << 8,
+        CASH = 1u << 9,
+        PLAYING_CASH = 1u << 10,
+        MISSED_VOTERS = 1u << 11,
+
+        //fields of PlaychainTableInfo
+        BASE = (1u << 8) - 1,
+        ALL = (1u << 12) - 1,
+    };
+};
+
+using PlaychainTableFieldsMask = uint32_t;
+
 struct PlayerInvitationInfo
 {
     PlaychainUserId inviter;
@@ -401,6 +450,62 @@ private:
     std::string _params;
 };
 
+//Requests packed into one JSON-RPC batch message:
+//[{"jsonrpc": "2.0", "id": N, "method": "call", "params": [api, method, [params]]}, ...]
+//Ids are assigned in order of adding starting from first id.
+//Batch response is split by PlaychainMessageRouter (see expectResponse).
+struct BlockchainBatchRequest
+{
+    explicit BlockchainBatchRequest(const int64_t first_id = 0)
+        : _first_id(first_id)
+    {
+    }
+
+    //returns id of added request
+    int64_t add(const BlockchainRequest& request);
+
+    static std::string to_string(const BlockchainBatchRequest& batch);
+
+    bool valid() const;
+
+    operator std::string() const
+    {
+        return to_string(*this);
+    }
+    std::string str() const
+    {
+        return (std::string)(*this);
+    }
+
+    size_t size() const
+    {
+        return _requests.size();
+    }
+    bool empty() const
+    {
+        return _requests.empty();
+    }
+
+    int64_t id(const size_t index) const
+    {
+        return _first_id + (int64_t)index;
+    }
+    //id for next batch
+    int64_t next_id() const
+    {
+        return id(size());
+    }
+
+    const std::vector<BlockchainRequest>& requests() const
+    {
+        return _requests;
+    }
+
+private:
+    int64_t _first_id = 0;
+    std::vector<BlockchainRequest> _requests;
+};
+
 struct BlockchainDigestTransaction
 {
     BlockchainDigestTransaction() = default;
@@ -442,4 +547,75 @@ private:
 
 using BlockchainResponse = std::string;
 
+//Response text passed to parser without copying.
+//In-situ view lets parser decode strings in place: the buffer
+//is modified while parsing, so it can be parsed only once.
+//Buffer must stay alive while parsing. Decoded string fields
+//of results are still copied out of the buffer.
+class BlockchainResponseView
+{
+public:
+    BlockchainResponseView(const BlockchainResponse& response)
+        : _data(response.c_str())
+        , _size(response.size())
+        , _null_terminated(true)
+    {
+    }
+    BlockchainResponseView(const char* data)
+        : _data(data)
+        , _size(data ? std::strlen(data) : 0)
+        , _null_terminated(data != nullptr)
+    {
+    }
+    BlockchainResponseView(const char* data, const size_t size)
+        : _data(data)
+        , _size(size)
+    {
+    }
+
+    //buffer[size] must be '\0' (parser stops at it), throws std::logic_error otherwise
+    static BlockchainResponseView insitu(char* buffer, const size_t size)
+    {
+        if (!buffer || buffer[size] != '\0')
+            throw std::logic_error("In-situ buffer is not null-terminated");
+
+        BlockchainResponseView result { buffer, size };
+        result._null_terminated = true;
+        result._insitu_buffer = buffer;
+        return result;
+    }
+    static BlockchainResponseView insitu(BlockchainResponse& response)
+    {
+        return insitu(&response[0], response.size());
+    }
+
+    const char* data() const
+    {
+        return _data;
+    }
+    size_t size() const
+    {
+        return _size;
+    }
+    bool insitu() const
+    {
+        return _insitu_buffer != nullptr;
+    }
+    char* insitu_buffer() const
+    {
+        return _insitu_buffer;
+    }
+    //data()[size()] is '\0', so parser may scan without bounds checks
+    bool null_terminated() const
+    {
+        return _null_terminated;
+    }
+
+private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+    bool _null_terminated = false;
+    char* _insitu_buffer = nullptr;
+};
+
 } // namespace tp
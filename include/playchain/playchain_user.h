@@ -13,6 +13,11 @@ public:
     PlaychainUser(const std::string& name,
                   const PlaychainUserId& id,
                   const std::string& private_key_wif);
+    ///for keys with known public key (ex. from PlaychainKeystore)
+    PlaychainUser(const std::string& name,
+                  const PlaychainUserId& id,
+                  const PrivateKey& private_key,
+                  const CompressedPublicKey& public_key);
     ~PlaychainUser();
 
     const std::string name() const;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <playchain/playchain_types.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace tp {
+struct PlaychainPublicKeyCacheContext;
+
+struct PlaychainPublicKeyCacheStats
+{
+    //max number of keys
+    size_t capacity = 0;
+    size_t size = 0;
+    //lookups of string by key and key by string
+    size_t hits = 0;
+    size_t misses = 0;
+    //least recently used keys that were removed to free space
+    size_t evictions = 0;
+};
+
+//Wellformatted (PLC...) strings of recently used public keys.
+//Every key is stored once with its string, so both
+//public_key_from_string and public_key_to_string find it
+//after any of them has converted the key.
+//Cache is thread safe. It is used by conversion functions of
+//playchain_helper.h, keys are evicted in LRU order.
+class PlaychainPublicKeyCache
+{
+public:
+    static const size_t DEFAULT_CAPACITY = 1024;
+
+    explicit PlaychainPublicKeyCache(const size_t capacity = DEFAULT_CAPACITY);
+    ~PlaychainPublicKeyCache();
+
+    bool find(const std::string& formatted_key, CompressedPublicKey& pub_key);
+    bool find(const CompressedPublicKey& pub_key, std::string& formatted_key);
+    //formatted_key must be the wellformatted string of pub_key
+    void insert(const CompressedPublicKey& pub_key, const std::string& formatted_key);
+
+    //zero capacity disables cache
+    void setCapacity(const size_t capacity);
+    //removes keys and resets counters
+    void clear();
+
+    PlaychainPublicKeyCacheStats stats() const;
+
+    static PlaychainPublicKeyCache& instance();
+
+private:
+    std::unique_ptr<PlaychainPublicKeyCacheContext> m_context;
+};
+
+} // namespace tp
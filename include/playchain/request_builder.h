@@ -4,6 +4,7 @@
 #include <playchain/playchain_settings.h>
 
 #include <string>
+#include <map>
 #include <set>
 #include <vector>
 #include <memory>
@@ -140,6 +141,10 @@ public:
                                                                  const PlaychainUserId& table_owner,
                                                                  const PlaychainTableId& table,
                                                                  const GameResult& state) const;
+    //settlement of many tables, digests of transactions are computed at once
+    std::vector<BlockchainDigestTransaction> makeVoteForGameResultTransactions(const PlaychainUserId& voter,
+                                                                               const PlaychainUserId& table_owner,
+                                                                               const std::map<PlaychainTableId, GameResult>& results) const;
 
     BlockchainDigestTransaction makeGameResetTransaction(const PlaychainUserId& table_owner,
                                                          const PlaychainTableId& table,
@@ -2,10 +2,15 @@
 
 #include <playchain/playchain_types.h>
 #include <playchain/playchain_settings.h>
+#include <playchain/parse_arena.h>
+#include <playchain/response_views.h>
+#include <playchain/message_router.h>
 
 #include <tuple>
 #include <vector>
 #include <map>
+#include <functional>
+#include <utility>
 
 namespace tp {
 
@@ -15,7 +20,7 @@ struct ParsedResponse
     ParsedResponse() = default;
     ParsedResponse(T&& data)
         : _result(true)
-        , _data(data)
+        , _data(std::move(data))
     {
     }
 
@@ -34,6 +39,8 @@ private:
     T _data;
 };
 
+//Parse methods take response as std::string, C string or BlockchainResponseView
+//of network buffer (see BlockchainResponseView::insitu to parse it in place)
 class PlaychainResponseParser
 {
 public:
@@ -50,49 +57,98 @@ public:
         m_settings = settings;
     }
 
-    static ParsedResponse<std::string> parseGetChainIdResponse(const BlockchainResponse&);
-    ParsedResponse<std::vector<PlaychainTableInfoExt>> parseGetTablesInfoResponse(const BlockchainResponse&) const;
+    //Use own arena instead of default arena of calling thread.
+    //Parser with own arena must be used from one thread at a time.
+    void setParseArena(const std::shared_ptr<PlaychainParseArena>&);
+    PlaychainParseArenaStats parseArenaStats() const;
+
+    //Decode messages already parsed by PlaychainMessageRouter (from its handlers).
+    //They return false for message of other kind or error response.
+    bool parseGetTablesInfoResponse(const PlaychainParsedMessage&, std::vector<PlaychainTableInfoExt>& result,
+                                    const PlaychainTableFieldsMask fields = PlaychainTableFields::ALL) const;
+    bool parseChangeTableInfoNotification(const PlaychainParsedMessage&, std::vector<PlaychainTableInfoExt>& result,
+                                          const PlaychainTableFieldsMask fields = PlaychainTableFields::ALL) const;
+    bool parseGetAccountIdByNameResponse(const PlaychainParsedMessage&, std::map<std::string, PlaychainUserId>& result) const;
+    bool parseListRoomsResponse(const PlaychainParsedMessage&, std::vector<PlaychainRoomInfo>& result) const;
+    bool parseListTablesResponse(const PlaychainParsedMessage&, std::vector<PlaychainTableId>& result) const;
+    ParsedResponse<bool> parseTransactionResponse(const PlaychainParsedMessage&) const;
+
+    static ParsedResponse<std::string> parseGetChainIdResponse(const BlockchainResponseView&);
+    ParsedResponse<std::vector<PlaychainTableInfoExt>> parseGetTablesInfoResponse(const BlockchainResponseView&) const;
+    //Decode into existing result reusing its items, strings and map nodes
+    //(for polling). Result is unspecified if false is returned.
+    //Only requested fields are decoded (see PlaychainTableFields).
+    bool parseGetTablesInfoResponse(const BlockchainResponseView&, std::vector<PlaychainTableInfoExt>& result,
+                                    const PlaychainTableFieldsMask fields = PlaychainTableFields::ALL) const;
     //return invalid table if table has not yet allocated
-    ParsedResponse<PlaychainTableInfo> parseCheckIfTableAllocatedForPendingBuyinResponse(const BlockchainResponse& response) const;
-    ParsedResponse<std::vector<PlaychainPlayerTableInfo>> parseListTablesWithPlayerRequest(const BlockchainResponse& response) const;
-
-    ParsedResponse<std::map<std::string, PlaychainUserId>> parseGetAccountIdByNameResponse(const BlockchainResponse&) const;
-    ParsedResponse<PlaychainBlockHeaderInfo> parseGetLastIrreversibleBlockHeaderResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::vector<PlayerInvitationInfo>> parseListPlayerInvitationsResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::vector<InvitedPlayerInfo>> parseListInvitedPlayersResponse(const BlockchainResponse&) const;
-    ParsedResponse<PlaychainUserBalanceInfo> parseGetPlaychainBalanceResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::pair<PlaychainUserId, CompressedPublicKey>> parseLoginResponse(const BlockchainResponse&) const;
-    ParsedResponse<bool> parseTransactionResponse(const BlockchainResponse&) const;
-
-    ParsedResponse<bool> parseLegacyLoginResponse(const BlockchainResponse&) const;
-    ParsedResponse<PlaychainMoney> parseLegacyGetAccountBalanceResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::map<std::string, PlaychainUserId>> parseLegacyGetAccountIdByNameResponse(const BlockchainResponse&) const;
-    ParsedResponse<PlaychainBlockHeaderInfo> parseLegacyGetLastBlockHeaderResponse(const BlockchainResponse&) const;
-    ParsedResponse<PlaychainSettings> parsePlaychainSettingFromProperties(const BlockchainResponse& blockchain,
-                                                                          const BlockchainResponse& playchain) const;
-
-    ParsedResponse<bool> parseSubscriptionResponse(const BlockchainResponse& response) const
+    ParsedResponse<PlaychainTableInfo> parseCheckIfTableAllocatedForPendingBuyinResponse(const BlockchainResponseView& response) const;
+    ParsedResponse<std::vector<PlaychainPlayerTableInfo>> parseListTablesWithPlayerRequest(const BlockchainResponseView& response) const;
+
+    ParsedResponse<std::map<std::string, PlaychainUserId>> parseGetAccountIdByNameResponse(const BlockchainResponseView&) const;
+    bool parseGetAccountIdByNameResponse(const BlockchainResponseView&, std::map<std::string, PlaychainUserId>& result) const;
+    ParsedResponse<PlaychainBlockHeaderInfo> parseGetLastIrreversibleBlockHeaderResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::vector<PlayerInvitationInfo>> parseListPlayerInvitationsResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::vector<InvitedPlayerInfo>> parseListInvitedPlayersResponse(const BlockchainResponseView&) const;
+    ParsedResponse<PlaychainUserBalanceInfo> parseGetPlaychainBalanceResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::pair<PlaychainUserId, CompressedPublicKey>> parseLoginResponse(const BlockchainResponseView&) const;
+    ParsedResponse<bool> parseTransactionResponse(const BlockchainResponseView&) const;
+
+    ParsedResponse<bool> parseLegacyLoginResponse(const BlockchainResponseView&) const;
+    ParsedResponse<PlaychainMoney> parseLegacyGetAccountBalanceResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::map<std::string, PlaychainUserId>> parseLegacyGetAccountIdByNameResponse(const BlockchainResponseView&) const;
+    ParsedResponse<PlaychainBlockHeaderInfo> parseLegacyGetLastBlockHeaderResponse(const BlockchainResponseView&) const;
+    ParsedResponse<PlaychainSettings> parsePlaychainSettingFromProperties(const BlockchainResponseView& blockchain,
+                                                                          const BlockchainResponseView& playchain) const;
+
+    ParsedResponse<bool> parseSubscriptionResponse(const BlockchainResponseView& response) const
     {
         return parseTransactionResponse(response);
     }
     ParsedResponse<std::vector<PlaychainTableInfoExt>>
-    parseChangeTableInfoNotification(const BlockchainResponse&, const int identifier) const;
-    ParsedResponse<int> parseNotificationCookie(const BlockchainResponse&) const;
-
-    ParsedResponse<PlaychainPlayerId> parseGetPlayerIdByAccountIdResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::vector<PlaychainRoomInfo>> parseListRoomsResponse(const BlockchainResponse&) const;
-    ParsedResponse<PlaychainRoomInfoExt> parseGetRoomInfoResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::vector<PlaychainTableInfo>> parseGetTablesInfoByMetadataResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::vector<PlaychainTableId>> parseListTablesResponse(const BlockchainResponse&) const;
+    parseChangeTableInfoNotification(const BlockchainResponseView&, const int identifier) const;
+    bool parseChangeTableInfoNotification(const BlockchainResponseView&, const int identifier,
+                                          std::vector<PlaychainTableInfoExt>& result,
+                                          const PlaychainTableFieldsMask fields = PlaychainTableFields::ALL) const;
+    ParsedResponse<int> parseNotificationCookie(const BlockchainResponseView&) const;
+
+    ParsedResponse<PlaychainPlayerId> parseGetPlayerIdByAccountIdResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::vector<PlaychainRoomInfo>> parseListRoomsResponse(const BlockchainResponseView&) const;
+    bool parseListRoomsResponse(const BlockchainResponseView&, std::vector<PlaychainRoomInfo>& result) const;
+    ParsedResponse<PlaychainRoomInfoExt> parseGetRoomInfoResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::vector<PlaychainTableInfo>> parseGetTablesInfoByMetadataResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::vector<PlaychainTableId>> parseListTablesResponse(const BlockchainResponseView&) const;
+    bool parseListTablesResponse(const BlockchainResponseView&, std::vector<PlaychainTableId>& result) const;
 
     PlaychainMoney getFeeFromTransaction(const BlockchainDigestTransaction&) const;
 
-    ParsedResponse<BlockchainWitness> parseGetBlockchainWitnessResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::vector<BlockchainGameWitness>> parseGetBlockchainGameWitnessesResponse(const BlockchainResponse&) const;
-    ParsedResponse<std::vector<BlockchainAccount>> parseGetBlockchainAccountsResponse(const BlockchainResponse&) const;
+    ParsedResponse<BlockchainWitness> parseGetBlockchainWitnessResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::vector<BlockchainGameWitness>> parseGetBlockchainGameWitnessesResponse(const BlockchainResponseView&) const;
+    ParsedResponse<std::vector<BlockchainAccount>> parseGetBlockchainAccountsResponse(const BlockchainResponseView&) const;
+
+    //Stream variants of list responses. They pass elements of "result" array
+    //to callback while reading without building DOM for whole response.
+    //Return number of passed elements.
+    ParsedResponse<size_t> streamGetTablesInfoResponse(const BlockchainResponseView&,
+                                                       const std::function<void(PlaychainTableInfoExt&&)>&,
+                                                       const PlaychainTableFieldsMask fields = PlaychainTableFields::ALL) const;
+    ParsedResponse<size_t> streamListTablesResponse(const BlockchainResponseView&,
+                                                    const std::function<void(PlaychainTableId&&)>&) const;
+    ParsedResponse<size_t> streamListRoomsResponse(const BlockchainResponseView&,
+                                                   const std::function<void(PlaychainRoomInfo&&)>&) const;
+    ParsedResponse<size_t> streamGetBlockchainAccountsResponse(const BlockchainResponseView&,
+                                                               const std::function<void(BlockchainAccount&&)>&) const;
+
+    //Lazy variants of list responses. Response is kept with index of object members,
+    //fields are decoded when they are accessed through views.
+    //In-situ response is parsed in its buffer, which must outlive the views.
+    ParsedResponse<PlaychainTablesView> parseGetTablesInfoView(const BlockchainResponseView&) const;
+    ParsedResponse<PlaychainRoomsView> parseListRoomsView(const BlockchainResponseView&) const;
 
 private:
+    PlaychainParseArena& arena() const;
+
     mutable PlaychainSettings m_settings;
+    std::shared_ptr<PlaychainParseArena> m_arena;
 };
 
 } // namespace tp
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <playchain/playchain_types.h>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace tp {
+struct PlaychainViewDocument;
+
+//Lazy view of table object of parsed response.
+//Fields are decoded on every access, fields that are never read cost nothing.
+//JSON types of fields are checked when response is parsed,
+//accessors throw std::logic_error if content of accessed field is invalid,
+//absent fields (in lenient mode) have default values.
+//View is valid while list view it was taken from is alive.
+class PlaychainTableView
+{
+public:
+    PlaychainTableView(const PlaychainViewDocument* document, const size_t index)
+        : m_document(document)
+        , m_index(index)
+    {
+    }
+
+    PlaychainTableId id() const;
+    PlaychainUserId owner() const;
+    std::string owner_name() const;
+    std::string metadata() const;
+    std::string server_url() const;
+    uint16_t required_witnesses() const;
+    PlaychainMoney min_accepted_proposal_asset() const;
+    PlaychainTableInfo::State state() const;
+
+    PlaychainTableInfoExt::PendingBuyinsType pending_proposals() const;
+    PlaychainTableInfoExt::CashDatasType cash() const;
+    PlaychainTableInfoExt::CashDatasType playing_cash() const;
+    PlaychainTableInfoExt::AccountsType missed_voters() const;
+
+    bool valid() const
+    {
+        return id().valid() && owner().valid();
+    }
+
+    //decode all fields
+    PlaychainTableInfo info() const;
+    PlaychainTableInfoExt infoExt() const;
+
+private:
+    const PlaychainViewDocument* m_document;
+    size_t m_index;
+};
+
+//Lazy view of room object from list_rooms response
+class PlaychainRoomView
+{
+public:
+    PlaychainRoomView(const PlaychainViewDocument* document, const size_t index)
+        : m_document(document)
+        , m_index(index)
+    {
+    }
+
+    PlaychainRoomId id() const;
+    PlaychainUserId owner() const;
+    std::string owner_name() const;
+    std::string metadata() const;
+    std::string server_url() const;
+    int32_t rating() const;
+    ProtocolVersion protocol_version() const;
+
+    bool valid() const
+    {
+        return id().valid();
+    }
+
+    PlaychainRoomInfo info() const;
+
+private:
+    const PlaychainViewDocument* m_document;
+    size_t m_index;
+};
+
+//List of lazy object views. It keeps parsed response
+//and index of object members built while parsing.
+template <typename TItemView>
+class PlaychainObjectsView
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TItemView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TItemView;
+
+        const_iterator(const PlaychainViewDocument* document, const size_t index)
+            : m_document(document)
+            , m_index(index)
+        {
+        }
+
+        TItemView operator*() const
+        {
+            return { m_document, m_index };
+        }
+        const_iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator result = *this;
+            ++m_index;
+            return result;
+        }
+        bool operator==(const const_iterator& o) const
+        {
+            return m_index == o.m_index && m_document == o.m_document;
+        }
+        bool operator!=(const const_iterator& o) const
+        {
+            return !(*this == o);
+        }
+
+    private:
+        const PlaychainViewDocument* m_document;
+        size_t m_index;
+    };
+
+    PlaychainObjectsView() = default;
+    PlaychainObjectsView(const std::shared_ptr<const PlaychainViewDocument>& document, const size_t size)
+        : m_document(document)
+        , m_size(size)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    TItemView operator[](const size_t index) const
+    {
+        return { m_document.get(), index };
+    }
+
+    const_iterator begin() const
+    {
+        return { m_document.get(), 0 };
+    }
+
+    const_iterator end() const
+    {
+        return { m_document.get(), m_size };
+    }
+
+private:
+    std::shared_ptr<const PlaychainViewDocument> m_document;
+    size_t m_size = 0;
+};
+
+using PlaychainTablesView = PlaychainObjectsView<PlaychainTableView>;
+using PlaychainRoomsView = PlaychainObjectsView<PlaychainRoomView>;
+
+} // namespace tp
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <playchain/playchain_types.h>
+#include <playchain/request_builder.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace tp {
+struct PlaychainSignatureCollectorContext;
+
+//times from expect() of transaction
+struct PlaychainSignatureLatency
+{
+    std::chrono::microseconds first_signature { 0 };
+    //the slowest signer, transaction is broadcasted then
+    std::chrono::microseconds complete { 0 };
+};
+
+struct PlaychainSignatureCollectorStats
+{
+    size_t pending = 0;
+    size_t completed = 0;
+    size_t accepted_signatures = 0;
+    //signatures of other keys or digests and not canonical ones
+    size_t invalid_signatures = 0;
+    size_t duplicate_signatures = 0;
+    //complete latency of completed transactions
+    std::chrono::microseconds total_latency { 0 };
+    std::chrono::microseconds max_latency { 0 };
+};
+
+//Collects signatures of transactions required from several signers
+//(ex. room owner and witnesses). Transactions are keyed by digest.
+//Every signature is verified when it is added, broadcast request is made
+//by the thread that adds the last required signature.
+//Collector is thread safe, signatures are verified without lock.
+class PlaychainSignatureCollector
+{
+public:
+    enum class Status : int
+    {
+        ACCEPTED = 0,
+        //the last required signature, handler is called
+        COMPLETED,
+        DUPLICATE,
+        //not a signature of expected signer
+        INVALID,
+        //transaction was not expected, is completed or canceled
+        UNKNOWN,
+    };
+
+    //called once for every completed transaction
+    using Handler = std::function<void(const BlockchainRequest& broadcast, const std::string& digest, const PlaychainSignatureLatency&)>;
+
+    PlaychainSignatureCollector(const PlaychainRequestBuilder& builder, const Handler& on_complete);
+    ~PlaychainSignatureCollector();
+
+    //returns false if transaction with the same digest is collected already
+    bool expect(const BlockchainDigestTransaction& trx, const std::set<CompressedPublicKey>& signers);
+    bool cancel(const std::string& digest);
+
+    //hex of compact signature (PlaychainUser::signDigest)
+    Status addSignature(const std::string& digest, const std::string& signature);
+
+    PlaychainSignatureCollectorStats stats() const;
+
+private:
+    std::unique_ptr<PlaychainSignatureCollectorContext> m_context;
+};
+
+} // namespace tp
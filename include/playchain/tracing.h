@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace tp {
+
+//Stage of transaction or response pipeline
+struct PlaychainSpan
+{
+    enum class Kind : int
+    {
+        //make*Transaction from operations to request with digest
+        TRANSACTION = 0,
+        //packing of operations to binary body and JSON request (made together),
+        //body of single transaction is digested while it is packed
+        TRANSACTION_PACK,
+        //digest of binary bodies of transaction batch
+        TRANSACTION_HASH,
+        SIGN,
+        BROADCAST,
+        PARSE,
+    };
+
+    Kind kind = Kind::TRANSACTION;
+    //function name
+    const char* name = nullptr;
+
+    //unique in process, parent is enclosing span of the same thread (0 for none)
+    uint64_t id = 0;
+    uint64_t parent_id = 0;
+
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point finish;
+
+    //hex digest of transaction or signed digest, empty for other stages
+    std::string digest;
+    //bytes produced (JSON) or consumed (response, digests)
+    size_t bytes = 0;
+    //error reported by the stage
+    bool failed = false;
+};
+
+//Subscriber of spans. Spans are collected only while handler is set,
+//otherwise stage costs one relaxed load of flag.
+//Handler is called in thread of finished span and should be fast and thread safe.
+//
+//Library built with PLAYCHAIN_USDT has static probes of provider "playchain":
+//span_start(kind, name), span_end(kind, name, bytes, failed)
+//and transaction_digest(digest) that are nops until tracer attaches them.
+class PlaychainTracing
+{
+public:
+    using Handler = std::function<void(const PlaychainSpan&)>;
+
+    //empty handler detaches subscriber
+    static void setHandler(const Handler& handler);
+    static bool attached();
+};
+
+} // namespace tp
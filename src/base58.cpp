@@ -1,9 +1,3 @@
-// Copyright (c) 2009-2010 Satoshi Nakamoto
-// Copyright (c) 2009-2012 The Bitcoin Developers
-// Distributed under the MIT/X11 software license, see the accompanying
-// file COPYING or http://www.opensource.org/licenses/mit-license.php.
-
-
 //
 // Why base-58 instead of standard base-64 encoding?
 // - Don't want 0OIl characters that look the same in some fonts and
@@ -12,684 +6,425 @@
 // - E-mail usually won't line-break if there's no punctuation to break at.
 // - Doubleclicking selects the whole number as one word if it's all alphanumeric.
 //
-#ifndef BITCOIN_BASE58_H
-#define BITCOIN_BASE58_H
+#include "base58.h"
 
 #include "playchain_defines.h"
 
-#include <string>
-#include <vector>
-#include <limits>
-#include <algorithm>
-#include <string.h>
-
-#include <stdexcept>
-#include <vector>
-#include <openssl/bn.h>
+#include <cctype>
+#include <cstring>
 
-/** Errors thrown by the bignum class */
-class bignum_error : public std::runtime_error
-{
-public:
-    explicit bignum_error(const std::string& str)
-        : std::runtime_error(str)
-    {
-    }
-};
+namespace playchain {
 
+namespace {
+    const char base58_digits[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
-/** RAII encapsulated BN_CTX (OpenSSL bignum context) */
-class CAutoBN_CTX
-{
-protected:
-    BN_CTX* pctx;
-    BN_CTX* operator=(BN_CTX* pnew) { return pctx = pnew; }
+    //encoder keeps number in base 58^5 limbs (fits 29 bits),
+    //decoder in base 2^32 limbs (5 characters are less than 30 bits)
+    constexpr uint32_t limb_base = 58u * 58u * 58u * 58u * 58u;
+    constexpr size_t limb_digits = 5;
 
-public:
-    CAutoBN_CTX()
+    constexpr size_t encoder_limbs(const size_t size)
     {
-        pctx = BN_CTX_new();
-        if (pctx == NULL)
-            throw bignum_error("CAutoBN_CTX : BN_CTX_new() returned NULL");
+        return (size * 8 + 28) / 29;
     }
 
-    ~CAutoBN_CTX()
+    constexpr size_t decoder_limbs(const size_t size)
     {
-        if (pctx != NULL)
-            BN_CTX_free(pctx);
+        return (size * 6 + 31) / 32;
     }
 
-    operator BN_CTX*() { return pctx; }
-    BN_CTX& operator*() { return *pctx; }
-    BN_CTX** operator&() { return &pctx; }
-    bool operator!() { return (pctx == NULL); }
-};
-
+    constexpr size_t encoder_stack_limbs = encoder_limbs(base58_stack_bytes);
+    constexpr size_t decoder_stack_limbs = decoder_limbs(base58_max_chars(base58_stack_bytes));
 
-/** C++ wrapper for BIGNUM (OpenSSL bignum) */
-class CBigNum : public BIGNUM
-{
-public:
-    CBigNum()
+    struct base58_tables
     {
-        BN_init(this);
-    }
-
-    CBigNum(const CBigNum& b)
-    {
-        BN_init(this);
-        if (!BN_copy(this, &b))
+        base58_tables()
         {
-            BN_clear_free(this);
-            throw bignum_error("CBigNum::CBigNum(const CBigNum&) : BN_copy failed");
+            memset(values, invalid, sizeof(values));
+            for (uint8_t ci = 0; ci < 58; ++ci)
+                values[(uint8_t)base58_digits[ci]] = ci;
         }
-    }
 
-    CBigNum& operator=(const CBigNum& b)
-    {
-        if (!BN_copy(this, &b))
-            throw bignum_error("CBigNum::operator= : BN_copy failed");
-        return (*this);
-    }
+        static constexpr uint8_t invalid = 0xff;
 
-    ~CBigNum()
-    {
-        BN_clear_free(this);
-    }
+        uint8_t values[256];
+    };
 
-    //CBigNum(char n) is not portable.  Use 'signed char' or 'unsigned char'.
-    CBigNum(signed char n)
-    {
-        BN_init(this);
-        if (n >= 0)
-            setulong(n);
-        else
-            setint64(n);
-    }
-    CBigNum(short n)
+    const base58_tables& tables()
     {
-        BN_init(this);
-        if (n >= 0)
-            setulong(n);
-        else
-            setint64(n);
-    }
-    CBigNum(int n)
-    {
-        BN_init(this);
-        if (n >= 0)
-            setulong(n);
-        else
-            setint64(n);
-    }
-    //CBigNum(long n)             { BN_init(this); if (n >= 0) setulong(n); else setint64(n); }
-    CBigNum(int64_t n)
-    {
-        BN_init(this);
-        setint64(n);
-    }
-    CBigNum(unsigned char n)
-    {
-        BN_init(this);
-        setulong(n);
-    }
-    CBigNum(unsigned short n)
-    {
-        BN_init(this);
-        setulong(n);
-    }
-    CBigNum(unsigned int n)
-    {
-        BN_init(this);
-        setulong(n);
-    }
-    //CBigNum(unsigned long n)    { BN_init(this); setulong(n); }
-    CBigNum(uint64_t n)
-    {
-        BN_init(this);
-        setuint64(n);
+        static const base58_tables instance;
+        return instance;
     }
 
-    explicit CBigNum(const std::vector<unsigned char>& vch)
+    //1 if value == 0 else 0, without branches
+    uint32_t is_zero(const uint32_t value)
     {
-        BN_init(this);
-        setvch(vch);
+        return ((value | (0u - value)) >> 31) ^ 1;
     }
 
-    void setulong(unsigned long n)
+    //1 if lo <= value <= hi else 0 (for values < 2^31), without branches
+    uint32_t in_range(const uint32_t value, const uint32_t lo, const uint32_t hi)
     {
-        if (!BN_set_word(this, n))
-            throw bignum_error("CBigNum conversion from unsigned long : BN_set_word failed");
+        return (((value - lo) | (hi - value)) >> 31) ^ 1;
     }
 
-    unsigned long getulong() const
+    //alphabet without table lookup: '1' + digit with gaps after '9', 'H', 'N', 'Z', 'k'
+    char digit_ct(const uint32_t digit)
     {
-        return BN_get_word(this);
+        uint32_t c = '1' + digit;
+        c += 7 & (0u - ((8 - digit) >> 31));
+        c += 1 & (0u - ((16 - digit) >> 31));
+        c += 1 & (0u - ((21 - digit) >> 31));
+        c += 6 & (0u - ((32 - digit) >> 31));
+        c += 1 & (0u - ((43 - digit) >> 31));
+        return (char)c;
     }
 
-    unsigned int getuint() const
+    //digit value without table lookup, sets invalid to 1 for other characters
+    uint32_t value_ct(const uint8_t c, uint32_t& invalid)
     {
-        return BN_get_word(this);
-    }
+        uint32_t value = 0;
+        uint32_t valid = 0;
+        uint32_t in = 0;
 
-    int getint() const
-    {
-        unsigned long n = BN_get_word(this);
-        if (!BN_is_negative(this))
-            return (n > (unsigned long)std::numeric_limits<int>::max() ? std::numeric_limits<int>::max() : n);
-        else
-            return (n > (unsigned long)std::numeric_limits<int>::max() ? std::numeric_limits<int>::min() : -(int)n);
+        in = in_range(c, '1', '9');
+        value |= (0u - in) & (c - '1');
+        valid |= in;
+        in = in_range(c, 'A', 'H');
+        value |= (0u - in) & (c - 'A' + 9);
+        valid |= in;
+        in = in_range(c, 'J', 'N');
+        value |= (0u - in) & (c - 'J' + 17);
+        valid |= in;
+        in = in_range(c, 'P', 'Z');
+        value |= (0u - in) & (c - 'P' + 22);
+        valid |= in;
+        in = in_range(c, 'a', 'k');
+        value |= (0u - in) & (c - 'a' + 33);
+        valid |= in;
+        in = in_range(c, 'm', 'z');
+        value |= (0u - in) & (c - 'm' + 44);
+        valid |= in;
+
+        invalid |= valid ^ 1;
+        return value;
     }
 
-    void setint64(int64_t n)
+    //limbs must be zero filled, constant time version updates all of them
+    template <bool constant_time>
+    size_t encode_to_limbs(const uint8_t* data, const size_t size, uint32_t* limbs, const size_t limbs_count)
     {
-        unsigned char pch[sizeof(n) + 6];
-        unsigned char* p = pch + 4;
-        bool fNegative = false;
-        if (n < (int64_t)0)
+        size_t used = 0;
+        //high bytes of number first, so every step is number * 256^chunk + word
+        size_t chunk = size % 4 ? size % 4 : 4;
+        for (size_t ci = 0; ci < size; ci += chunk, chunk = 4)
         {
-            n = -n;
-            fNegative = true;
-        }
-        bool fLeadingZeroes = true;
-        for (int i = 0; i < 8; i++)
-        {
-            unsigned char c = (n >> 56) & 0xff;
-            n <<= 8;
-            if (fLeadingZeroes)
+            uint32_t word = 0;
+            for (size_t cj = 0; cj < chunk; ++cj)
+                word = (word << 8) | data[ci + cj];
+
+            const uint64_t multiplier = (uint64_t)1 << (chunk * 8);
+            uint64_t carry = word;
+            const size_t count = constant_time ? limbs_count : used;
+            for (size_t cj = 0; cj < count; ++cj)
             {
-                if (c == 0)
-                    continue;
-                if (c & 0x80)
-                    *p++ = (fNegative ? 0x80 : 0);
-                else if (fNegative)
-                    c |= 0x80;
-                fLeadingZeroes = false;
+                carry += (uint64_t)limbs[cj] * multiplier;
+                limbs[cj] = (uint32_t)(carry % limb_base);
+                carry /= limb_base;
+            }
+            if (!constant_time)
+            {
+                while (carry)
+                {
+                    limbs[used++] = (uint32_t)(carry % limb_base);
+                    carry /= limb_base;
+                }
             }
-            *p++ = c;
         }
-        unsigned int nSize = p - (pch + 4);
-        pch[0] = (nSize >> 24) & 0xff;
-        pch[1] = (nSize >> 16) & 0xff;
-        pch[2] = (nSize >> 8) & 0xff;
-        pch[3] = (nSize)&0xff;
-        BN_mpi2bn(pch, p - pch, this);
+        return constant_time ? limbs_count : used;
     }
 
-    void setuint64(uint64_t n)
+    template <bool constant_time>
+    size_t encode(const uint8_t* data, const size_t size, char* out, uint32_t* limbs, const size_t limbs_count, char* digits)
     {
-        unsigned char pch[sizeof(n) + 6];
-        unsigned char* p = pch + 4;
-        bool fLeadingZeroes = true;
-        for (int i = 0; i < 8; i++)
+        const size_t used = encode_to_limbs<constant_time>(data, size, limbs, limbs_count);
+
+        //digit values, most significant first
+        size_t digits_count = 0;
+        for (size_t ci = used; ci-- > 0;)
         {
-            unsigned char c = (n >> 56) & 0xff;
-            n <<= 8;
-            if (fLeadingZeroes)
+            uint32_t limb = limbs[ci];
+            for (size_t cj = limb_digits; cj-- > 0;)
             {
-                if (c == 0)
-                    continue;
-                if (c & 0x80)
-                    *p++ = 0;
-                fLeadingZeroes = false;
+                digits[digits_count + cj] = (char)(limb % 58);
+                limb /= 58;
             }
-            *p++ = c;
+            digits_count += limb_digits;
         }
-        unsigned int nSize = p - (pch + 4);
-        pch[0] = (nSize >> 24) & 0xff;
-        pch[1] = (nSize >> 16) & 0xff;
-        pch[2] = (nSize >> 8) & 0xff;
-        pch[3] = (nSize)&0xff;
-        BN_mpi2bn(pch, p - pch, this);
-    }
 
+        size_t zeros = 0;
+        size_t skip = 0;
+        if (constant_time)
+        {
+            uint32_t seen = 0;
+            for (size_t ci = 0; ci < size; ++ci)
+            {
+                seen |= data[ci];
+                zeros += is_zero(seen);
+            }
+            seen = 0;
+            for (size_t ci = 0; ci < digits_count; ++ci)
+            {
+                seen |= (uint8_t)digits[ci];
+                skip += is_zero(seen);
+            }
+        }
+        else
+        {
+            while (zeros < size && data[zeros] == 0)
+                ++zeros;
+            while (skip < digits_count && digits[skip] == 0)
+                ++skip;
+        }
 
-    void setvch(const std::vector<unsigned char>& vch)
-    {
-        std::vector<unsigned char> vch2(vch.size() + 4);
-        unsigned int nSize = vch.size();
-        // BIGNUM's byte stream format expects 4 bytes of
-        // big endian size data info at the front
-        vch2[0] = (nSize >> 24) & 0xff;
-        vch2[1] = (nSize >> 16) & 0xff;
-        vch2[2] = (nSize >> 8) & 0xff;
-        vch2[3] = (nSize >> 0) & 0xff;
-        // swap data to big endian
-        reverse_copy(vch.begin(), vch.end(), vch2.begin() + 4);
-        BN_mpi2bn(&vch2[0], vch2.size(), this);
-    }
-
-    std::vector<unsigned char> getvch() const
-    {
-        unsigned int nSize = BN_bn2mpi(this, NULL);
-        if (nSize <= 4)
-            return std::vector<unsigned char>();
-        std::vector<unsigned char> vch(nSize);
-        BN_bn2mpi(this, &vch[0]);
-        vch.erase(vch.begin(), vch.begin() + 4);
-        reverse(vch.begin(), vch.end());
-        return vch;
-    }
+        memset(out, base58_digits[0], zeros);
+        char* pos = out + zeros;
+        for (size_t ci = skip; ci < digits_count; ++ci)
+            *pos++ = constant_time ? digit_ct((uint8_t)digits[ci]) : base58_digits[(uint8_t)digits[ci]];
 
-    CBigNum& SetCompact(unsigned int nCompact)
-    {
-        unsigned int nSize = nCompact >> 24;
-        std::vector<unsigned char> vch(4 + nSize);
-        vch[3] = nSize;
-        if (nSize >= 1)
-            vch[4] = (nCompact >> 16) & 0xff;
-        if (nSize >= 2)
-            vch[5] = (nCompact >> 8) & 0xff;
-        if (nSize >= 3)
-            vch[6] = (nCompact >> 0) & 0xff;
-        BN_mpi2bn(&vch[0], vch.size(), this);
-        return *this;
+        return (size_t)(pos - out);
     }
 
-    unsigned int GetCompact() const
+    template <bool constant_time>
+    bool decode(const char* str, const size_t size, uint8_t* out, const size_t out_len, size_t& decoded, uint32_t* limbs, const size_t limbs_count, uint8_t* bytes)
     {
-        unsigned int nSize = BN_bn2mpi(this, NULL);
-        std::vector<unsigned char> vch(nSize);
-        nSize -= 4;
-        BN_bn2mpi(this, &vch[0]);
-        unsigned int nCompact = nSize << 24;
-        if (nSize >= 1)
-            nCompact |= (vch[4] << 16);
-        if (nSize >= 2)
-            nCompact |= (vch[5] << 8);
-        if (nSize >= 3)
-            nCompact |= (vch[6] << 0);
-        return nCompact;
-    }
+        const uint8_t* values = tables().values;
 
-    void SetHex(const std::string& str)
-    {
-        // skip 0x
-        const char* psz = str.c_str();
-        while (isspace(*psz))
-            psz++;
-        bool fNegative = false;
-        if (*psz == '-')
+        uint32_t invalid = 0;
+        size_t used = 0;
+        size_t chunk = size % limb_digits ? size % limb_digits : limb_digits;
+        for (size_t ci = 0; ci < size; ci += chunk, chunk = limb_digits)
         {
-            fNegative = true;
-            psz++;
+            uint32_t word = 0;
+            uint32_t multiplier = 1;
+            for (size_t cj = 0; cj < chunk; ++cj)
+            {
+                const uint8_t c = (uint8_t)str[ci + cj];
+                uint32_t value = 0;
+                if (constant_time)
+                {
+                    value = value_ct(c, invalid);
+                }
+                else
+                {
+                    value = values[c];
+                    if (value == base58_tables::invalid)
+                        return false;
+                }
+                word = word * 58 + value;
+                multiplier *= 58;
+            }
+
+            uint64_t carry = word;
+            const size_t count = constant_time ? limbs_count : used;
+            for (size_t cj = 0; cj < count; ++cj)
+            {
+                carry += (uint64_t)limbs[cj] * multiplier;
+                limbs[cj] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            if (!constant_time)
+            {
+                while (carry)
+                {
+                    limbs[used++] = (uint32_t)carry;
+                    carry >>= 32;
+                }
+            }
         }
-        if (psz[0] == '0' && tolower(psz[1]) == 'x')
-            psz += 2;
-        while (isspace(*psz))
-            psz++;
-
-        // hex string to bignum
-        static signed char phexdigit[256] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0, 0, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-        *this = 0;
-        while (isxdigit(*psz))
+        if (invalid)
+            return false;
+
+        if (constant_time)
+            used = limbs_count;
+
+        //big endian bytes of number
+        const size_t bytes_count = used * 4;
+        for (size_t ci = 0; ci < used; ++ci)
         {
-            *this <<= 4;
-            int n = phexdigit[(unsigned char)*psz++];
-            *this += n;
+            const uint32_t limb = limbs[used - 1 - ci];
+            bytes[ci * 4] = (uint8_t)(limb >> 24);
+            bytes[ci * 4 + 1] = (uint8_t)(limb >> 16);
+            bytes[ci * 4 + 2] = (uint8_t)(limb >> 8);
+            bytes[ci * 4 + 3] = (uint8_t)limb;
         }
-        if (fNegative)
-            *this = 0 - *this;
-    }
 
-    std::string ToString(int nBase = 10) const
-    {
-        CAutoBN_CTX pctx;
-        CBigNum bnBase = nBase;
-        CBigNum bn0 = 0;
-        std::string str;
-        CBigNum bn = *this;
-        BN_set_negative(&bn, false);
-        CBigNum dv;
-        CBigNum rem;
-        if (BN_cmp(&bn, &bn0) == 0)
-            return "0";
-        while (BN_cmp(&bn, &bn0) > 0)
+        size_t ones = 0;
+        size_t skip = 0;
+        if (constant_time)
         {
-            if (!BN_div(&dv, &rem, &bn, &bnBase, pctx))
-                throw bignum_error("CBigNum::ToString() : BN_div failed");
-            bn = dv;
-            unsigned int c = rem.getulong();
-            str += "0123456789abcdef"[c];
+            uint32_t seen = 0;
+            for (size_t ci = 0; ci < size; ++ci)
+            {
+                seen |= (uint8_t)str[ci] ^ (uint8_t)base58_digits[0];
+                ones += is_zero(seen);
+            }
+            seen = 0;
+            for (size_t ci = 0; ci < bytes_count; ++ci)
+            {
+                seen |= bytes[ci];
+                skip += is_zero(seen);
+            }
+        }
+        else
+        {
+            while (ones < size && str[ones] == base58_digits[0])
+                ++ones;
+            while (skip < bytes_count && bytes[skip] == 0)
+                ++skip;
         }
-        if (BN_is_negative(this))
-            str += "-";
-        reverse(str.begin(), str.end());
-        return str;
-    }
-
-    std::string GetHex() const
-    {
-        return ToString(16);
-    }
-
-
-    bool operator!() const
-    {
-        return BN_is_zero(this);
-    }
-
-    CBigNum& operator+=(const CBigNum& b)
-    {
-        if (!BN_add(this, this, &b))
-            throw bignum_error("CBigNum::operator+= : BN_add failed");
-        return *this;
-    }
 
-    CBigNum& operator-=(const CBigNum& b)
-    {
-        *this = *this - b;
-        return *this;
-    }
+        decoded = ones + bytes_count - skip;
+        if (decoded > out_len)
+            return false;
 
-    CBigNum& operator*=(const CBigNum& b)
-    {
-        CAutoBN_CTX pctx;
-        if (!BN_mul(this, this, &b, pctx))
-            throw bignum_error("CBigNum::operator*= : BN_mul failed");
-        return *this;
+        if (ones)
+            memset(out, 0, ones);
+        if (bytes_count > skip)
+            memcpy(out + ones, bytes + skip, bytes_count - skip);
+        return true;
     }
 
-    CBigNum& operator/=(const CBigNum& b)
+    template <bool constant_time>
+    size_t encode(const uint8_t* data, const size_t size, char* out)
     {
-        *this = *this / b;
-        return *this;
-    }
-
-    CBigNum& operator%=(const CBigNum& b)
-    {
-        *this = *this % b;
-        return *this;
-    }
+        const size_t limbs_count = encoder_limbs(size);
+        if (limbs_count <= encoder_stack_limbs)
+        {
+            uint32_t limbs[encoder_stack_limbs] = {};
+            char digits[encoder_stack_limbs * limb_digits];
+            return encode<constant_time>(data, size, out, limbs, limbs_count, digits);
+        }
 
-    CBigNum& operator<<=(unsigned int shift)
-    {
-        if (!BN_lshift(this, this, shift))
-            throw bignum_error("CBigNum:operator<<= : BN_lshift failed");
-        return *this;
+        std::vector<uint32_t> limbs(limbs_count, 0);
+        std::vector<char> digits(limbs_count * limb_digits);
+        return encode<constant_time>(data, size, out, limbs.data(), limbs_count, digits.data());
     }
 
-    CBigNum& operator>>=(unsigned int shift)
+    template <bool constant_time>
+    bool decode(const char* str, const size_t size, uint8_t* out, const size_t out_len, size_t& decoded)
     {
-        // Note: BN_rshift segfaults on 64-bit if 2^shift is greater than the number
-        //   if built on ubuntu 9.04 or 9.10, probably depends on version of openssl
-        CBigNum a = 1;
-        a <<= shift;
-        if (BN_cmp(&a, this) > 0)
+        const size_t limbs_count = decoder_limbs(size);
+        if (limbs_count <= decoder_stack_limbs)
         {
-            *this = 0;
-            return *this;
+            uint32_t limbs[decoder_stack_limbs] = {};
+            uint8_t bytes[decoder_stack_limbs * 4];
+            return decode<constant_time>(str, size, out, out_len, decoded, limbs, limbs_count, bytes);
         }
 
-        if (!BN_rshift(this, this, shift))
-            throw bignum_error("CBigNum:operator>>= : BN_rshift failed");
-        return *this;
+        std::vector<uint32_t> limbs(limbs_count, 0);
+        std::vector<uint8_t> bytes(limbs_count * 4);
+        return decode<constant_time>(str, size, out, out_len, decoded, limbs.data(), limbs_count, bytes.data());
     }
 
-
-    CBigNum& operator++()
+    //without leading and trailing spaces
+    void trim(const std::string& str, const char*& begin, size_t& size)
     {
-        // prefix operator
-        if (!BN_add(this, this, BN_value_one()))
-            throw bignum_error("CBigNum::operator++ : BN_add failed");
-        return *this;
+        size_t from = 0;
+        size_t to = str.size();
+        while (from < to && isspace((unsigned char)str[from]))
+            ++from;
+        while (to > from && isspace((unsigned char)str[to - 1]))
+            --to;
+        begin = str.data() + from;
+        size = to - from;
     }
 
-    const CBigNum operator++(int)
+    template <bool constant_time>
+    std::string encode_string(const char* d, size_t s)
     {
-        // postfix operator
-        const CBigNum ret = *this;
-        ++(*this);
-        return ret;
+        std::string result(base58_max_chars(s), '\0');
+        result.resize(encode<constant_time>((const uint8_t*)d, s, &result[0]));
+        return result;
     }
 
-    CBigNum& operator--()
+    template <bool constant_time>
+    std::vector<char> decode_string(const std::string& base58_str)
     {
-        // prefix operator
-        CBigNum r;
-        if (!BN_sub(&r, this, BN_value_one()))
-            throw bignum_error("CBigNum::operator-- : BN_sub failed");
-        *this = r;
-        return *this;
-    }
+        const char* begin = nullptr;
+        size_t size = 0;
+        trim(base58_str, begin, size);
 
-    const CBigNum operator--(int)
-    {
-        // postfix operator
-        const CBigNum ret = *this;
-        --(*this);
-        return ret;
+        std::vector<char> result(base58_max_bytes(size));
+        size_t decoded = 0;
+        if (!decode<constant_time>(begin, size, (uint8_t*)result.data(), result.size(), decoded))
+        {
+            PLAYCHAIN_ERROR("Unable to decode base58 string");
+        }
+        result.resize(decoded);
+        return result;
     }
+} // namespace
 
-
-    friend inline const CBigNum operator-(const CBigNum& a, const CBigNum& b);
-    friend inline const CBigNum operator/(const CBigNum& a, const CBigNum& b);
-    friend inline const CBigNum operator%(const CBigNum& a, const CBigNum& b);
-};
-
-
-inline const CBigNum operator+(const CBigNum& a, const CBigNum& b)
-{
-    CBigNum r;
-    if (!BN_add(&r, &a, &b))
-        throw bignum_error("CBigNum::operator+ : BN_add failed");
-    return r;
-}
-
-inline const CBigNum operator-(const CBigNum& a, const CBigNum& b)
-{
-    CBigNum r;
-    if (!BN_sub(&r, &a, &b))
-        throw bignum_error("CBigNum::operator- : BN_sub failed");
-    return r;
-}
-
-inline const CBigNum operator-(const CBigNum& a)
+size_t encode_base58(const uint8_t* data, const size_t size, char* out)
 {
-    CBigNum r(a);
-    BN_set_negative(&r, !BN_is_negative(&r));
-    return r;
+    return encode<false>(data, size, out);
 }
 
-inline const CBigNum operator*(const CBigNum& a, const CBigNum& b)
+size_t encode_base58_ct(const uint8_t* data, const size_t size, char* out)
 {
-    CAutoBN_CTX pctx;
-    CBigNum r;
-    if (!BN_mul(&r, &a, &b, pctx))
-        throw bignum_error("CBigNum::operator* : BN_mul failed");
-    return r;
+    return encode<true>(data, size, out);
 }
 
-inline const CBigNum operator/(const CBigNum& a, const CBigNum& b)
+bool decode_base58(const char* str, const size_t size, uint8_t* out, const size_t out_len, size_t& decoded)
 {
-    CAutoBN_CTX pctx;
-    CBigNum r;
-    if (!BN_div(&r, NULL, &a, &b, pctx))
-        throw bignum_error("CBigNum::operator/ : BN_div failed");
-    return r;
+    return decode<false>(str, size, out, out_len, decoded);
 }
 
-inline const CBigNum operator%(const CBigNum& a, const CBigNum& b)
+bool decode_base58_ct(const char* str, const size_t size, uint8_t* out, const size_t out_len, size_t& decoded)
 {
-    CAutoBN_CTX pctx;
-    CBigNum r;
-    if (!BN_mod(&r, &a, &b, pctx))
-        throw bignum_error("CBigNum::operator% : BN_div failed");
-    return r;
+    return decode<true>(str, size, out, out_len, decoded);
 }
 
-inline const CBigNum operator<<(const CBigNum& a, unsigned int shift)
+std::string to_base58(const char* d, size_t s)
 {
-    CBigNum r;
-    if (!BN_lshift(&r, &a, shift))
-        throw bignum_error("CBigNum:operator<< : BN_lshift failed");
-    return r;
+    return encode_string<false>(d, s);
 }
 
-inline const CBigNum operator>>(const CBigNum& a, unsigned int shift)
+std::string to_base58(const std::vector<char>& d)
 {
-    CBigNum r = a;
-    r >>= shift;
-    return r;
+    return encode_string<false>(d.data(), d.size());
 }
 
-inline bool operator==(const CBigNum& a, const CBigNum& b) { return (BN_cmp(&a, &b) == 0); }
-inline bool operator!=(const CBigNum& a, const CBigNum& b) { return (BN_cmp(&a, &b) != 0); }
-inline bool operator<=(const CBigNum& a, const CBigNum& b) { return (BN_cmp(&a, &b) <= 0); }
-inline bool operator>=(const CBigNum& a, const CBigNum& b) { return (BN_cmp(&a, &b) >= 0); }
-inline bool operator<(const CBigNum& a, const CBigNum& b) { return (BN_cmp(&a, &b) < 0); }
-inline bool operator>(const CBigNum& a, const CBigNum& b) { return (BN_cmp(&a, &b) > 0); }
-
-
-static const char* pszBase58 = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
-
-// Encode a byte sequence as a base58-encoded string
-inline std::string EncodeBase58(const unsigned char* pbegin, const unsigned char* pend)
+std::vector<char> from_base58(const std::string& base58_str)
 {
-    CAutoBN_CTX pctx;
-    CBigNum bn58 = 58;
-    CBigNum bn0 = 0;
-
-    // Convert big endian data to little endian
-    // Extra zero at the end make sure bignum will interpret as a positive number
-    std::vector<unsigned char> vchTmp(pend - pbegin + 1, 0);
-    reverse_copy(pbegin, pend, vchTmp.begin());
-
-    // Convert little endian data to bignum
-    CBigNum bn;
-    bn.setvch(vchTmp);
-
-    // Convert bignum to std::string
-    std::string str;
-    // Expected size increase from base58 conversion is approximately 137%
-    // use 138% to be safe
-    str.reserve((pend - pbegin) * 138 / 100 + 1);
-    CBigNum dv;
-    CBigNum rem;
-    while (bn > bn0)
-    {
-        if (!BN_div(&dv, &rem, &bn, &bn58, pctx))
-            throw bignum_error("EncodeBase58 : BN_div failed");
-        bn = dv;
-        unsigned int c = rem.getulong();
-        str += pszBase58[c];
-    }
-
-    // Leading zeroes encoded as base58 zeros
-    for (const unsigned char* p = pbegin; p < pend && *p == 0; p++)
-        str += pszBase58[0];
-
-    // Convert little endian std::string to big endian
-    reverse(str.begin(), str.end());
-    //    slog( "Encode '%s'", str.c_str() );
-    return str;
+    return decode_string<false>(base58_str);
 }
 
-// Encode a byte vector as a base58-encoded string
-inline std::string EncodeBase58(const std::vector<unsigned char>& vch)
+/**
+ *  @return the number of bytes decoded
+ */
+size_t from_base58(const std::string& base58_str, char* out_data, size_t out_data_len)
 {
-    return EncodeBase58(&vch[0], &vch[0] + vch.size());
-}
+    const char* begin = nullptr;
+    size_t size = 0;
+    trim(base58_str, begin, size);
 
-// Decode a base58-encoded string psz into byte vector vchRet
-// returns true if decoding is succesful
-inline bool DecodeBase58(const char* psz, std::vector<unsigned char>& vchRet)
-{
-    CAutoBN_CTX pctx;
-    vchRet.clear();
-    CBigNum bn58 = 58;
-    CBigNum bn = 0;
-    CBigNum bnChar;
-    while (isspace(*psz))
-        psz++;
-
-    // Convert big endian string to bignum
-    for (const char* p = psz; *p; p++)
+    size_t decoded = 0;
+    if (!decode<false>(begin, size, (uint8_t*)out_data, out_data_len, decoded))
     {
-        const char* p1 = strchr(pszBase58, *p);
-        if (p1 == NULL)
-        {
-            while (isspace(*p))
-                p++;
-            if (*p != '\0')
-            {
-                //slog( "%s  '%c'", pszBase58,*p );
-                return false;
-            }
-            break;
-        }
-        bnChar.setulong(p1 - pszBase58);
-        if (!BN_mul(&bn, &bn, &bn58, pctx))
-            throw bignum_error("DecodeBase58 : BN_mul failed");
-        bn += bnChar;
+        PLAYCHAIN_ERROR("Unable to decode base58 string");
     }
-
-    // Get bignum as little endian data
-    std::vector<unsigned char> vchTmp = bn.getvch();
-
-    // Trim off sign byte if present
-    if (vchTmp.size() >= 2 && vchTmp.end()[-1] == 0 && vchTmp.end()[-2] >= 0x80)
-        vchTmp.erase(vchTmp.end() - 1);
-
-    // Restore leading zeros
-    int nLeadingZeros = 0;
-    for (const char* p = psz; *p == pszBase58[0]; p++)
-        nLeadingZeros++;
-    vchRet.assign(nLeadingZeros + vchTmp.size(), 0);
-
-    // Convert little endian data to big endian
-    reverse_copy(vchTmp.begin(), vchTmp.end(), vchRet.end() - vchTmp.size());
-    return true;
+    return decoded;
 }
 
-// Decode a base58-encoded string str into byte vector vchRet
-// returns true if decoding is succesful
-inline bool DecodeBase58(const std::string& str, std::vector<unsigned char>& vchRet)
+std::string to_base58_ct(const char* d, size_t s)
 {
-    return DecodeBase58(str.c_str(), vchRet);
+    return encode_string<true>(d, s);
 }
 
-
-namespace playchain {
-
-std::string to_base58(const char* d, size_t s)
+std::vector<char> from_base58_ct(const std::string& base58_str)
 {
-    return EncodeBase58((const unsigned char*)d, (const unsigned char*)d + s).c_str();
-}
-
-std::string to_base58(const std::vector<char>& d)
-{
-    if (d.size())
-        return to_base58(d.data(), d.size());
-    return std::string();
-}
-std::vector<char> from_base58(const std::string& base58_str)
-{
-    std::vector<unsigned char> out;
-    if (!DecodeBase58(base58_str.c_str(), out))
-    {
-        PLAYCHAIN_ERROR("Unable to decode base58 string");
-    }
-    return std::vector<char>((const char*)out.data(), ((const char*)out.data()) + out.size());
-}
-/**
- *  @return the number of bytes decoded
- */
-size_t from_base58(const std::string& base58_str, char* out_data, size_t out_data_len)
-{
-    //slog( "%s", base58_str.c_str() );
-    std::vector<unsigned char> out;
-    if (!DecodeBase58(base58_str.c_str(), out))
-    {
-        PLAYCHAIN_ERROR("Unable to decode base58 string");
-    }
-    PLAYCHAIN_ASSERT(out.size() <= out_data_len);
-    if (!out.empty())
-    {
-        memcpy(out_data, out.data(), out.size());
-    }
-    return out.size();
+    return decode_string<true>(base58_str);
 }
 } // namespace playchain
-
-#endif
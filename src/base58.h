@@ -1,10 +1,53 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+/* Base58 (Bitcoin alphabet) without big number library.
+ *
+ * Numbers are kept in fixed-width limbs on stack for payloads up to
+ * base58_stack_bytes (keys, WIF, addresses are 25-37 bytes), longer
+ * payloads use heap buffer.
+ * Leading zero bytes are encoded as '1' characters.
+ *
+ * *_ct functions don't branch and don't index tables by payload value
+ * (for private keys). Number of leading zero bytes and output size
+ * are still visible, they are the part of encoded string.
+*/
+
 namespace playchain {
+
+constexpr size_t base58_stack_bytes = 64;
+
+//max characters of encoded size bytes (log(256) / log(58) < 1.38)
+constexpr size_t base58_max_chars(const size_t size)
+{
+    return size * 138 / 100 + 1;
+}
+
+//max bytes of decoded size characters
+constexpr size_t base58_max_bytes(const size_t size)
+{
+    return size;
+}
+
+//write base58_max_chars(size) characters at most, return number of written
+size_t encode_base58(const uint8_t* data, const size_t size, char* out);
+size_t encode_base58_ct(const uint8_t* data, const size_t size, char* out);
+
+//decode exactly [str, str + size) to out with out_len bytes,
+//returns false for invalid character or if out is too small
+bool decode_base58(const char* str, const size_t size, uint8_t* out, const size_t out_len, size_t& decoded);
+bool decode_base58_ct(const char* str, const size_t size, uint8_t* out, const size_t out_len, size_t& decoded);
+
 std::string to_base58(const char* d, size_t s);
 std::string to_base58(const std::vector<char>& data);
+//leading and trailing spaces are skipped
 std::vector<char> from_base58(const std::string& base58_str);
 size_t from_base58(const std::string& base58_str, char* out_data, size_t out_data_len);
+
+//constant time versions for secrets (WIF)
+std::string to_base58_ct(const char* d, size_t s);
+std::vector<char> from_base58_ct(const std::string& base58_str);
 } // namespace playchain
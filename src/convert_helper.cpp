@@ -1,15 +1,9 @@
 #include "convert_helper.h"
 #include "playchain_defines.h"
+#include "hex_codec.h"
 
-#if defined(PLAYCHAIN_LIB_FOR_MOBILE)
-#include <cstdlib>
+#include <algorithm>
 #include <ctime>
-#include <time.h> //POSIX strptime
-#else //< PLAYCHAIN_LIB_FOR_MOBILE
-#include <ctime>
-#include <iomanip> // std::put_time, std::get_time
-#include <sstream>
-#endif //< !PLAYCHAIN_LIB_FOR_MOBILE
 #include <chrono>
 
 namespace playchain {
@@ -28,25 +22,11 @@ uint32_t endian_reverse_u32(uint32_t x)
         | (((x)&0xFF) << 0x18);
 }
 
-uint8_t from_hex(char c)
-{
-    if (c >= '0' && c <= '9')
-        return c - '0';
-    if (c >= 'a' && c <= 'f')
-        return c - 'a' + 10;
-    if (c >= 'A' && c <= 'F')
-        return c - 'A' + 10;
-
-    PLAYCHAIN_ERROR("Invalid hex character");
-    return 0;
-}
-
 std::string to_hex(const uint8_t* d, uint32_t s)
 {
-    std::string r;
-    const char* to_hex = "0123456789abcdef";
-    for (uint32_t i = 0; i < s; ++i)
-        (r += to_hex[(d[i] >> 4)]) += to_hex[(d[i] & 0x0f)];
+    std::string r(s * 2, '\0');
+    if (s > 0)
+        encode_hex(d, s, &r[0]);
     return r;
 }
 
@@ -57,21 +37,19 @@ std::string to_hex(const char* d, uint32_t s)
 
 size_t from_hex(const std::string& hex_str, uint8_t* out_data, size_t out_data_len)
 {
-    std::string::const_iterator i = hex_str.begin();
-    uint8_t* out_pos = out_data;
-    uint8_t* out_end = out_pos + out_data_len;
-    while (i != hex_str.end() && out_end != out_pos)
+    //whole pairs, odd character is the high nibble of the last byte
+    const size_t pairs = std::min(hex_str.size() / 2, out_data_len);
+    PLAYCHAIN_ASSERT(default_hex_kernel().decode(hex_str.data(), pairs * 2, out_data), "Invalid hex character");
+
+    if (pairs < out_data_len && pairs * 2 < hex_str.size())
     {
-        *out_pos = from_hex(*i) << 4;
-        ++i;
-        if (i != hex_str.end())
-        {
-            *out_pos |= from_hex(*i);
-            ++i;
-        }
-        ++out_pos;
+        uint8_t last[1] = {};
+        const char odd[2] = { hex_str[pairs * 2], '0' };
+        PLAYCHAIN_ASSERT(default_hex_kernel().decode(odd, 2, last), "Invalid hex character");
+        out_data[pairs] = last[0];
+        return pairs + 1;
     }
-    return out_pos - out_data;
+    return pairs;
 }
 
 size_t from_hex(const std::string& hex_str, char* out_data, size_t out_data_len)
@@ -79,76 +57,140 @@ size_t from_hex(const std::string& hex_str, char* out_data, size_t out_data_len)
     return from_hex(hex_str, (uint8_t*)out_data, out_data_len);
 }
 
-static const char* PLAYCHAIN_TIME_FORMAT = "%Y-%m-%dT%H:%M:%S";
-
-#if !defined(PLAYCHAIN_LIB_FOR_MOBILE)
-#if !defined(PLAYCHAIN_LIB_FOR_WINDOWS)
-time_t from_iso_string(const std::string& formatted)
-{
-    std::stringstream ss;
-
-    ss << formatted;
+namespace {
+    //days since 1970-01-01 of proleptic Gregorian date
+    //(http://howardhinnant.github.io/date_algorithms.html)
+    int64_t days_from_civil(int64_t y, const unsigned m, const unsigned d)
+    {
+        y -= m <= 2;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = (unsigned)(y - era * 400);
+        const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + (int64_t)doe - 719468;
+    }
 
-    std::tm tp {};
+    void civil_from_days(int64_t z, int64_t& y, unsigned& m, unsigned& d)
+    {
+        z += 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = (unsigned)(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp < 10 ? mp + 3 : mp - 9;
+        y = (int64_t)yoe + era * 400 + (m <= 2);
+    }
 
-    ss >> std::get_time(&tp, PLAYCHAIN_TIME_FORMAT);
-    if (!ss.fail())
+    bool is_leap_year(const int64_t y)
     {
-        time_t r = std::mktime(&tp);
-        return r + tp.tm_gmtoff;
+        return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
     }
-    return {};
-}
-#else //< !PLAYCHAIN_LIB_FOR_WINDOWS
-time_t from_iso_string(const std::string& formatted)
-{
-    std::stringstream ss;
 
-    ss << formatted;
+    unsigned last_day_of_month(const int64_t y, const unsigned m)
+    {
+        static const unsigned days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        return m == 2 && is_leap_year(y) ? 29 : days[m - 1];
+    }
 
-    std::tm tp {};
+    void format_digits(char* out, unsigned value, const size_t width)
+    {
+        for (size_t ci = width; ci > 0; --ci)
+        {
+            out[ci - 1] = (char)('0' + value % 10);
+            value /= 10;
+        }
+    }
 
-    ss >> std::get_time(&tp, PLAYCHAIN_TIME_FORMAT);
-    if (!ss.fail())
+    bool parse_digits(const char* in, const size_t width, unsigned& value)
     {
-        return _mkgmtime(&tp);
+        value = 0;
+        for (size_t ci = 0; ci < width; ++ci)
+        {
+            const unsigned digit = (unsigned)(unsigned char)in[ci] - '0';
+            if (digit > 9)
+                return false;
+            value = value * 10 + digit;
+        }
+        return true;
     }
-    return {};
-}
-#endif //< PLAYCHAIN_LIB_FOR_WINDOWS
+} // namespace
 
-std::string to_iso_string(const time_t t)
+size_t format_iso_time(const int64_t t, char* out)
 {
-    std::stringstream ss;
+    const int64_t seconds_per_day = 24 * 60 * 60;
 
-    ss << std::put_time(std::gmtime(&t), PLAYCHAIN_TIME_FORMAT);
+    //floor division for times before epoch
+    int64_t days = t / seconds_per_day;
+    int64_t seconds = t % seconds_per_day;
+    if (seconds < 0)
+    {
+        seconds += seconds_per_day;
+        --days;
+    }
 
-    return ss.str();
+    int64_t y = 0;
+    unsigned m = 0, d = 0;
+    civil_from_days(days, y, m, d);
+
+    PLAYCHAIN_ASSERT(y >= 0 && y <= 9999, "Can't format time");
+
+    //YYYY-MM-DDTHH:MM:SS
+    format_digits(out, (unsigned)y, 4);
+    out[4] = '-';
+    format_digits(out + 5, m, 2);
+    out[7] = '-';
+    format_digits(out + 8, d, 2);
+    out[10] = 'T';
+    format_digits(out + 11, (unsigned)(seconds / 3600), 2);
+    out[13] = ':';
+    format_digits(out + 14, (unsigned)(seconds / 60 % 60), 2);
+    out[16] = ':';
+    format_digits(out + 17, (unsigned)(seconds % 60), 2);
+
+    return iso_time_chars;
 }
-#else //< !PLAYCHAIN_LIB_FOR_MOBILE
-time_t from_iso_string(const std::string& formatted)
+
+bool parse_iso_time(const char* begin, const char* end, int64_t& t)
 {
-    std::tm tp {};
+    if (end - begin < (ptrdiff_t)iso_time_chars)
+        return false;
+
+    if (begin[4] != '-' || begin[7] != '-' || begin[10] != 'T' || begin[13] != ':' || begin[16] != ':')
+        return false;
 
-    auto call_r = strptime(formatted.c_str(), PLAYCHAIN_TIME_FORMAT, &tp);
+    unsigned y = 0, m = 0, d = 0, hh = 0, mm = 0, ss = 0;
+    if (!parse_digits(begin, 4, y) || !parse_digits(begin + 5, 2, m) || !parse_digits(begin + 8, 2, d)
+        || !parse_digits(begin + 11, 2, hh) || !parse_digits(begin + 14, 2, mm) || !parse_digits(begin + 17, 2, ss))
+        return false;
 
-    PLAYCHAIN_ASSERT(call_r != NULL, "Can't parse time");
+    if (m < 1 || m > 12 || d < 1 || d > last_day_of_month(y, m) || hh > 23 || mm > 59 || ss > 59)
+        return false;
 
-    time_t r = std::mktime(&tp);
-    return r + tp.tm_gmtoff;
+    t = days_from_civil(y, m, d) * 24 * 60 * 60 + hh * 3600 + mm * 60 + ss;
+    return true;
 }
 
-std::string to_iso_string(const time_t t)
+time_t from_iso_string(const char* formatted, const size_t size)
 {
-    char buff[100];
+    int64_t t = 0;
+    if (!parse_iso_time(formatted, formatted + size, t))
+        return {};
+    return (time_t)t;
+}
 
-    auto call_r = std::strftime(buff, sizeof(buff), PLAYCHAIN_TIME_FORMAT, std::gmtime(&t));
+time_t from_iso_string(const std::string& formatted)
+{
+    return from_iso_string(formatted.data(), formatted.size());
+}
 
-    PLAYCHAIN_ASSERT(call_r > 0, "Can't format time");
+std::string to_iso_string(const time_t t)
+{
+    char buff[iso_time_chars];
 
-    return { buff };
+    return std::string(buff, format_iso_time(t, buff));
 }
-#endif //< PLAYCHAIN_LIB_FOR_MOBILE
 
 uint64_t create_pseudo_random_from_time(const uint32_t offset)
 {
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <string>
 #include <stdexcept>
+#include <ctime>
 
 namespace playchain {
 
@@ -40,6 +41,14 @@ void from_hex(const std::string& hex_str, T& data)
     PLAYCHAIN_ASSERT(r == hex_str.size() / 2);
 }
 
+//"YYYY-MM-DDTHH:MM:SS" of UTC time without locales and time zones.
+//Characters after seconds are ignored, invalid time is parsed as 0
+constexpr size_t iso_time_chars = 19;
+
+size_t format_iso_time(const int64_t t, char* out);
+bool parse_iso_time(const char* begin, const char* end, int64_t& t);
+
+time_t from_iso_string(const char* formatted, const size_t size);
 time_t from_iso_string(const std::string& formatted);
 std::string to_iso_string(const time_t);
 
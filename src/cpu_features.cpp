@@ -0,0 +1,95 @@
+#include "cpu_features.h"
+
+#if defined(PLAYCHAIN_X86_DISPATCH)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include <cstdint>
+
+namespace playchain {
+
+namespace {
+#if defined(PLAYCHAIN_X86_DISPATCH)
+    void cpuid(const uint32_t leaf, const uint32_t subleaf, uint32_t (&regs)[4])
+    {
+#if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, (int)leaf, (int)subleaf);
+        for (size_t ci = 0; ci < 4; ++ci)
+            regs[ci] = (uint32_t)r[ci];
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    //state components enabled by OS for XSAVE
+    uint64_t xgetbv0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        uint32_t eax = 0, edx = 0;
+        __asm__ volatile("xgetbv"
+                         : "=a"(eax), "=d"(edx)
+                         : "c"(0));
+        return ((uint64_t)edx << 32) | eax;
+#endif
+    }
+
+    cpu_features detect()
+    {
+        cpu_features result;
+
+        uint32_t regs[4] = {};
+        cpuid(0, 0, regs);
+        const uint32_t max_leaf = regs[0];
+        if (max_leaf < 1)
+            return result;
+
+        cpuid(1, 0, regs);
+        const uint32_t ecx1 = regs[2];
+
+        result.ssse3 = (ecx1 & (1u << 9)) != 0;
+        result.sse41 = (ecx1 & (1u << 19)) != 0;
+
+        const bool osxsave = (ecx1 & (1u << 27)) != 0;
+        const bool avx = (ecx1 & (1u << 28)) != 0;
+        const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+        //XMM and YMM state
+        const bool os_avx = avx && (xcr0 & 0x6) == 0x6;
+        //and opmask, ZMM state
+        const bool os_avx512 = os_avx && (xcr0 & 0xE0) == 0xE0;
+
+        if (max_leaf < 7)
+            return result;
+
+        cpuid(7, 0, regs);
+        const uint32_t ebx7 = regs[1];
+
+        result.avx2 = os_avx && (ebx7 & (1u << 5)) != 0;
+        result.bmi2 = (ebx7 & (1u << 8)) != 0;
+        result.avx512f = os_avx512 && (ebx7 & (1u << 16)) != 0;
+        result.avx512bw = result.avx512f && (ebx7 & (1u << 30)) != 0;
+        result.sha = result.sse41 && (ebx7 & (1u << 29)) != 0;
+
+        return result;
+    }
+#else
+    cpu_features detect()
+    {
+        return {};
+    }
+#endif
+} // namespace
+
+const cpu_features& detect_cpu_features()
+{
+    static const cpu_features features = detect();
+    return features;
+}
+
+} // namespace playchain
@@ -0,0 +1,43 @@
+#pragma once
+
+/* Runtime detection of CPU extensions for kernels selected at run time.
+ *
+ * Kernels for extensions are compiled with target attributes
+ * (PLAYCHAIN_TARGET) so the library itself is built for baseline CPU
+ * and doesn't require -m### options. Define PLAYCHAIN_NO_RUNTIME_DISPATCH
+ * to build portable kernels only.
+ * Kernel bodies shared by several extensions use structures of operations
+ * which are PLAYCHAIN_TARGET and PLAYCHAIN_FORCE_INLINE functions. The body
+ * is expanded in every PLAYCHAIN_TARGET kernel, so it is compiled
+ * for its extension and vectors are never passed to functions of other target.
+*/
+
+#if !defined(PLAYCHAIN_NO_RUNTIME_DISPATCH) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#if defined(__GNUC__) || defined(__clang__)
+#define PLAYCHAIN_X86_DISPATCH 1
+#define PLAYCHAIN_TARGET(EXTENSIONS) __attribute__((target(EXTENSIONS)))
+#define PLAYCHAIN_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define PLAYCHAIN_X86_DISPATCH 1
+#define PLAYCHAIN_TARGET(EXTENSIONS)
+#define PLAYCHAIN_FORCE_INLINE __forceinline
+#endif
+#endif
+
+namespace playchain {
+
+struct cpu_features
+{
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool avx2 = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool sha = false;
+};
+
+//detected once, all flags are false without PLAYCHAIN_X86_DISPATCH
+const cpu_features& detect_cpu_features();
+
+} // namespace playchain
@@ -0,0 +1,265 @@
+#include <playchain/diagnostics.h>
+
+#include "diagnostics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace playchain {
+namespace diagnostics {
+
+namespace {
+    using tp::PlaychainDiagnostics;
+
+    //plain storage, nothing is allocated when error is recorded
+    struct slot
+    {
+        std::chrono::system_clock::rep time;
+        const char* method;
+        uint64_t skipped;
+        char error[PlaychainDiagnostics::MAX_ERROR_LENGTH + 1];
+        char json_path[PlaychainDiagnostics::MAX_JSON_PATH_LENGTH + 1];
+    };
+
+    //single producer (owner thread), single consumer (drain under registry lock)
+    struct ring
+    {
+        slot slots[PlaychainDiagnostics::RING_CAPACITY];
+        std::atomic<uint64_t> head { 0 };
+        std::atomic<uint64_t> tail { 0 };
+        //owner thread is finished, ring is removed when it is drained
+        std::atomic<bool> finished { false };
+    };
+
+    struct registry
+    {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ring>> rings;
+    };
+
+    //never destroyed, threads can report errors after static destructors
+    registry& get_registry()
+    {
+        static auto* instance = new registry;
+        return *instance;
+    }
+
+    std::atomic<size_t> sampling { 1 };
+    std::atomic<uint64_t> total_errors { 0 };
+
+    const char ellipsis[] = "...";
+    const size_t ellipsis_length = sizeof(ellipsis) - 1;
+
+    //filled from the end as exception unwinds from inner members to outer ones,
+    //outer segments that do not fit are replaced by ellipsis
+    struct json_path
+    {
+        //holding exception keeps its address from being reused by the next one,
+        //so path of swallowed exception is not attached to another
+        std::exception_ptr owner;
+        char text[PlaychainDiagnostics::MAX_JSON_PATH_LENGTH - ellipsis_length];
+        size_t begin = sizeof(text);
+        bool truncated = false;
+
+        void reset(std::exception_ptr e)
+        {
+            owner = std::move(e);
+            begin = sizeof(text);
+            truncated = false;
+        }
+
+        //"key" or "[index]", separated by dot from the next key
+        void prepend(const char* segment, const size_t length)
+        {
+            if (truncated)
+                return;
+
+            const bool dot = begin != sizeof(text) && text[begin] != '[';
+            if (length + dot > begin)
+            {
+                truncated = true;
+                return;
+            }
+            if (dot)
+                text[--begin] = '.';
+            begin -= length;
+            std::memcpy(text + begin, segment, length);
+        }
+
+        void copy_to(char (&out)[PlaychainDiagnostics::MAX_JSON_PATH_LENGTH + 1]) const
+        {
+            size_t pos = 0;
+            if (truncated)
+            {
+                std::memcpy(out, ellipsis, ellipsis_length);
+                pos = ellipsis_length;
+            }
+            const size_t length = sizeof(text) - begin;
+            std::memcpy(out + pos, text + begin, length);
+            out[pos + length] = '\0';
+        }
+    };
+
+    struct thread_state
+    {
+        ~thread_state()
+        {
+            if (records)
+                records->finished.store(true, std::memory_order_release);
+        }
+
+        //registered by the first recorded error of thread
+        std::shared_ptr<ring> records;
+        uint64_t errors = 0;
+        uint64_t skipped = 0;
+        json_path path;
+    };
+
+    thread_local thread_state state;
+
+    ring& thread_ring()
+    {
+        if (!state.records)
+        {
+            auto records = std::make_shared<ring>();
+
+            registry& r = get_registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.rings.emplace_back(records);
+            state.records = std::move(records);
+        }
+        return *state.records;
+    }
+
+    //path of exception that is being handled
+    json_path& current_path()
+    {
+        std::exception_ptr e = std::current_exception();
+        if (state.path.owner != e)
+            state.path.reset(std::move(e));
+        return state.path;
+    }
+
+    template <size_t N>
+    void copy_truncated(char (&out)[N], const char* text)
+    {
+        const size_t length = strnlen(text, N - 1);
+        std::memcpy(out, text, length);
+        out[length] = '\0';
+    }
+} // namespace
+
+void add_json_key(const std::exception&, const char* key)
+{
+    current_path().prepend(key, std::strlen(key));
+}
+
+void add_json_index(const std::exception&, const size_t index)
+{
+    //%zu is not supported by old Windows runtimes
+    char segment[24];
+    const int length = std::snprintf(segment, sizeof(segment), "[%llu]", static_cast<unsigned long long>(index));
+
+    current_path().prepend(segment, static_cast<size_t>(length));
+}
+
+void report(const char* method, const std::exception& e)
+{
+    const bool has_path = state.path.owner && state.path.owner == std::current_exception();
+    //exception is released
+    state.path.owner = nullptr;
+
+    total_errors.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t every_nth = sampling.load(std::memory_order_relaxed);
+    if (state.errors++ % every_nth != 0)
+    {
+        ++state.skipped;
+        return;
+    }
+
+    ring& records = thread_ring();
+
+    const uint64_t head = records.head.load(std::memory_order_relaxed);
+    if (head - records.tail.load(std::memory_order_acquire) >= PlaychainDiagnostics::RING_CAPACITY)
+    {
+        ++state.skipped;
+        return;
+    }
+
+    slot& record = records.slots[head % PlaychainDiagnostics::RING_CAPACITY];
+    record.time = std::chrono::system_clock::now().time_since_epoch().count();
+    record.method = method;
+    record.skipped = state.skipped;
+    copy_truncated(record.error, e.what());
+    if (has_path)
+        state.path.copy_to(record.json_path);
+    else
+        record.json_path[0] = '\0';
+
+    records.head.store(head + 1, std::memory_order_release);
+    state.skipped = 0;
+}
+
+} // namespace diagnostics
+} // namespace playchain
+
+namespace tp {
+
+void PlaychainDiagnostics::setSampling(const size_t every_nth_error)
+{
+    playchain::diagnostics::sampling = std::max<size_t>(every_nth_error, 1);
+}
+
+std::vector<PlaychainDiagnosticRecord> PlaychainDiagnostics::drain()
+{
+    using namespace playchain::diagnostics;
+
+    std::vector<PlaychainDiagnosticRecord> result;
+
+    registry& r = get_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    for (auto it = r.rings.begin(); it != r.rings.end();)
+    {
+        ring& records = **it;
+
+        //head does not move after owner thread is finished
+        const bool finished = records.finished.load(std::memory_order_acquire);
+        const uint64_t head = records.head.load(std::memory_order_acquire);
+
+        for (uint64_t pos = records.tail.load(std::memory_order_relaxed); pos != head; ++pos)
+        {
+            const slot& record = records.slots[pos % RING_CAPACITY];
+
+            PlaychainDiagnosticRecord item;
+            item.time = std::chrono::system_clock::time_point { std::chrono::system_clock::duration { record.time } };
+            item.method = record.method;
+            item.error = record.error;
+            item.json_path = record.json_path;
+            item.skipped = record.skipped;
+            result.emplace_back(std::move(item));
+        }
+        records.tail.store(head, std::memory_order_release);
+
+        if (finished)
+            it = r.rings.erase(it);
+        else
+            ++it;
+    }
+
+    return result;
+}
+
+uint64_t PlaychainDiagnostics::errors()
+{
+    return playchain::diagnostics::total_errors;
+}
+
+} // namespace tp
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <playchain/diagnostics.h>
+
+#include <cstddef>
+#include <exception>
+
+//Recording of swallowed errors (see include/playchain/diagnostics.h)
+
+namespace playchain {
+namespace diagnostics {
+
+    //Decoders call it in catch block while exception unwinds through them,
+    //so the innermost member is added first and good path costs nothing.
+    //Path is kept for the exception being handled by thread only
+    void add_json_key(const std::exception& e, const char* key);
+    void add_json_index(const std::exception& e, const size_t index);
+
+    //records error (if it is sampled) with JSON path collected for it,
+    //it is called in catch block of e,
+    //method should have static storage duration
+    void report(const char* method, const std::exception& e);
+} // namespace diagnostics
+} // namespace playchain
+
+#define PLAYCHAIN_LOG_ERROR(EXCEPTION) playchain::diagnostics::report(__func__, EXCEPTION)
@@ -0,0 +1,207 @@
+#include "hex_codec.h"
+#include "cpu_features.h"
+
+#if defined(PLAYCHAIN_X86_DISPATCH)
+#include <immintrin.h>
+#endif
+
+namespace playchain {
+
+namespace {
+    const char hex_digits[] = "0123456789abcdef";
+
+    struct hex_tables
+    {
+        hex_tables()
+        {
+            for (size_t ci = 0; ci < 256; ++ci)
+            {
+                pairs[ci * 2] = hex_digits[ci >> 4];
+                pairs[ci * 2 + 1] = hex_digits[ci & 0x0f];
+                values[ci] = invalid;
+            }
+            for (uint8_t ci = 0; ci < 10; ++ci)
+                values['0' + ci] = ci;
+            for (uint8_t ci = 0; ci < 6; ++ci)
+            {
+                values['a' + ci] = 10 + ci;
+                values['A' + ci] = 10 + ci;
+            }
+        }
+
+        static constexpr uint8_t invalid = 0xff;
+
+        char pairs[512];
+        uint8_t values[256];
+    };
+
+    const hex_tables& tables()
+    {
+        static const hex_tables instance;
+        return instance;
+    }
+
+    void encode_scalar(const uint8_t* data, const size_t size, char* out)
+    {
+        const char* pairs = tables().pairs;
+        for (size_t ci = 0; ci < size; ++ci)
+        {
+            const char* pair = pairs + data[ci] * 2;
+            out[ci * 2] = pair[0];
+            out[ci * 2 + 1] = pair[1];
+        }
+    }
+
+    bool decode_scalar(const char* hex, const size_t size, uint8_t* out)
+    {
+        const uint8_t* values = tables().values;
+
+        //accumulate invalid flags to have no branches in loop
+        uint8_t invalid = 0;
+        for (size_t ci = 0; ci + 1 < size; ci += 2)
+        {
+            const uint8_t hi = values[(uint8_t)hex[ci]];
+            const uint8_t lo = values[(uint8_t)hex[ci + 1]];
+            invalid |= (hi | lo) & 0xf0;
+            out[ci / 2] = (uint8_t)((hi << 4) | (lo & 0x0f));
+        }
+        return invalid == 0;
+    }
+
+#if defined(PLAYCHAIN_X86_DISPATCH)
+    PLAYCHAIN_TARGET("ssse3")
+    void encode_ssse3(const uint8_t* data, const size_t size, char* out)
+    {
+        const __m128i digits = _mm_loadu_si128((const __m128i*)hex_digits);
+        const __m128i low_mask = _mm_set1_epi8(0x0f);
+
+        size_t ci = 0;
+        for (; ci + 16 <= size; ci += 16)
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(data + ci));
+            const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), low_mask));
+            const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, low_mask));
+            _mm_storeu_si128((__m128i*)(out + ci * 2), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128((__m128i*)(out + ci * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+        }
+        encode_scalar(data + ci, size - ci, out + ci * 2);
+    }
+
+    //nibble values of 16 characters, sets invalid lanes in errors
+    PLAYCHAIN_TARGET("ssse3")
+    __m128i hex_values_ssse3(const __m128i c, __m128i& errors)
+    {
+        //characters >= 0x80 are negative and fail signed comparisons
+        const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+        const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+        const __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+        errors = _mm_or_si128(errors, _mm_andnot_si128(_mm_or_si128(is_digit, is_alpha), _mm_set1_epi8(-1)));
+
+        return _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                            _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+    }
+
+    PLAYCHAIN_TARGET("ssse3")
+    bool decode_ssse3(const char* hex, const size_t size, uint8_t* out)
+    {
+        //hi * 16 + lo for every pair of characters
+        const __m128i weights = _mm_set1_epi16(0x0110);
+
+        __m128i errors = _mm_setzero_si128();
+
+        size_t ci = 0;
+        for (; ci + 32 <= size; ci += 32)
+        {
+            const __m128i a = hex_values_ssse3(_mm_loadu_si128((const __m128i*)(hex + ci)), errors);
+            const __m128i b = hex_values_ssse3(_mm_loadu_si128((const __m128i*)(hex + ci + 16)), errors);
+            _mm_storeu_si128((__m128i*)(out + ci / 2), _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights)));
+        }
+
+        return _mm_movemask_epi8(errors) == 0 && decode_scalar(hex + ci, size - ci, out + ci / 2);
+    }
+
+    PLAYCHAIN_TARGET("avx2")
+    void encode_avx2(const uint8_t* data, const size_t size, char* out)
+    {
+        const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)hex_digits));
+        const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+        size_t ci = 0;
+        for (; ci + 32 <= size; ci += 32)
+        {
+            const __m256i v = _mm256_loadu_si256((const __m256i*)(data + ci));
+            const __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+            const __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, low_mask));
+            //unpack works in 128-bit lanes
+            const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+            const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+            _mm256_storeu_si256((__m256i*)(out + ci * 2), _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256((__m256i*)(out + ci * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+        }
+        encode_ssse3(data + ci, size - ci, out + ci * 2);
+    }
+
+    PLAYCHAIN_TARGET("avx2")
+    __m256i hex_values_avx2(const __m256i c, __m256i& errors)
+    {
+        const __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+        const __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+        const __m256i is_alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+
+        errors = _mm256_or_si256(errors, _mm256_andnot_si256(_mm256_or_si256(is_digit, is_alpha), _mm256_set1_epi8(-1)));
+
+        return _mm256_or_si256(_mm256_and_si256(is_digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+                               _mm256_and_si256(is_alpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+    }
+
+    PLAYCHAIN_TARGET("avx2")
+    bool decode_avx2(const char* hex, const size_t size, uint8_t* out)
+    {
+        const __m256i weights = _mm256_set1_epi16(0x0110);
+
+        __m256i errors = _mm256_setzero_si256();
+
+        size_t ci = 0;
+        for (; ci + 64 <= size; ci += 64)
+        {
+            const __m256i a = hex_values_avx2(_mm256_loadu_si256((const __m256i*)(hex + ci)), errors);
+            const __m256i b = hex_values_avx2(_mm256_loadu_si256((const __m256i*)(hex + ci + 32)), errors);
+            //pack works in 128-bit lanes
+            const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+            _mm256_storeu_si256((__m256i*)(out + ci / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+
+        return _mm256_movemask_epi8(errors) == 0 && decode_ssse3(hex + ci, size - ci, out + ci / 2);
+    }
+#endif //< PLAYCHAIN_X86_DISPATCH
+
+    std::vector<hex_kernel> detect_hex_kernels()
+    {
+        std::vector<hex_kernel> result;
+
+        result.push_back({ "scalar", encode_scalar, decode_scalar });
+#if defined(PLAYCHAIN_X86_DISPATCH)
+        const cpu_features& features = detect_cpu_features();
+        if (features.ssse3)
+            result.push_back({ "ssse3", encode_ssse3, decode_ssse3 });
+        if (features.ssse3 && features.avx2)
+            result.push_back({ "avx2", encode_avx2, decode_avx2 });
+#endif
+        return result;
+    }
+} // namespace
+
+const std::vector<hex_kernel>& supported_hex_kernels()
+{
+    static const std::vector<hex_kernel> kernels = detect_hex_kernels();
+    return kernels;
+}
+
+const hex_kernel& default_hex_kernel()
+{
+    static const hex_kernel& kernel = supported_hex_kernels().back();
+    return kernel;
+}
+
+} // namespace playchain
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Hex encoding and decoding to caller buffers.
+ *
+ * Kernel is selected at run time by CPU extensions (see cpu_features.h):
+ * AVX2, SSSE3 or portable scalar one.
+*/
+
+namespace playchain {
+
+struct hex_kernel
+{
+    const char* name;
+    //writes 2 * size lower case characters
+    void (*encode)(const uint8_t* data, const size_t size, char* out);
+    //decodes size / 2 bytes of hex with even size,
+    //returns false if there is invalid character (out is unspecified then)
+    bool (*decode)(const char* hex, const size_t size, uint8_t* out);
+};
+
+//the fastest kernel supported by CPU
+const hex_kernel& default_hex_kernel();
+//all kernels supported by CPU (for tests and benchmarks)
+const std::vector<hex_kernel>& supported_hex_kernels();
+
+inline void encode_hex(const uint8_t* data, const size_t size, char* out)
+{
+    default_hex_kernel().encode(data, size, out);
+}
+
+inline bool decode_hex(const char* hex, const size_t size, uint8_t* out)
+{
+    return size % 2 == 0 && default_hex_kernel().decode(hex, size, out);
+}
+
+} // namespace playchain
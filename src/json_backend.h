@@ -0,0 +1,41 @@
+#pragma once
+
+/* The only place where RapidJSON is included.
+ *
+ * Its SIMD scanning is selected at build time
+ * (PLAYCHAIN_JSON_SIMD option of CMakeLists.txt).
+ * SIMD macros must be the same for every translation unit,
+ * so they are defined by build rather than here.
+*/
+
+#if defined(RAPIDJSON_SSE42) && !defined(__SSE4_2__) && !defined(_MSC_VER)
+#error "RAPIDJSON_SSE42 requires SSE4.2 code generation (-msse4.2)"
+#endif
+#if defined(RAPIDJSON_SSE2) && !defined(__SSE2__) && !defined(_MSC_VER)
+#error "RAPIDJSON_SSE2 requires SSE2 code generation (-msse2)"
+#endif
+#if defined(RAPIDJSON_NEON) && !defined(__ARM_NEON) && !defined(__ARM_NEON__)
+#error "RAPIDJSON_NEON requires NEON code generation"
+#endif
+
+#include <rapidjson/allocators.h>
+#include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace playchain {
+
+#if defined(RAPIDJSON_SSE42)
+constexpr const char* json_simd_name = "sse4.2";
+#elif defined(RAPIDJSON_SSE2)
+constexpr const char* json_simd_name = "sse2";
+#elif defined(RAPIDJSON_NEON)
+constexpr const char* json_simd_name = "neon";
+#else
+constexpr const char* json_simd_name = "none";
+#endif
+
+} // namespace playchain
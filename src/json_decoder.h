@@ -0,0 +1,183 @@
+#pragma once
+
+#include "playchain_defines.h"
+
+#include "json_backend.h"
+#include "diagnostics.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace playchain {
+
+//FNV-1a. It is constexpr to fill key tables at compile time
+constexpr uint32_t json_key_hash(const char* str, uint32_t hash = 2166136261u)
+{
+    return (*str) ? json_key_hash(str + 1, (hash ^ (uint32_t)(uint8_t)(*str)) * 16777619u) : hash;
+}
+
+inline uint32_t json_key_hash_n(const char* str, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t ci = 0; ci < length; ++ci)
+    {
+        hash = (hash ^ (uint32_t)(uint8_t)str[ci]) * 16777619u;
+    }
+    return hash;
+}
+
+constexpr size_t json_key_length(const char* str, size_t length = 0)
+{
+    return (*str) ? json_key_length(str + 1, length + 1) : length;
+}
+
+struct json_key
+{
+    constexpr json_key(const char* name)
+        : name(name)
+        , length(json_key_length(name))
+        , hash(json_key_hash(name))
+    {
+    }
+
+    const char* name;
+    size_t length;
+    uint32_t hash;
+};
+
+using json_fields_mask = uint64_t;
+
+constexpr json_fields_mask json_field_bit(size_t field)
+{
+    return json_fields_mask { 1 } << field;
+}
+
+//mask for fields [0, count)
+constexpr json_fields_mask json_fields_below(size_t count)
+{
+    return (count >= sizeof(json_fields_mask) * 8) ? ~json_fields_mask { 0 } : json_field_bit(count) - 1;
+}
+
+//duplicated keys are resolved by first occurrence unless mode is unique
+enum class json_decode_mode
+{
+    //every required key must be present
+    strict = 0,
+    //absent keys keep default values
+    lenient,
+    //every required key must be present exactly once
+    unique,
+};
+
+inline size_t find_json_key(const json_key* keys, const size_t count,
+                            const char* name, const size_t length,
+                            const size_t expected)
+{
+    //objects are serialized by node in reflection order,
+    //so the key next to the previous one matches without hashing in most cases
+    if (expected < count && keys[expected].length == length && std::memcmp(keys[expected].name, name, length) == 0)
+        return expected;
+
+    const uint32_t hash = json_key_hash_n(name, length);
+    for (size_t ci = 0; ci < count; ++ci)
+    {
+        const json_key& key = keys[ci];
+        if (key.hash == hash && key.length == length && std::memcmp(key.name, name, length) == 0)
+            return ci;
+    }
+    return count;
+}
+
+/* Iterates object members only once and dispatches each known member
+ * to handler(field_index, json_value). Unknown members are skipped.
+ *
+ * keys[0..count) is the key table of the target structure,
+ * required - mask of fields that must be present in strict and unique modes.
+ *
+ * Returns mask of decoded fields.
+*/
+template <typename TJsonObject, typename Handler>
+json_fields_mask decode_json_object(const TJsonObject& js_object,
+                                    const json_key* keys,
+                                    const size_t count,
+                                    const json_fields_mask required,
+                                    const json_decode_mode mode,
+                                    Handler&& handler)
+{
+    assert(count <= sizeof(json_fields_mask) * 8);
+
+    PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+
+    json_fields_mask decoded = 0;
+    size_t expected = 0;
+
+    for (auto it = js_object.MemberBegin(); it != js_object.MemberEnd(); ++it)
+    {
+        size_t field = find_json_key(keys, count, it->name.GetString(), it->name.GetStringLength(), expected);
+        if (field >= count)
+            continue;
+
+        if (decoded & json_field_bit(field))
+        {
+            PLAYCHAIN_ASSERT_JSON(mode != json_decode_mode::unique);
+            continue;
+        }
+
+        decoded |= json_field_bit(field);
+        expected = field + 1;
+
+        try
+        {
+            handler(field, it->value);
+        }
+        catch (const std::exception& e)
+        {
+            diagnostics::add_json_key(e, keys[field].name);
+            throw;
+        }
+    }
+
+    if (mode != json_decode_mode::lenient && (decoded & required) != required)
+    {
+        //the first absent key is path of error
+        size_t field = 0;
+        while (!(required & ~decoded & json_field_bit(field)))
+            ++field;
+
+        try
+        {
+            PLAYCHAIN_ASSERT_JSON((decoded & required) == required);
+        }
+        catch (const std::exception& e)
+        {
+            diagnostics::add_json_key(e, keys[field].name);
+            throw;
+        }
+    }
+
+    return decoded;
+}
+
+template <size_t N, typename TJsonObject, typename Handler>
+json_fields_mask decode_json_object(const TJsonObject& js_object,
+                                    const json_key (&keys)[N],
+                                    const json_fields_mask required,
+                                    const json_decode_mode mode,
+                                    Handler&& handler)
+{
+    return decode_json_object(js_object, keys, N, required, mode, std::forward<Handler>(handler));
+}
+
+template <typename TJsonValue>
+void decode_json_string(const TJsonValue& js_value, std::string& out)
+{
+    PLAYCHAIN_ASSERT_JSON(js_value.IsString());
+
+    out.assign(js_value.GetString(), js_value.GetStringLength());
+}
+
+} // namespace playchain
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "json_backend.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace playchain {
+
+/* rapidjson memory pool in reusable buffer.
+ * reset() drops everything allocated since previous reset.
+ * If allocations did not fit into buffer it grows buffer
+ * so next time the same amount of data is allocated without heap.
+*/
+class json_memory_pool
+{
+public:
+    using allocator_type = rapidjson::MemoryPoolAllocator<>;
+
+    explicit json_memory_pool(const size_t capacity)
+        : _buffer(std::max<size_t>(capacity, 1024u))
+    {
+        _allocator.reset(new allocator_type(_buffer.data(), _buffer.size()));
+    }
+
+    json_memory_pool(const json_memory_pool&) = delete;
+    json_memory_pool& operator=(const json_memory_pool&) = delete;
+
+    allocator_type& allocator()
+    {
+        return *_allocator;
+    }
+
+    size_t capacity() const
+    {
+        return _buffer.size();
+    }
+
+    size_t high_water_mark() const
+    {
+        return _high_water_mark;
+    }
+
+    size_t overflows() const
+    {
+        return _overflows;
+    }
+
+    //returns true if buffer was grown (allocator was recreated)
+    bool reset(size_t& used)
+    {
+        used = _allocator->Size();
+        _high_water_mark = std::max(_high_water_mark, used);
+
+        if (_allocator->Capacity() <= _buffer.size())
+        {
+            _allocator->Clear();
+            return false;
+        }
+
+        ++_overflows;
+
+        size_t capacity = _buffer.size();
+        while (capacity < used * 2)
+            capacity *= 2;
+
+        _allocator.reset();
+        std::vector<char>(capacity).swap(_buffer);
+        _allocator.reset(new allocator_type(_buffer.data(), _buffer.size()));
+
+        return true;
+    }
+
+    bool reset()
+    {
+        size_t used;
+        return reset(used);
+    }
+
+private:
+    std::vector<char> _buffer;
+    std::unique_ptr<allocator_type> _allocator;
+    size_t _high_water_mark = 0;
+    size_t _overflows = 0;
+};
+
+} // namespace playchain
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "json_backend.h"
+
+namespace tp {
+
+//JSON-RPC message in document of parse arena
+struct PlaychainParsedMessageContext
+{
+    const rapidjson::Value* root = nullptr;
+    //"result" of response or "params"[1] of notice,
+    //nullptr for error response
+    const rapidjson::Value* payload = nullptr;
+};
+
+} // namespace tp
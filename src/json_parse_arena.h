@@ -0,0 +1,143 @@
+#pragma once
+
+#include <playchain/parse_arena.h>
+#include <playchain/playchain_types.h>
+
+#include "json_memory_pool.h"
+#include "json_stream_parser.h"
+
+#include "json_backend.h"
+
+#include <memory>
+
+namespace playchain {
+
+//document with values and parse stack in memory pools
+using json_document = rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>, rapidjson::MemoryPoolAllocator<>>;
+using json_reader = rapidjson::GenericReader<rapidjson::UTF8<>, rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>>;
+
+template <unsigned ParseFlags, typename Document, typename InputStream>
+void parse_document_stream(Document& document, InputStream& stream, const size_t size)
+{
+    document.template ParseStream<ParseFlags>(stream);
+
+    //null character is the end of stream for parser, so response with
+    //embedded one gets parse error of empty document instead of being cut
+    if (!document.HasParseError() && stream.Tell() != size)
+        document.Parse("", 0);
+}
+
+template <typename Document>
+void parse_document(Document& document, const tp::BlockchainResponseView& response)
+{
+    //null terminated input is scanned by SIMD code if it is enabled
+    if (response.insitu())
+    {
+        rapidjson::InsituStringStream stream(response.insitu_buffer());
+        parse_document_stream<rapidjson::kParseInsituFlag>(document, stream, response.size());
+    }
+    else if (response.null_terminated())
+    {
+        rapidjson::StringStream stream(response.data());
+        parse_document_stream<rapidjson::kParseDefaultFlags>(document, stream, response.size());
+    }
+    else
+    {
+        rapidjson::MemoryStream memory(response.data(), response.size());
+        rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> stream(memory);
+        parse_document_stream<rapidjson::kParseDefaultFlags>(document, stream, response.size());
+    }
+}
+
+} // namespace playchain
+
+namespace tp {
+
+struct PlaychainParseArenaContext
+{
+    explicit PlaychainParseArenaContext(const size_t capacity);
+
+    //returns nullptr if document is in use
+    playchain::json_document* acquire_document();
+    void release_document();
+
+    //returns false if stream parsing memory is in use
+    bool acquire_stream();
+    void release_stream();
+
+    PlaychainParseArenaStats stats() const;
+
+    playchain::json_memory_pool document_values;
+    playchain::json_memory_pool document_stack;
+    playchain::json_memory_pool reader_stack;
+    playchain::json_value_builder element;
+
+    std::unique_ptr<playchain::json_document> document;
+    bool document_busy = false;
+    bool stream_busy = false;
+    size_t stream_element_overflows = 0;
+
+    size_t high_water_mark = 0;
+    size_t parses = 0;
+    size_t overflows = 0;
+    size_t fallbacks = 0;
+
+private:
+    void reset_document();
+    void update_stats(const size_t used, const bool overflow);
+};
+
+} // namespace tp
+
+namespace playchain {
+
+//DOM document from arena or temporary one if arena is in use
+//(for nested parsing from stream callbacks)
+class json_document_lease
+{
+public:
+    explicit json_document_lease(tp::PlaychainParseArena& arena);
+    ~json_document_lease();
+
+    json_document_lease(const json_document_lease&) = delete;
+    json_document_lease& operator=(const json_document_lease&) = delete;
+
+    json_document& document()
+    {
+        return *_document;
+    }
+
+private:
+    tp::PlaychainParseArenaContext* _arena = nullptr;
+    std::unique_ptr<json_document> _own;
+    json_document* _document = nullptr;
+};
+
+//SAX reader and element builder from arena or temporary ones
+class json_stream_lease
+{
+public:
+    explicit json_stream_lease(tp::PlaychainParseArena& arena);
+    ~json_stream_lease();
+
+    json_stream_lease(const json_stream_lease&) = delete;
+    json_stream_lease& operator=(const json_stream_lease&) = delete;
+
+    json_reader& reader()
+    {
+        return _reader;
+    }
+
+    json_value_builder& element()
+    {
+        return *_element;
+    }
+
+private:
+    tp::PlaychainParseArenaContext* _arena = nullptr;
+    std::unique_ptr<json_value_builder> _own;
+    json_value_builder* _element = nullptr;
+    json_reader _reader;
+};
+
+} // namespace playchain
@@ -0,0 +1,598 @@
+#pragma once
+
+#include "playchain_defines.h"
+#include "json_decoder.h"
+#include "json_memory_pool.h"
+
+#include "json_backend.h"
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace playchain {
+
+//Members of built object to keep. Other members (and unknown ones)
+//are skipped with their subtrees without building values.
+struct json_projection
+{
+    json_projection() = default;
+    json_projection(const json_key* keys, const size_t count, const json_fields_mask fields)
+        : keys(keys)
+        , count(count)
+        , fields(fields)
+    {
+    }
+
+    bool all() const
+    {
+        return keys == nullptr;
+    }
+
+    const json_key* keys = nullptr;
+    size_t count = 0;
+    json_fields_mask fields = ~json_fields_mask { 0 };
+};
+
+/* SAX handler that builds single JSON value.
+ * It is used to materialize one array element at a time,
+ * memory is reused after reset().
+*/
+class json_value_builder
+{
+public:
+    explicit json_value_builder(const size_t capacity = 4096)
+        : _pool(capacity)
+    {
+    }
+
+    json_value_builder(const json_value_builder&) = delete;
+    json_value_builder& operator=(const json_value_builder&) = delete;
+
+    bool complete() const
+    {
+        return _complete;
+    }
+
+    const rapidjson::Value& value() const
+    {
+        return _root;
+    }
+
+    const json_memory_pool& pool() const
+    {
+        return _pool;
+    }
+
+    //applied to members of top level object,
+    //kept until it is replaced
+    void set_projection(const json_projection& projection)
+    {
+        _projection = projection;
+    }
+
+    void reset()
+    {
+        _root.SetNull();
+        _stack.clear();
+        _keys.clear();
+        _complete = false;
+        _skipping = false;
+        _skip_depth = 0;
+        _expected_field = 0;
+        _pool.reset();
+    }
+
+    bool Null()
+    {
+        return _skipping ? skip_scalar() : add(rapidjson::Value {});
+    }
+    bool Bool(bool b)
+    {
+        return _skipping ? skip_scalar() : add(rapidjson::Value { b });
+    }
+    bool Int(int i)
+    {
+        return _skipping ? skip_scalar() : add(rapidjson::Value { i });
+    }
+    bool Uint(unsigned i)
+    {
+        return _skipping ? skip_scalar() : add(rapidjson::Value { i });
+    }
+    bool Int64(int64_t i)
+    {
+        return _skipping ? skip_scalar() : add(rapidjson::Value { i });
+    }
+    bool Uint64(uint64_t i)
+    {
+        return _skipping ? skip_scalar() : add(rapidjson::Value { i });
+    }
+    bool Double(double d)
+    {
+        return _skipping ? skip_scalar() : add(rapidjson::Value { d });
+    }
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        return String(str, length, copy);
+    }
+    bool String(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        if (_skipping)
+            return skip_scalar();
+        //in-situ strings stay in source buffer
+        if (!copy)
+            return add(rapidjson::Value { rapidjson::StringRef(str, length) });
+        return add(rapidjson::Value { str, length, _pool.allocator() });
+    }
+    bool StartObject()
+    {
+        if (_skipping)
+            return skip_start();
+        _stack.emplace_back(rapidjson::kObjectType);
+        return true;
+    }
+    bool Key(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        if (_skipping)
+            return true;
+        if (!_projection.all() && _stack.size() == 1u && _stack.back().IsObject() && !projected(str, length))
+        {
+            _skipping = true;
+            _skip_depth = 0;
+            return true;
+        }
+        if (!copy)
+            _keys.emplace_back(rapidjson::StringRef(str, length));
+        else
+            _keys.emplace_back(str, length, _pool.allocator());
+        return true;
+    }
+    bool EndObject(rapidjson::SizeType)
+    {
+        return _skipping ? skip_end() : end_container();
+    }
+    bool StartArray()
+    {
+        if (_skipping)
+            return skip_start();
+        _stack.emplace_back(rapidjson::kArrayType);
+        return true;
+    }
+    bool EndArray(rapidjson::SizeType)
+    {
+        return _skipping ? skip_end() : end_container();
+    }
+
+private:
+    bool add(rapidjson::Value&& value)
+    {
+        if (_stack.empty())
+        {
+            _root = std::move(value);
+            _complete = true;
+            return true;
+        }
+
+        rapidjson::Value& parent = _stack.back();
+        if (parent.IsObject())
+        {
+            parent.AddMember(_keys.back(), value, _pool.allocator());
+            _keys.pop_back();
+        }
+        else
+        {
+            parent.PushBack(value, _pool.allocator());
+        }
+        return true;
+    }
+
+    bool end_container()
+    {
+        rapidjson::Value value { std::move(_stack.back()) };
+        _stack.pop_back();
+        return add(std::move(value));
+    }
+
+    bool projected(const char* str, const size_t length)
+    {
+        const size_t field = find_json_key(_projection.keys, _projection.count, str, length, _expected_field);
+        if (field >= _projection.count)
+            return false;
+
+        _expected_field = field + 1;
+        return (_projection.fields & json_field_bit(field)) != 0;
+    }
+
+    //skipped member value is either scalar or subtree
+    bool skip_scalar()
+    {
+        if (_skip_depth == 0)
+            _skipping = false;
+        return true;
+    }
+    bool skip_start()
+    {
+        ++_skip_depth;
+        return true;
+    }
+    bool skip_end()
+    {
+        if (--_skip_depth == 0)
+            _skipping = false;
+        return true;
+    }
+
+    json_memory_pool _pool;
+    rapidjson::Value _root;
+    std::vector<rapidjson::Value> _stack;
+    std::vector<rapidjson::Value> _keys;
+    bool _complete = false;
+    json_projection _projection;
+    bool _skipping = false;
+    size_t _skip_depth = 0;
+    size_t _expected_field = 0;
+};
+
+//step of path from document root: member key or array index
+struct json_path_step
+{
+    constexpr json_path_step(const char* key)
+        : key(key)
+        , index(0)
+    {
+    }
+    constexpr json_path_step(const int index)
+        : key(nullptr)
+        , index((size_t)index)
+    {
+    }
+
+    const char* key;
+    size_t index;
+};
+
+//{"id": .., "result": [...]}
+constexpr json_path_step json_result_path[] = { "result" };
+//{"method": "notice", "params": [cookie, [[...]]]}
+constexpr json_path_step json_notice_path[] = { "params", 1, 0 };
+
+constexpr size_t json_max_path_length = 4;
+
+//JSON-RPC members that are read while streaming
+struct json_envelope
+{
+    bool has_id = false;
+    int64_t id = 0;
+    bool has_error = false;
+    //first item of "params" (cookie of notification)
+    bool has_cookie = false;
+    int64_t cookie = 0;
+    //method name, empty if it is too long
+    char method[16] = {};
+    size_t method_length = 0;
+
+    //value at streamed path
+    bool found = false;
+    bool found_array = false;
+    //item counts of closed containers on path, [0] is document root,
+    //[i] is value at path step i - 1
+    size_t path_size[json_max_path_length + 1] = {};
+
+    bool is_method(const char* name) const
+    {
+        return method_length == std::strlen(name) && std::memcmp(method, name, method_length) == 0;
+    }
+};
+
+/* SAX handler that streams elements of array at the path from document root.
+ * Every element is built by json_value_builder (memory is reused for next element)
+ * and passed to on_element(const rapidjson::Value&). The rest of the document
+ * is skipped without building values, only JSON-RPC envelope members are kept.
+*/
+template <typename OnElement>
+class json_array_stream_handler
+{
+public:
+    static const size_t MAX_PATH_LENGTH = json_max_path_length;
+
+    json_array_stream_handler(const json_path_step* path, const size_t path_length, json_value_builder& element,
+                              json_envelope& envelope, OnElement& on_element)
+        : _path(path)
+        , _path_length(path_length)
+        , _element(element)
+        , _envelope(envelope)
+        , _on_element(on_element)
+    {
+    }
+
+    bool Null()
+    {
+        return scalar([&] { return _element.Null(); });
+    }
+    bool Bool(bool b)
+    {
+        return scalar([&] { return _element.Bool(b); });
+    }
+    bool Int(int i)
+    {
+        capture_int(i);
+        return scalar([&] { return _element.Int(i); });
+    }
+    bool Uint(unsigned i)
+    {
+        capture_int(i);
+        return scalar([&] { return _element.Uint(i); });
+    }
+    bool Int64(int64_t i)
+    {
+        capture_int(i);
+        return scalar([&] { return _element.Int64(i); });
+    }
+    bool Uint64(uint64_t i)
+    {
+        capture_int((int64_t)i);
+        return scalar([&] { return _element.Uint64(i); });
+    }
+    bool Double(double d)
+    {
+        return scalar([&] { return _element.Double(d); });
+    }
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        return String(str, length, copy);
+    }
+    bool String(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        if (_depth == 1 && _root_key == root_key::method && length < sizeof(_envelope.method))
+        {
+            std::memcpy(_envelope.method, str, length);
+            _envelope.method_length = length;
+        }
+        return scalar([&] { return _element.String(str, length, copy); });
+    }
+    bool Key(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        if (in_element())
+            return _element.Key(str, length, copy);
+
+        if (_depth == 1)
+            _root_key = find_root_key(str, length);
+        if (on_path() && _path[_depth - 1].key)
+            _key_matched = (length == std::strlen(_path[_depth - 1].key) && std::memcmp(str, _path[_depth - 1].key, length) == 0);
+        return true;
+    }
+    bool StartObject()
+    {
+        return start(false);
+    }
+    bool EndObject(rapidjson::SizeType count)
+    {
+        return end(count, [&] { return _element.EndObject(count); });
+    }
+    bool StartArray()
+    {
+        return start(true);
+    }
+    bool EndArray(rapidjson::SizeType count)
+    {
+        return end(count, [&] { return _element.EndArray(count); });
+    }
+
+private:
+    enum class root_key
+    {
+        other,
+        id,
+        method,
+        params,
+        error,
+    };
+
+    static root_key find_root_key(const char* str, const size_t length)
+    {
+        if (length == 2 && std::memcmp(str, "id", 2) == 0)
+            return root_key::id;
+        if (length == 6 && std::memcmp(str, "method", 6) == 0)
+            return root_key::method;
+        if (length == 6 && std::memcmp(str, "params", 6) == 0)
+            return root_key::params;
+        if (length == 5 && std::memcmp(str, "error", 5) == 0)
+            return root_key::error;
+        return root_key::other;
+    }
+
+    //values of target array and everything below them
+    bool in_element() const
+    {
+        return _matched == _path_length + 1 && _depth >= _path_length + 1;
+    }
+
+    //current container is on path to target
+    bool on_path() const
+    {
+        return _depth >= 1 && _matched == _depth && _depth <= _path_length;
+    }
+
+    //value of current on-path container is at next path step
+    bool at_path_step()
+    {
+        const json_path_step& step = _path[_depth - 1];
+        if (_array[_depth])
+            return !step.key && step.index == _index[_depth]++;
+
+        bool matched = _key_matched;
+        _key_matched = false;
+        return step.key && matched;
+    }
+
+    //value (or value start) out of target array
+    void envelope_value()
+    {
+        if (_depth == 1)
+        {
+            if (_root_key == root_key::error)
+                _envelope.has_error = true;
+            _root_key = root_key::other;
+        }
+        else if (_depth == 2 && _in_params)
+        {
+            ++_params_index;
+        }
+    }
+
+    void capture_int(const int64_t value)
+    {
+        if (_depth == 1 && _root_key == root_key::id)
+        {
+            _envelope.has_id = true;
+            _envelope.id = value;
+        }
+        else if (_depth == 2 && _in_params && _params_index == 0)
+        {
+            _envelope.has_cookie = true;
+            _envelope.cookie = value;
+        }
+    }
+
+    template <typename AddToElement>
+    bool scalar(AddToElement&& add)
+    {
+        if (in_element())
+            return emit(add());
+
+        if (on_path() && at_path_step() && _depth == _path_length)
+            _envelope.found = true;
+        envelope_value();
+        return true;
+    }
+
+    bool start(const bool array)
+    {
+        if (in_element())
+        {
+            ++_depth;
+            return array ? _element.StartArray() : _element.StartObject();
+        }
+
+        if (_depth == 0)
+        {
+            _matched = 1;
+        }
+        else if (on_path() && at_path_step())
+        {
+            if (_depth < _path_length)
+            {
+                _matched = _depth + 1;
+            }
+            else
+            {
+                _envelope.found = true;
+                _envelope.found_array = array;
+                if (array)
+                    _matched = _depth + 1;
+            }
+        }
+
+        const bool params = _depth == 1 && _root_key == root_key::params && array;
+        envelope_value();
+
+        ++_depth;
+        if (_depth <= _path_length)
+        {
+            _array[_depth] = array;
+            _index[_depth] = 0;
+            _key_matched = false;
+        }
+        if (params)
+        {
+            _in_params = true;
+            _params_index = 0;
+        }
+        return true;
+    }
+
+    template <typename EndElement>
+    bool end(const rapidjson::SizeType count, EndElement&& end_element)
+    {
+        if (in_element() && _depth > _path_length + 1)
+        {
+            --_depth;
+            return emit(end_element());
+        }
+
+        if (_matched == _depth)
+        {
+            _envelope.path_size[_depth - 1] = count;
+            --_matched;
+        }
+        if (_depth == 2)
+            _in_params = false;
+        --_depth;
+        return true;
+    }
+
+    bool emit(bool ret)
+    {
+        if (ret && _element.complete())
+        {
+            _on_element(_element.value());
+            _element.reset();
+        }
+        return ret;
+    }
+
+    const json_path_step* _path;
+    const size_t _path_length;
+    json_value_builder& _element;
+    json_envelope& _envelope;
+    OnElement& _on_element;
+
+    size_t _depth = 0;
+    //containers at depth 1.._matched are on path to target
+    size_t _matched = 0;
+    bool _array[MAX_PATH_LENGTH + 1] = {};
+    size_t _index[MAX_PATH_LENGTH + 1] = {};
+    bool _key_matched = false;
+    root_key _root_key = root_key::other;
+    bool _in_params = false;
+    size_t _params_index = 0;
+};
+
+/* Streams elements of array at the path from document root.
+ * Members of every element are filtered by projection.
+ *
+ * Envelope is filled while streaming, so on_element sees members
+ * that precede the array (the cookie of notification for example).
+ * envelope.found is false if there is no value at the path.
+ * Throws if JSON is malformed.
+*/
+template <unsigned ParseFlags, typename Reader, typename InputStream, size_t PathLength, typename OnElement>
+void stream_json_array(Reader& reader, json_value_builder& element, InputStream& stream,
+                       const json_path_step (&path)[PathLength], const json_projection& projection,
+                       json_envelope& envelope, OnElement&& on_element)
+{
+    using handler_type = json_array_stream_handler<typename std::remove_reference<OnElement>::type>;
+    static_assert(PathLength <= handler_type::MAX_PATH_LENGTH, "Path is too long");
+
+    envelope = {};
+    handler_type handler(path, PathLength, element, envelope, on_element);
+
+    element.reset();
+    element.set_projection(projection);
+    reader.template Parse<ParseFlags>(stream, handler);
+
+    PLAYCHAIN_ASSERT_JSON(!reader.HasParseError());
+}
+
+template <unsigned ParseFlags, typename Reader, typename InputStream, size_t PathLength, typename OnElement>
+json_envelope stream_json_array(Reader& reader, json_value_builder& element, InputStream& stream,
+                                const json_path_step (&path)[PathLength], const json_projection& projection,
+                                OnElement&& on_element)
+{
+    json_envelope envelope;
+    stream_json_array<ParseFlags>(reader, element, stream, path, projection, envelope, std::forward<OnElement>(on_element));
+    return envelope;
+}
+
+} // namespace playchain
@@ -0,0 +1,434 @@
+#include <playchain/keystore.h>
+#include <playchain/playchain_helper.h>
+
+#include "playchain_defines.h"
+#include "sha256.h"
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+#if defined(PLAYCHAIN_LIB_FOR_WINDOWS)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tp {
+
+using namespace playchain;
+
+namespace {
+    /* Layout (integers are little endian):
+     *
+     * header (64 bytes): magic (8) | version (4) | count (4) | KDF iterations (4) | reserved (4)
+     *                    | salt (16) | nonce (8) | password check (16)
+     * records sorted by id (88 bytes each): id (4) | name offset (4) | name size (4)
+     *                    | public key (33) | encrypted private key with its check (36) | padding (7)
+     * numbers of records sorted by name (4 bytes each)
+     * names
+    */
+    const char keystore_magic[8] = { 'P', 'L', 'C', 'K', 'E', 'Y', 'S', '\0' };
+    const uint32_t keystore_version = 1;
+
+    const size_t header_size = 64;
+    const size_t record_size = 88;
+    const size_t salt_size = 16;
+    const size_t nonce_size = 8;
+    const size_t password_check_size = 16;
+    //private key and first 4 bytes of its SHA-256
+    const size_t secret_size = sizeof(PrivateKey) + 4;
+
+    const size_t salt_offset = 24;
+    const size_t nonce_offset = salt_offset + salt_size;
+    const size_t password_check_offset = nonce_offset + nonce_size;
+
+    const size_t public_key_offset = 12;
+    const size_t secret_offset = public_key_offset + sizeof(CompressedPublicKey);
+
+    using aes_key = std::array<uint8_t, 32>;
+
+    uint32_t read_u32(const uint8_t* p)
+    {
+        uint32_t result;
+        std::memcpy(&result, p, sizeof(result));
+        return result;
+    }
+
+    void write_u32(uint8_t* p, const uint32_t value)
+    {
+        std::memcpy(p, &value, sizeof(value));
+    }
+
+    aes_key derive_key(const std::string& password, const uint8_t* salt, const uint32_t iterations)
+    {
+        aes_key result;
+        PLAYCHAIN_ASSERT(1 == PKCS5_PBKDF2_HMAC(password.data(), (int)password.size(), salt, (int)salt_size, (int)iterations, EVP_sha256(), (int)result.size(), result.data()));
+        return result;
+    }
+
+    sha256 password_check(const aes_key& key)
+    {
+        static const char label[] = "playchain keystore";
+
+        sha256::encoder e;
+        e.write((const char*)key.data(), key.size());
+        e.write(label, sizeof(label) - 1);
+        return e.result();
+    }
+
+    //AES-256-CTR, every record has own range of 4 counter blocks
+    void crypt_secret(const aes_key& key, const uint8_t* nonce, const uint32_t number, const uint8_t* in, uint8_t* out)
+    {
+        uint8_t iv[16] = {};
+        std::memcpy(iv, nonce, nonce_size);
+        const uint64_t counter = (uint64_t)number * 4;
+        for (size_t ci = 0; ci < 8; ++ci)
+            iv[15 - ci] = (uint8_t)(counter >> (ci * 8));
+
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        PLAYCHAIN_ASSERT(ctx);
+
+        int size = 0;
+        bool ok = 1 == EVP_EncryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, key.data(), iv)
+            && 1 == EVP_EncryptUpdate(ctx, out, &size, in, (int)secret_size)
+            && size == (int)secret_size;
+        EVP_CIPHER_CTX_free(ctx);
+
+        PLAYCHAIN_ASSERT(ok, "Unable to encrypt key");
+    }
+
+    void make_secret(const PrivateKey& key, uint8_t* secret)
+    {
+        std::memcpy(secret, key.data(), key.size());
+        sha256 check = sha256::hash((const char*)key.data(), key.size());
+        std::memcpy(secret + key.size(), check.data(), secret_size - key.size());
+    }
+
+#if defined(PLAYCHAIN_LIB_FOR_WINDOWS)
+    //file is read to memory
+    class mapped_file
+    {
+    public:
+        explicit mapped_file(const std::string& path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            PLAYCHAIN_ASSERT(file, "Unable to open keystore");
+            _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        const uint8_t* data() const
+        {
+            return (const uint8_t*)_buffer.data();
+        }
+        size_t size() const
+        {
+            return _buffer.size();
+        }
+
+    private:
+        std::vector<char> _buffer;
+    };
+#else
+    class mapped_file
+    {
+    public:
+        explicit mapped_file(const std::string& path)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            PLAYCHAIN_ASSERT(fd >= 0, "Unable to open keystore");
+
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && st.st_size > 0)
+            {
+                _size = (size_t)st.st_size;
+                void* data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED)
+                    _data = (const uint8_t*)data;
+            }
+            ::close(fd);
+
+            PLAYCHAIN_ASSERT(_data, "Unable to map keystore");
+        }
+        ~mapped_file()
+        {
+            ::munmap((void*)_data, _size);
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        const uint8_t* data() const
+        {
+            return _data;
+        }
+        size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        const uint8_t* _data = nullptr;
+        size_t _size = 0;
+    };
+#endif
+} // namespace
+
+struct PlaychainKeystoreContext
+{
+    explicit PlaychainKeystoreContext(const std::string& path)
+        : file(path)
+    {
+    }
+    ~PlaychainKeystoreContext()
+    {
+        std::fill(key.begin(), key.end(), 0);
+    }
+
+    const uint8_t* record(const uint32_t number) const
+    {
+        return records + (size_t)number * record_size;
+    }
+
+    int id(const uint8_t* record) const
+    {
+        return (int)read_u32(record);
+    }
+
+    std::pair<const char*, size_t> name(const uint8_t* record) const
+    {
+        const size_t offset = read_u32(record + 4);
+        const size_t size = read_u32(record + 8);
+        PLAYCHAIN_ASSERT(offset <= names_size && size <= names_size - offset, "Corrupted keystore");
+        return { (const char*)names + offset, size };
+    }
+
+    const uint8_t* find(const PlaychainUserId& id) const
+    {
+        uint32_t from = 0, to = count;
+        while (from < to)
+        {
+            const uint32_t middle = from + (to - from) / 2;
+            const int middle_id = this->id(record(middle));
+            if (middle_id == id.instance)
+                return record(middle);
+            if (middle_id < id.instance)
+                from = middle + 1;
+            else
+                to = middle;
+        }
+        return nullptr;
+    }
+
+    const uint8_t* find(const std::string& name) const
+    {
+        uint32_t from = 0, to = count;
+        while (from < to)
+        {
+            const uint32_t middle = from + (to - from) / 2;
+            const uint32_t number = read_u32(name_index + (size_t)middle * 4);
+            PLAYCHAIN_ASSERT(number < count, "Corrupted keystore");
+
+            auto&& middle_name = this->name(record(number));
+            const int cmp = name.compare(0, name.size(), middle_name.first, middle_name.second);
+            if (cmp == 0)
+                return record(number);
+            if (cmp > 0)
+                from = middle + 1;
+            else
+                to = middle;
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<PlaychainUser> user(const uint8_t* record) const
+    {
+        if (!record)
+            return {};
+
+        const uint32_t number = (uint32_t)((record - records) / record_size);
+
+        uint8_t secret[secret_size];
+        crypt_secret(key, nonce, number, record + secret_offset, secret);
+
+        PrivateKey private_key;
+        std::memcpy(private_key.data(), secret, private_key.size());
+        uint8_t check[secret_size];
+        make_secret(private_key, check);
+        const bool valid = std::memcmp(secret, check, secret_size) == 0;
+        std::memset(secret, 0, secret_size);
+        std::memset(check, 0, secret_size);
+        PLAYCHAIN_ASSERT(valid, "Corrupted keystore");
+
+        CompressedPublicKey public_key;
+        std::memcpy(public_key.data(), record + public_key_offset, public_key.size());
+
+        auto&& name = this->name(record);
+        std::unique_ptr<PlaychainUser> result(new PlaychainUser(std::string(name.first, name.second), PlaychainUserId { id(record) }, private_key, public_key));
+        std::fill(private_key.begin(), private_key.end(), 0);
+        return result;
+    }
+
+    mapped_file file;
+    aes_key key;
+    uint8_t nonce[nonce_size];
+    uint32_t count = 0;
+    const uint8_t* records = nullptr;
+    const uint8_t* name_index = nullptr;
+    const uint8_t* names = nullptr;
+    size_t names_size = 0;
+};
+
+void PlaychainKeystore::create(const std::string& path,
+                               const std::vector<PlaychainKeystoreRecord>& records,
+                               const std::string& password,
+                               const uint32_t kdf_iterations)
+{
+    PLAYCHAIN_ASSERT(kdf_iterations > 0, "Invalid KDF iterations");
+    PLAYCHAIN_ASSERT(records.size() < std::numeric_limits<uint32_t>::max() / record_size, "Too many keys");
+
+    const uint32_t count = (uint32_t)records.size();
+
+    std::vector<std::string> wif_keys;
+    wif_keys.reserve(count);
+    for (const auto& record : records)
+        wif_keys.push_back(record.private_key_wif);
+
+    auto&& private_keys = priv_keys_from_wif(wif_keys);
+    auto&& public_keys = public_keys_from_keys(private_keys);
+
+    std::vector<uint32_t> by_id(count);
+    std::iota(by_id.begin(), by_id.end(), 0);
+    std::sort(by_id.begin(), by_id.end(), [&](const uint32_t a, const uint32_t b) {
+        return records[a].id.instance < records[b].id.instance;
+    });
+    //numbers of records in file for sorting by names
+    std::vector<uint32_t> numbers(count);
+    size_t names_size = 0;
+    for (uint32_t ci = 0; ci < count; ++ci)
+    {
+        PLAYCHAIN_ASSERT(!ci || records[by_id[ci - 1]].id.instance != records[by_id[ci]].id.instance, "Duplicate id in keystore");
+        numbers[by_id[ci]] = ci;
+        names_size += records[ci].name.size();
+    }
+    PLAYCHAIN_ASSERT(names_size < std::numeric_limits<uint32_t>::max(), "Too long names");
+
+    std::vector<uint32_t> by_name(count);
+    std::iota(by_name.begin(), by_name.end(), 0);
+    std::sort(by_name.begin(), by_name.end(), [&](const uint32_t a, const uint32_t b) {
+        return records[a].name < records[b].name;
+    });
+    for (uint32_t ci = 1; ci < count; ++ci)
+        PLAYCHAIN_ASSERT(records[by_name[ci - 1]].name != records[by_name[ci]].name, "Duplicate name in keystore");
+
+    std::vector<uint8_t> data(header_size + (size_t)count * (record_size + 4) + names_size);
+
+    uint8_t* header = data.data();
+    std::memcpy(header, keystore_magic, sizeof(keystore_magic));
+    write_u32(header + 8, keystore_version);
+    write_u32(header + 12, count);
+    write_u32(header + 16, kdf_iterations);
+    PLAYCHAIN_ASSERT(1 == RAND_bytes(header + salt_offset, (int)(salt_size + nonce_size)));
+
+    aes_key key = derive_key(password, header + salt_offset, kdf_iterations);
+    std::memcpy(header + password_check_offset, password_check(key).data(), password_check_size);
+
+    uint8_t* name_index = data.data() + header_size + (size_t)count * record_size;
+    uint8_t* names = name_index + (size_t)count * 4;
+    size_t name_offset = 0;
+    uint8_t secret[secret_size];
+    for (uint32_t ci = 0; ci < count; ++ci)
+    {
+        const auto& record = records[by_id[ci]];
+        uint8_t* p = data.data() + header_size + (size_t)ci * record_size;
+
+        write_u32(p, (uint32_t)record.id.instance);
+        write_u32(p + 4, (uint32_t)name_offset);
+        write_u32(p + 8, (uint32_t)record.name.size());
+        std::memcpy(p + public_key_offset, public_keys[by_id[ci]].data(), sizeof(CompressedPublicKey));
+
+        make_secret(private_keys[by_id[ci]], secret);
+        crypt_secret(key, header + nonce_offset, ci, secret, p + secret_offset);
+
+        std::memcpy(names + name_offset, record.name.data(), record.name.size());
+        name_offset += record.name.size();
+    }
+    for (uint32_t ci = 0; ci < count; ++ci)
+        write_u32(name_index + (size_t)ci * 4, numbers[by_name[ci]]);
+
+    std::memset(secret, 0, secret_size);
+    std::fill(key.begin(), key.end(), 0);
+    for (auto&& private_key : private_keys)
+        std::fill(private_key.begin(), private_key.end(), 0);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    PLAYCHAIN_ASSERT(file, "Unable to create keystore");
+    file.write((const char*)data.data(), (std::streamsize)data.size());
+    file.close();
+    PLAYCHAIN_ASSERT(file, "Unable to write keystore");
+}
+
+PlaychainKeystore::PlaychainKeystore(const std::string& path, const std::string& password)
+    : m_context(new PlaychainKeystoreContext(path))
+{
+    auto&& file = m_context->file;
+    const uint8_t* header = file.data();
+
+    PLAYCHAIN_ASSERT(file.size() >= header_size && std::memcmp(header, keystore_magic, sizeof(keystore_magic)) == 0, "Invalid keystore");
+    PLAYCHAIN_ASSERT(read_u32(header + 8) == keystore_version, "Unsupported keystore version");
+
+    const uint32_t count = read_u32(header + 12);
+    const size_t tables_size = (size_t)count * (record_size + 4);
+    PLAYCHAIN_ASSERT(tables_size / (record_size + 4) == count && file.size() - header_size >= tables_size, "Corrupted keystore");
+
+    const uint32_t kdf_iterations = read_u32(header + 16);
+    PLAYCHAIN_ASSERT(kdf_iterations > 0, "Corrupted keystore");
+
+    m_context->key = derive_key(password, header + salt_offset, kdf_iterations);
+    PLAYCHAIN_ASSERT(std::memcmp(password_check(m_context->key).data(), header + password_check_offset, password_check_size) == 0, "Invalid keystore password");
+
+    std::memcpy(m_context->nonce, header + nonce_offset, nonce_size);
+    m_context->count = count;
+    m_context->records = header + header_size;
+    m_context->name_index = m_context->records + (size_t)count * record_size;
+    m_context->names = m_context->name_index + (size_t)count * 4;
+    m_context->names_size = file.size() - header_size - tables_size;
+}
+
+PlaychainKeystore::~PlaychainKeystore() {}
+
+size_t PlaychainKeystore::size() const
+{
+    return m_context->count;
+}
+
+std::unique_ptr<PlaychainUser> PlaychainKeystore::findUser(const PlaychainUserId& id) const
+{
+    return m_context->user(m_context->find(id));
+}
+
+std::unique_ptr<PlaychainUser> PlaychainKeystore::findUser(const std::string& name) const
+{
+    return m_context->user(m_context->find(name));
+}
+
+bool PlaychainKeystore::findPublicKey(const PlaychainUserId& id, CompressedPublicKey& public_key) const
+{
+    const uint8_t* record = m_context->find(id);
+    if (!record)
+        return false;
+
+    std::memcpy(public_key.data(), record + public_key_offset, public_key.size());
+    return true;
+}
+
+} // namespace tp
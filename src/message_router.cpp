@@ -0,0 +1,168 @@
+#include <playchain/message_router.h>
+
+#include "playchain_defines.h"
+#include "json_message.h"
+#include "json_parse_arena.h"
+
+#include <cstring>
+
+namespace tp {
+
+using namespace playchain;
+
+namespace {
+    template <typename TJsonValue>
+    bool get_int64(const TJsonValue& js_value, int64_t& result)
+    {
+        if (!js_value.IsInt64())
+            return false;
+
+        result = js_value.GetInt64();
+        return true;
+    }
+
+    //classifies message and finds its payload
+    template <typename TJsonValue>
+    PlaychainParsedMessage classify_message(const TJsonValue& js_root, PlaychainParsedMessageContext& context)
+    {
+        using Kind = PlaychainParsedMessage::Kind;
+
+        context.root = &js_root;
+
+        if (!js_root.IsObject())
+            return {};
+
+        int64_t id = 0;
+
+        auto&& js_method = js_root.FindMember("method");
+        if (js_method != js_root.MemberEnd())
+        {
+            //{"method": "notice", "params": [identifier, [...]]}
+            const auto& method = js_method->value;
+            if (!method.IsString() || method.GetStringLength() != 6 || std::memcmp(method.GetString(), "notice", 6) != 0)
+                return {};
+
+            auto&& js_params = js_root.FindMember("params");
+            if (js_params == js_root.MemberEnd() || !js_params->value.IsArray())
+                return {};
+
+            const auto& params = js_params->value;
+            if (params.Size() != 2u || !get_int64(params[0], id))
+                return {};
+
+            context.payload = &params[1];
+            return { &context, Kind::NOTICE, id, false };
+        }
+
+        //{"id": N, "result": ...} or {"id": N, "error": ...}
+        auto&& js_id = js_root.FindMember("id");
+        if (js_id == js_root.MemberEnd() || !get_int64(js_id->value, id))
+            return {};
+
+        auto&& js_result = js_root.FindMember("result");
+        if (js_result != js_root.MemberEnd())
+            context.payload = &js_result->value;
+
+        return { &context, Kind::RESPONSE, id, context.payload == nullptr };
+    }
+} // namespace
+
+void PlaychainMessageRouter::expectResponse(const int64_t id, const Handler& handler)
+{
+    m_responses[id] = handler;
+}
+
+void PlaychainMessageRouter::cancelResponse(const int64_t id)
+{
+    m_responses.erase(id);
+}
+
+void PlaychainMessageRouter::subscribe(const int64_t identifier, const Handler& handler)
+{
+    m_subscriptions[identifier] = handler;
+}
+
+void PlaychainMessageRouter::unsubscribe(const int64_t identifier)
+{
+    m_subscriptions.erase(identifier);
+}
+
+void PlaychainMessageRouter::setDefaultHandler(const Handler& handler)
+{
+    m_default = handler;
+}
+
+void PlaychainMessageRouter::setParseArena(const std::shared_ptr<PlaychainParseArena>& arena)
+{
+    m_arena = arena;
+}
+
+PlaychainParseArena& PlaychainMessageRouter::arena() const
+{
+    if (m_arena)
+        return *m_arena;
+    return PlaychainParseArena::threadDefault();
+}
+
+bool PlaychainMessageRouter::route(const BlockchainResponseView& response)
+{
+    json_document_lease lease { arena() };
+    json_document& document = lease.document();
+    parse_document(document, response);
+
+    if (document.HasParseError())
+        return dispatch({});
+
+    if (!document.IsArray())
+    {
+        PlaychainParsedMessageContext context;
+        return dispatch(classify_message(document, context));
+    }
+
+    //batch response, elements are dispatched in order they were received
+    if (document.Empty())
+        return dispatch({});
+
+    bool result = true;
+    for (const auto& js_element : document.GetArray())
+    {
+        PlaychainParsedMessageContext context;
+        result = dispatch(classify_message(js_element, context)) && result;
+    }
+    return result;
+}
+
+bool PlaychainMessageRouter::dispatch(const PlaychainParsedMessage& message)
+{
+    using Kind = PlaychainParsedMessage::Kind;
+
+    Handler handler;
+    if (message.kind() == Kind::RESPONSE)
+    {
+        //one-shot handler is removed before call, so it may expect the next response
+        auto&& it = m_responses.find(message.id());
+        if (it != m_responses.end())
+        {
+            handler = std::move(it->second);
+            m_responses.erase(it);
+        }
+    }
+    else if (message.kind() == Kind::NOTICE)
+    {
+        auto&& it = m_subscriptions.find(message.id());
+        if (it != m_subscriptions.end())
+            handler = it->second;
+    }
+
+    if (handler)
+    {
+        handler(message);
+        return true;
+    }
+
+    if (m_default)
+        m_default(message);
+    return false;
+}
+
+} // namespace tp
@@ -0,0 +1,363 @@
+#include <playchain/metrics.h>
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#if defined(PLAYCHAIN_METRICS)
+namespace playchain {
+namespace metrics {
+
+namespace {
+    using tp::PlaychainMethodMetrics;
+
+    const size_t max_methods = 256;
+    const size_t latency_buckets = PlaychainMethodMetrics::LATENCY_BUCKETS;
+
+    //bit length of latency
+    size_t latency_bucket(uint64_t ns)
+    {
+        size_t result = 0;
+#if defined(__GNUC__)
+        if (ns)
+            result = 64 - (size_t)__builtin_clzll(ns);
+#else
+        for (; ns; ns >>= 1)
+            ++result;
+#endif
+        return std::min(result, latency_buckets - 1);
+    }
+
+    struct totals
+    {
+        uint64_t calls = 0;
+        uint64_t failures = 0;
+        uint64_t bytes = 0;
+        uint64_t latency = 0;
+        uint64_t buckets[latency_buckets] = {};
+    };
+
+    //written only by own thread, so updates are not atomic RMW
+    struct counters
+    {
+        std::atomic<uint64_t> calls { 0 };
+        std::atomic<uint64_t> failures { 0 };
+        std::atomic<uint64_t> bytes { 0 };
+        std::atomic<uint64_t> latency { 0 };
+        std::atomic<uint64_t> buckets[latency_buckets];
+
+        counters()
+        {
+            for (auto&& bucket : buckets)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+
+        static void add(std::atomic<uint64_t>& counter, const uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void merge_to(totals& result) const
+        {
+            result.calls += calls.load(std::memory_order_relaxed);
+            result.failures += failures.load(std::memory_order_relaxed);
+            result.bytes += bytes.load(std::memory_order_relaxed);
+            result.latency += latency.load(std::memory_order_relaxed);
+            for (size_t ci = 0; ci < latency_buckets; ++ci)
+                result.buckets[ci] += buckets[ci].load(std::memory_order_relaxed);
+        }
+    };
+
+    struct thread_counters
+    {
+        counters methods[max_methods];
+    };
+
+    struct registry
+    {
+        std::mutex lock;
+
+        const char* categories[max_methods] = {};
+        const char* names[max_methods] = {};
+        size_t methods = 0;
+
+        std::vector<thread_counters*> threads;
+        //counters of finished threads
+        std::vector<totals> retired = std::vector<totals>(max_methods);
+        //counters at last reset
+        std::vector<totals> baseline = std::vector<totals>(max_methods);
+
+        void merge(std::vector<totals>& result) const
+        {
+            result = retired;
+            for (auto&& thread : threads)
+            {
+                for (size_t ci = 0; ci < methods; ++ci)
+                    thread->methods[ci].merge_to(result[ci]);
+            }
+        }
+    };
+
+    //never destroyed, threads can finish after static destructors
+    registry& get_registry()
+    {
+        static registry* result = new registry;
+        return *result;
+    }
+
+    //counters are allocated by the first instrumented call of thread,
+    //other threads do not pay for them
+    struct thread_registration
+    {
+        thread_registration()
+            : data(new thread_counters)
+        {
+            auto&& r = get_registry();
+            std::unique_lock<std::mutex> lck(r.lock);
+            r.threads.push_back(data.get());
+        }
+        ~thread_registration()
+        {
+            auto&& r = get_registry();
+            std::unique_lock<std::mutex> lck(r.lock);
+            r.threads.erase(std::remove(r.threads.begin(), r.threads.end(), data.get()), r.threads.end());
+            for (size_t ci = 0; ci < r.methods; ++ci)
+                data->methods[ci].merge_to(r.retired[ci]);
+        }
+
+        std::unique_ptr<thread_counters> data;
+    };
+
+    thread_counters& this_thread_counters()
+    {
+        static thread_local thread_registration registration;
+        return *registration.data;
+    }
+
+    thread_local scope* current_scope = nullptr;
+    //calls of thread left to the next latency sample
+    thread_local size_t latency_countdown = 0;
+
+    std::atomic<size_t> latency_sampling { tp::PlaychainMetrics::DEFAULT_LATENCY_SAMPLING };
+
+    size_t register_method(const char* category, const char* name)
+    {
+        auto&& r = get_registry();
+        std::unique_lock<std::mutex> lck(r.lock);
+
+        //overloads are counted together
+        for (size_t ci = 0; ci < r.methods; ++ci)
+        {
+            if (!std::strcmp(r.names[ci], name) && !std::strcmp(r.categories[ci], category))
+                return ci;
+        }
+
+        //methods over limit are not counted
+        if (r.methods == max_methods)
+            return max_methods;
+
+        r.categories[r.methods] = category;
+        r.names[r.methods] = name;
+        return r.methods++;
+    }
+} // namespace
+
+method::method(const char* category, const char* name)
+    : id(register_method(category, name))
+{
+}
+
+scope::scope(const method& m, const size_t bytes)
+    : _id(m.id)
+    , _bytes(bytes)
+{
+    if (_id == max_methods || (current_scope && current_scope->_id == _id))
+        return;
+
+    _active = true;
+    _parent = current_scope;
+    current_scope = this;
+
+    //countdown left by previous larger sampling is restarted,
+    //so the next call is timed after sampling is changed
+    const size_t sampling = latency_sampling.load(std::memory_order_relaxed);
+    if (latency_countdown >= sampling)
+        latency_countdown = 0;
+
+    if (!latency_countdown)
+    {
+        latency_countdown = sampling;
+        _timed = true;
+        _start = std::chrono::steady_clock::now();
+    }
+    --latency_countdown;
+}
+
+scope::~scope()
+{
+    if (!_active)
+        return;
+
+    current_scope = _parent;
+
+    counters& c = this_thread_counters().methods[_id];
+    counters::add(c.calls, 1);
+    if (_failed)
+        counters::add(c.failures, 1);
+    if (_bytes)
+        counters::add(c.bytes, _bytes);
+    if (_timed)
+    {
+        const uint64_t latency = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+
+        counters::add(c.latency, latency);
+        counters::add(c.buckets[latency_bucket(latency)], 1);
+    }
+}
+
+scope* scope::current()
+{
+    return current_scope;
+}
+
+std::vector<PlaychainMethodMetrics> snapshot()
+{
+    auto&& r = get_registry();
+
+    std::vector<totals> merged;
+    std::vector<PlaychainMethodMetrics> result;
+
+    std::unique_lock<std::mutex> lck(r.lock);
+
+    r.merge(merged);
+
+    for (size_t ci = 0; ci < r.methods; ++ci)
+    {
+        const totals& from = merged[ci];
+        const totals& base = r.baseline[ci];
+        if (from.calls == base.calls)
+            continue;
+
+        PlaychainMethodMetrics item;
+        item.category = r.categories[ci];
+        item.method = r.names[ci];
+        item.calls = from.calls - base.calls;
+        item.failures = from.failures - base.failures;
+        item.bytes = from.bytes - base.bytes;
+        item.total_latency = std::chrono::nanoseconds(from.latency - base.latency);
+        for (size_t bi = 0; bi < latency_buckets; ++bi)
+        {
+            item.latency_histogram[bi] = from.buckets[bi] - base.buckets[bi];
+            item.latency_samples += item.latency_histogram[bi];
+        }
+        result.push_back(std::move(item));
+    }
+
+    return result;
+}
+
+void reset()
+{
+    auto&& r = get_registry();
+    std::unique_lock<std::mutex> lck(r.lock);
+
+    r.merge(r.baseline);
+}
+
+void set_latency_sampling(const size_t every_nth_call)
+{
+    latency_sampling = std::max<size_t>(every_nth_call, 1);
+}
+
+} // namespace metrics
+} // namespace playchain
+#endif //PLAYCHAIN_METRICS
+
+namespace tp {
+
+bool PlaychainMetrics::enabled()
+{
+#if defined(PLAYCHAIN_METRICS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<PlaychainMethodMetrics> PlaychainMetrics::snapshot()
+{
+#if defined(PLAYCHAIN_METRICS)
+    return playchain::metrics::snapshot();
+#else
+    return {};
+#endif
+}
+
+void PlaychainMetrics::reset()
+{
+#if defined(PLAYCHAIN_METRICS)
+    playchain::metrics::reset();
+#endif
+}
+
+void PlaychainMetrics::setLatencySampling(const size_t every_nth_call)
+{
+#if defined(PLAYCHAIN_METRICS)
+    playchain::metrics::set_latency_sampling(every_nth_call);
+#else
+    (void)every_nth_call;
+#endif
+}
+
+std::string PlaychainMetrics::toPrometheus(const std::vector<PlaychainMethodMetrics>& metrics)
+{
+    std::stringstream ss;
+
+    auto labels = [&ss](const PlaychainMethodMetrics& item) -> std::stringstream& {
+        ss << "category=\"" << item.category << "\",method=\"" << item.method << '"';
+        return ss;
+    };
+
+    auto counter = [&](const char* name, const char* help, uint64_t PlaychainMethodMetrics::*field) {
+        ss << "# HELP " << name << ' ' << help << '\n'
+           << "# TYPE " << name << " counter\n";
+        for (auto&& item : metrics)
+        {
+            ss << name << '{';
+            labels(item) << "} " << item.*field << '\n';
+        }
+    };
+
+    counter("playchain_calls_total", "Calls of instrumented methods.", &PlaychainMethodMetrics::calls);
+    counter("playchain_failures_total", "Failed calls of instrumented methods.", &PlaychainMethodMetrics::failures);
+    counter("playchain_bytes_total", "Bytes produced or consumed by instrumented methods.", &PlaychainMethodMetrics::bytes);
+
+    ss << "# HELP playchain_latency_seconds Sampled latency of instrumented methods.\n"
+       << "# TYPE playchain_latency_seconds histogram\n";
+    for (auto&& item : metrics)
+    {
+        uint64_t cumulative = 0;
+        for (size_t ci = 0; ci + 1 < item.latency_histogram.size(); ++ci)
+        {
+            cumulative += item.latency_histogram[ci];
+            ss << "playchain_latency_seconds_bucket{";
+            labels(item) << ",le=\"" << std::ldexp(1.0, (int)ci) * 1e-9 << "\"} " << cumulative << '\n';
+        }
+        ss << "playchain_latency_seconds_bucket{";
+        labels(item) << ",le=\"+Inf\"} " << item.latency_samples << '\n';
+        ss << "playchain_latency_seconds_sum{";
+        labels(item) << "} " << std::chrono::duration<double>(item.total_latency).count() << '\n';
+        ss << "playchain_latency_seconds_count{";
+        labels(item) << "} " << item.latency_samples << '\n';
+    }
+
+    return ss.str();
+}
+
+} // namespace tp
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <playchain/metrics.h>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+//Instrumentation of hot methods (see include/playchain/metrics.h).
+//Macros are empty if library is built without PLAYCHAIN_METRICS.
+
+#if defined(PLAYCHAIN_METRICS)
+namespace playchain {
+namespace metrics {
+
+    //registered by the first call of method
+    struct method
+    {
+        method(const char* category, const char* name);
+
+        const size_t id;
+    };
+
+    //counts call of method, overloads calling each other are counted once
+    class scope
+    {
+    public:
+        explicit scope(const method& m, const size_t bytes = 0);
+        ~scope();
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+        void add_bytes(const size_t bytes)
+        {
+            _bytes += bytes;
+        }
+        void fail()
+        {
+            _failed = true;
+        }
+
+        //the innermost active scope of thread
+        static scope* current();
+
+    private:
+        const size_t _id;
+        bool _active = false;
+        bool _timed = false;
+        bool _failed = false;
+        size_t _bytes = 0;
+        scope* _parent = nullptr;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    inline void add_bytes(const size_t bytes)
+    {
+        if (scope* s = scope::current())
+            s->add_bytes(bytes);
+    }
+
+    inline void fail()
+    {
+        if (scope* s = scope::current())
+            s->fail();
+    }
+
+    //counters of all threads since the last reset
+    std::vector<tp::PlaychainMethodMetrics> snapshot();
+    void reset();
+    void set_latency_sampling(const size_t every_nth_call);
+} // namespace metrics
+} // namespace playchain
+
+#define PLAYCHAIN_METRICS_SCOPE_BYTES(CATEGORY, BYTES)                                         \
+    static const playchain::metrics::method playchain_metrics_method { CATEGORY, __func__ }; \
+    playchain::metrics::scope playchain_metrics_scope { playchain_metrics_method, BYTES }
+
+#define PLAYCHAIN_METRICS_BYTES(BYTES) playchain::metrics::add_bytes(BYTES)
+#define PLAYCHAIN_METRICS_FAILURE() playchain::metrics::fail()
+#else
+#define PLAYCHAIN_METRICS_SCOPE_BYTES(CATEGORY, BYTES)
+#define PLAYCHAIN_METRICS_BYTES(BYTES) ((void)0)
+#define PLAYCHAIN_METRICS_FAILURE() ((void)0)
+#endif //!PLAYCHAIN_METRICS
+
+#define PLAYCHAIN_METRICS_SCOPE(CATEGORY) PLAYCHAIN_METRICS_SCOPE_BYTES(CATEGORY, 0)
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/* Allocation free conversions of numbers and object ids ("1.2.10").
+ *
+ * Formatters write to caller buffer without terminating zero
+ * and return number of written characters.
+ * Parsers accept exactly [begin, end) and return false for any error
+ * (empty input, sign, spaces, non digit characters, overflow).
+*/
+
+namespace playchain {
+
+//digits of uint64_t max
+constexpr size_t uint64_max_chars = 20;
+//sign and digits of int64_t min
+constexpr size_t int64_max_chars = 20;
+//"space.type.instance" of 32-bit space, type and 64-bit instance
+constexpr size_t object_id_max_chars = 10 + 1 + 10 + 1 + int64_max_chars;
+
+namespace detail {
+    constexpr char digit_pairs[] = "00010203040506070809"
+                                   "10111213141516171819"
+                                   "20212223242526272829"
+                                   "30313233343536373839"
+                                   "40414243444546474849"
+                                   "50515253545556575859"
+                                   "60616263646566676869"
+                                   "70717273747576777879"
+                                   "80818283848586878889"
+                                   "90919293949596979899";
+} // namespace detail
+
+inline size_t format_uint64(uint64_t value, char* out)
+{
+    char buff[uint64_max_chars];
+    char* pos = buff + uint64_max_chars;
+
+    //two digits per division
+    while (value >= 100)
+    {
+        const size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        *--pos = detail::digit_pairs[pair + 1];
+        *--pos = detail::digit_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        const size_t pair = (size_t)value * 2;
+        *--pos = detail::digit_pairs[pair + 1];
+        *--pos = detail::digit_pairs[pair];
+    }
+    else
+    {
+        *--pos = (char)('0' + value);
+    }
+
+    const size_t size = (size_t)(buff + uint64_max_chars - pos);
+    std::memcpy(out, pos, size);
+    return size;
+}
+
+inline size_t format_int64(const int64_t value, char* out)
+{
+    if (value >= 0)
+        return format_uint64((uint64_t)value, out);
+
+    *out = '-';
+    //two's complement negation that is valid for int64_t min
+    return 1 + format_uint64(~(uint64_t)value + 1, out + 1);
+}
+
+inline bool parse_uint64(const char* begin, const char* end, uint64_t& result)
+{
+    if (begin == end || (size_t)(end - begin) > uint64_max_chars)
+        return false;
+
+    uint64_t value = 0;
+    for (const char* pos = begin; pos != end; ++pos)
+    {
+        const unsigned digit = (unsigned)(unsigned char)*pos - '0';
+        if (digit > 9)
+            return false;
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+            return false;
+        value = value * 10 + digit;
+    }
+
+    result = value;
+    return true;
+}
+
+inline bool parse_uint64(const char* str, uint64_t& result)
+{
+    return parse_uint64(str, str + std::strlen(str), result);
+}
+
+inline size_t format_object_id(const uint32_t space_id, const uint32_t type_id, const int64_t instance, char* out)
+{
+    size_t size = format_uint64(space_id, out);
+    out[size++] = '.';
+    size += format_uint64(type_id, out + size);
+    out[size++] = '.';
+    size += format_int64(instance, out + size);
+    return size;
+}
+
+//"space.type.instance" of non-negative numbers
+inline bool parse_object_id(const char* begin, const char* end, uint64_t& space_id, uint64_t& type_id, uint64_t& instance)
+{
+    if (begin == end)
+        return false;
+
+    const char* first_dot = static_cast<const char*>(std::memchr(begin, '.', (size_t)(end - begin)));
+    if (!first_dot)
+        return false;
+    const char* second_dot = static_cast<const char*>(std::memchr(first_dot + 1, '.', (size_t)(end - first_dot - 1)));
+    if (!second_dot)
+        return false;
+
+    return parse_uint64(begin, first_dot, space_id) && parse_uint64(first_dot + 1, second_dot, type_id)
+        && parse_uint64(second_dot + 1, end, instance);
+}
+
+} // namespace playchain
@@ -2,6 +2,7 @@
 
 #include "playchain_internal_types.h"
 #include "convert_helper.h"
+#include "number_codec.h"
 
 #include <cassert>
 #include <vector>
@@ -77,46 +78,47 @@ inline void pack(json_stream& s, const char* v, uint32_t depth = PACK_MAX_DEPTH)
     s.String(v);
 }
 
-inline void pack(json_stream& s, const account_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
+template <typename Id>
+inline void pack_object_id(json_stream& s, const Id& v, uint32_t depth = PACK_MAX_DEPTH)
 {
     assert(depth > 0);
-    pack(s, (std::string)v, depth - 1);
+    char buff[object_id_max_chars];
+    s.String(buff, (rapidjson::SizeType)format_object_id(v.space_id, v.type_id, v.instance, buff));
+}
+
+inline void pack(json_stream& s, const account_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
+{
+    pack_object_id(s, v, depth);
 }
 
 inline void pack(json_stream& s, const witness_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
 {
-    assert(depth > 0);
-    pack(s, (std::string)v, depth - 1);
+    pack_object_id(s, v, depth);
 }
 
 inline void pack(json_stream& s, const asset_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
 {
-    assert(depth > 0);
-    pack(s, (std::string)v, depth - 1);
+    pack_object_id(s, v, depth);
 }
 
 inline void pack(json_stream& s, const room_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
 {
-    assert(depth > 0);
-    pack(s, (std::string)v, depth - 1);
+    pack_object_id(s, v, depth);
 }
 
 inline void pack(json_stream& s, const table_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
 {
-    assert(depth > 0);
-    pack(s, (std::string)v, depth - 1);
+    pack_object_id(s, v, depth);
 }
 
 inline void pack(json_stream& s, const vesting_balance_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
 {
-    assert(depth > 0);
-    pack(s, (std::string)v, depth - 1);
+    pack_object_id(s, v, depth);
 }
 
 inline void pack(json_stream& s, const pending_buy_in_id_type& v, uint32_t depth = PACK_MAX_DEPTH)
 {
-    assert(depth > 0);
-    pack(s, (std::string)v, depth - 1);
+    pack_object_id(s, v, depth);
 }
 
 template <typename T, size_t N>
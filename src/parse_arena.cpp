@@ -0,0 +1,164 @@
+#include "json_parse_arena.h"
+
+#include <algorithm>
+
+namespace tp {
+
+using namespace playchain;
+
+PlaychainParseArenaContext::PlaychainParseArenaContext(const size_t capacity)
+    : document_values(capacity)
+    , document_stack(capacity / 8)
+    , reader_stack(capacity / 8)
+    , element(capacity / 8)
+{
+    reset_document();
+}
+
+json_document* PlaychainParseArenaContext::acquire_document()
+{
+    if (document_busy)
+    {
+        ++fallbacks;
+        return nullptr;
+    }
+
+    document_busy = true;
+    return document.get();
+}
+
+void PlaychainParseArenaContext::release_document()
+{
+    document->SetNull();
+
+    size_t values_used = 0, stack_used = 0;
+    bool overflow = document_values.reset(values_used);
+    overflow = document_stack.reset(stack_used) || overflow;
+
+    //document refers to recreated allocators
+    if (overflow)
+        reset_document();
+
+    update_stats(values_used + stack_used, overflow);
+
+    document_busy = false;
+}
+
+bool PlaychainParseArenaContext::acquire_stream()
+{
+    if (stream_busy)
+    {
+        ++fallbacks;
+        return false;
+    }
+
+    stream_busy = true;
+    stream_element_overflows = element.pool().overflows();
+    return true;
+}
+
+void PlaychainParseArenaContext::release_stream()
+{
+    element.reset();
+
+    size_t stack_used = 0;
+    bool overflow = reader_stack.reset(stack_used);
+    overflow = overflow || element.pool().overflows() != stream_element_overflows;
+
+    update_stats(stack_used + element.pool().high_water_mark(), overflow);
+
+    stream_busy = false;
+}
+
+PlaychainParseArenaStats PlaychainParseArenaContext::stats() const
+{
+    PlaychainParseArenaStats result;
+
+    result.capacity = document_values.capacity() + document_stack.capacity() + reader_stack.capacity() + element.pool().capacity();
+    result.high_water_mark = high_water_mark;
+    result.parses = parses;
+    result.overflows = overflows;
+    result.fallbacks = fallbacks;
+
+    return result;
+}
+
+void PlaychainParseArenaContext::reset_document()
+{
+    document.reset(new json_document(&document_values.allocator(),
+                                     1024u,
+                                     &document_stack.allocator()));
+}
+
+void PlaychainParseArenaContext::update_stats(const size_t used, const bool overflow)
+{
+    high_water_mark = std::max(high_water_mark, used);
+    ++parses;
+    if (overflow)
+        ++overflows;
+}
+
+PlaychainParseArena::PlaychainParseArena(const size_t initial_capacity)
+    : m_context(new PlaychainParseArenaContext(initial_capacity))
+{
+}
+
+PlaychainParseArena::~PlaychainParseArena() {}
+
+PlaychainParseArenaStats PlaychainParseArena::stats() const
+{
+    return m_context->stats();
+}
+
+PlaychainParseArena& PlaychainParseArena::threadDefault()
+{
+    static thread_local PlaychainParseArena arena;
+    return arena;
+}
+
+} // namespace tp
+
+namespace playchain {
+
+json_document_lease::json_document_lease(tp::PlaychainParseArena& arena)
+{
+    _document = arena.context().acquire_document();
+    if (_document)
+    {
+        _arena = &arena.context();
+    }
+    else
+    {
+        _own.reset(new json_document());
+        _document = _own.get();
+    }
+}
+
+json_document_lease::~json_document_lease()
+{
+    if (_arena)
+        _arena->release_document();
+}
+
+json_stream_lease::json_stream_lease(tp::PlaychainParseArena& arena)
+    : _arena(arena.context().acquire_stream() ? &arena.context() : nullptr)
+    , _reader(_arena ? &_arena->reader_stack.allocator() : nullptr)
+{
+    if (_arena)
+    {
+        _element = &_arena->element;
+    }
+    else
+    {
+        _own.reset(new json_value_builder());
+        _element = _own.get();
+    }
+}
+
+json_stream_lease::~json_stream_lease()
+{
+    if (_arena)
+        _arena->release_stream();
+}
+
+} // namespace playchain
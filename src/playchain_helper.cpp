@@ -1,10 +1,12 @@
 #include <playchain/playchain_helper.h>
 #include <playchain/playchain_settings.h>
+#include <playchain/public_key_cache.h>
 
 #include "convert_helper.h"
 
 #ifdef SECP256K1
 #include <secp256k1.h>
+#include <secp256k1_recovery.h>
 #endif
 #include "sha256.h"
 #include "datastream.h"
@@ -12,8 +14,12 @@
 #include "base58.h"
 #include "ripemd160.h"
 #include "sha512.h"
+#include "metrics.h"
+#include "tracing.h"
 
-#include <rapidjson/document.h>
+#include "json_backend.h"
+
+#include <cctype>
 
 namespace tp {
 using namespace playchain;
@@ -83,6 +89,12 @@ namespace {
         return secp256k1_nonce_function_default(nonce32, msg32, key32, algo16, data, attempt);
     }
 
+    //checksum of WIF is the first 4 bytes of single or double SHA-256
+    void check_wif_checksum(const std::vector<char>& wif_bytes, const sha256& check, const sha256& check2)
+    {
+        PLAYCHAIN_ASSERT(memcmp((char*)&check, wif_bytes.data() + wif_bytes.size() - 4, 4) == 0 || memcmp((char*)&check2, wif_bytes.data() + wif_bytes.size() - 4, 4) == 0);
+    }
+
     bool is_canonical(const CompactSignature& c)
     {
         return !(c[1] & 0x80) && !(c[1] == 0 && !(c[2] & 0x80)) && !(c[33] & 0x80) && !(c[33] == 0 && !(c[34] & 0x80));
@@ -116,7 +128,7 @@ std::string priv_key_to_wif(const PrivateKey& key)
     sha256 digest = sha256::hash(data, size_of_data_to_hash);
     digest = sha256::hash(digest);
     memcpy(data + size_of_data_to_hash, (char*)&digest, size_of_hash_bytes);
-    return to_base58(data, sizeof(data));
+    return to_base58_ct(data, sizeof(data));
 }
 
 PrivateKey priv_key_from_wif(const std::string& wif_key)
@@ -124,7 +136,7 @@ PrivateKey priv_key_from_wif(const std::string& wif_key)
     PrivateKey result;
     std::vector<char> wif_bytes;
 
-    wif_bytes = from_base58(wif_key);
+    wif_bytes = from_base58_ct(wif_key);
 
     PLAYCHAIN_ASSERT(wif_bytes.size() >= 5, "Invalid WIF format");
 
@@ -141,12 +153,71 @@ PrivateKey priv_key_from_wif(const std::string& wif_key)
     sha256 check = sha256::hash(wif_bytes.data(), wif_bytes.size() - 4);
     sha256 check2 = sha256::hash(check);
 
-    PLAYCHAIN_ASSERT(memcmp((char*)&check, wif_bytes.data() + wif_bytes.size() - 4, 4) == 0 || memcmp((char*)&check2, wif_bytes.data() + wif_bytes.size() - 4, 4) == 0);
+    check_wif_checksum(wif_bytes, check, check2);
 
     return result;
 }
 
+std::vector<PrivateKey> priv_keys_from_wif(const std::vector<std::string>& wif_keys)
+{
+    const size_t count = wif_keys.size();
+
+    std::vector<std::vector<char>> wif_bytes;
+    wif_bytes.reserve(count);
+    for (const auto& wif_key : wif_keys)
+    {
+        wif_bytes.push_back(from_base58_ct(wif_key));
+        PLAYCHAIN_ASSERT(wif_bytes.back().size() >= 1 + sizeof(PrivateKey) + 4, "Invalid WIF format");
+    }
+
+    //checksums of all keys at once, single and double SHA-256
+    std::vector<const char*> data(count);
+    std::vector<size_t> sizes(count);
+    for (size_t ci = 0; ci < count; ++ci)
+    {
+        data[ci] = wif_bytes[ci].data();
+        sizes[ci] = wif_bytes[ci].size() - 4;
+    }
+    std::vector<sha256> checks(count);
+    sha256::hash_batch(data.data(), sizes.data(), count, checks.data());
+
+    for (size_t ci = 0; ci < count; ++ci)
+    {
+        data[ci] = checks[ci].data();
+        sizes[ci] = checks[ci].data_size();
+    }
+    std::vector<sha256> checks2(count);
+    sha256::hash_batch(data.data(), sizes.data(), count, checks2.data());
+
+    std::vector<PrivateKey> result(count);
+    for (size_t ci = 0; ci < count; ++ci)
+    {
+        check_wif_checksum(wif_bytes[ci], checks[ci], checks2[ci]);
+        std::memcpy(result[ci].data(), wif_bytes[ci].data() + 1, result[ci].size());
+    }
+    return result;
+}
+
 #ifdef SECP256K1
+namespace {
+    CompressedPublicKey public_key_from_key(secp256k1_context* context, const PrivateKey& key)
+    {
+        CompressedPublicKey result;
+
+        secp256k1_pubkey pub_key_xy;
+
+        PLAYCHAIN_ASSERT(1 == secp256k1_ec_pubkey_create(context, &pub_key_xy, (unsigned char*)key.data()));
+
+        size_t pk_len = result.size();
+
+        PLAYCHAIN_ASSERT(1 == secp256k1_ec_pubkey_serialize(context, (unsigned char*)result.data(), &pk_len, &pub_key_xy, SECP256K1_EC_COMPRESSED));
+
+        PLAYCHAIN_ASSERT(pk_len == result.size());
+
+        return result;
+    }
+} // namespace
+
 CompressedPublicKey public_key_from_key(const PrivateKey& key)
 {
     secp256k1_context* _context = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY | SECP256K1_CONTEXT_SIGN);
@@ -155,17 +226,36 @@ CompressedPublicKey public_key_from_key(const PrivateKey& key)
 
     try
     {
-        CompressedPublicKey result;
+        CompressedPublicKey result = public_key_from_key(_context, key);
 
-        secp256k1_pubkey pub_key_xy;
+        secp256k1_context_destroy(_context);
 
-        PLAYCHAIN_ASSERT(1 == secp256k1_ec_pubkey_create(_context, &pub_key_xy, (unsigned char*)key.data()));
+        return result;
+    }
+    catch (const std::logic_error&)
+    {
+        secp256k1_context_destroy(_context);
 
-        size_t pk_len = result.size();
+        throw;
+    }
 
-        PLAYCHAIN_ASSERT(1 == secp256k1_ec_pubkey_serialize(_context, (unsigned char*)result.data(), &pk_len, &pub_key_xy, SECP256K1_EC_COMPRESSED));
+    return {};
+}
 
-        PLAYCHAIN_ASSERT(pk_len == result.size());
+std::vector<CompressedPublicKey> public_keys_from_keys(const std::vector<PrivateKey>& keys)
+{
+    //context creation (precomputed tables) costs more than key derivation
+    secp256k1_context* _context = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+
+    PLAYCHAIN_ASSERT(_context);
+
+    try
+    {
+        std::vector<CompressedPublicKey> result;
+        result.reserve(keys.size());
+
+        for (const auto& key : keys)
+            result.push_back(public_key_from_key(_context, key));
 
         secp256k1_context_destroy(_context);
 
@@ -186,6 +276,12 @@ CompressedPublicKey public_key_from_key(const PrivateKey& key)
     PLAYCHAIN_ERROR("Required SECP256K1 lib");
     return {};
 }
+
+std::vector<CompressedPublicKey> public_keys_from_keys(const std::vector<PrivateKey>& keys)
+{
+    PLAYCHAIN_ERROR("Required SECP256K1 lib");
+    return {};
+}
 #endif //!SECP256K1
 
 CompressedPublicKey public_key_from_string(const std::string& formatted_key)
@@ -195,6 +291,10 @@ CompressedPublicKey public_key_from_string(const std::string& formatted_key)
     std::string prefix(PLAYCHAIN_ADDRESS_PREFIX);
     if (formatted_key.substr(0, prefix.size()) == prefix)
     {
+        auto& cache = PlaychainPublicKeyCache::instance();
+        if (cache.find(formatted_key, result))
+            return result;
+
         const size_t prefix_len = prefix.size();
         PLAYCHAIN_ASSERT(formatted_key.size() > prefix_len);
         PLAYCHAIN_ASSERT(formatted_key.substr(0, prefix_len) == prefix);
@@ -206,6 +306,11 @@ CompressedPublicKey public_key_from_string(const std::string& formatted_key)
         std::memcpy(result.data(), (const uint8_t*)bin_key.data.data(), result.size());
         PLAYCHAIN_ASSERT(ripemd160::hash((const char*)result.data(), result.size())._hash[0] == bin_key.check);
 
+        //decoder skips spaces and unpack ignores trailing bytes,
+        //so only re-encoded key is its string
+        auto data = pack(bin_key);
+        cache.insert(result, PLAYCHAIN_ADDRESS_PREFIX + to_base58(data.data(), data.size()));
+
         return result;
     }
 
@@ -220,9 +325,18 @@ std::string public_key_to_string(const CompressedPublicKey& pub_key, bool wellfo
     std::memcpy(k.data.data(), (const char*)pub_key.data(), pub_key.size());
     if (wellformatted)
     {
+        auto& cache = PlaychainPublicKeyCache::instance();
+        std::string result;
+        if (cache.find(pub_key, result))
+            return result;
+
         k.check = ripemd160::hash((const char*)k.data.data(), k.data.size())._hash[0];
         auto data = pack(k);
-        return PLAYCHAIN_ADDRESS_PREFIX + to_base58(data.data(), data.size());
+        result = PLAYCHAIN_ADDRESS_PREFIX + to_base58(data.data(), data.size());
+
+        cache.insert(pub_key, result);
+
+        return result;
     }
 
     return to_hex(k.data.data(), k.data.size());
@@ -270,13 +384,8 @@ CompactSignature convert_signature(const std::string& hex_sign)
 }
 
 #ifdef SECP256K1
-CompactSignature sign_digest(const Digest& digest, const PrivateKey& key, bool check_canonical)
-{
-    secp256k1_context* _context = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY | SECP256K1_CONTEXT_SIGN);
-
-    PLAYCHAIN_ASSERT(_context);
-
-    try
+namespace {
+    CompactSignature sign_digest(secp256k1_context* context, const Digest& digest, const PrivateKey& key, bool check_canonical)
     {
         CompactSignature sign;
 
@@ -293,21 +402,77 @@ CompactSignature sign_digest(const Digest& digest, const PrivateKey& key, bool c
         do
         {
 #if defined(SECP256K1_EXT)
-            PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_sign(_context, &_signature, (unsigned char*)digest.data(), key.data(), extended_nonce_function, &counter, &recid));
+            PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_sign(context, &_signature, (unsigned char*)digest.data(), key.data(), extended_nonce_function, &counter, &recid));
 #else
-            PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_sign(_context, &_signature, (unsigned char*)digest.data(), key.data(), extended_nonce_function, &recid));
+            PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_sign(context, &_signature, (unsigned char*)digest.data(), key.data(), extended_nonce_function, &recid));
 #endif
-            PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_signature_serialize_compact(_context, &sign[1], &_signature));
+            PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_signature_serialize_compact(context, &sign[1], &_signature));
         } while (check_canonical && !is_canonical(sign));
 
         sign[0] = static_cast<uint8_t>(27 + 4 + recid);
 
+        return sign;
+    }
+} // namespace
+
+CompactSignature sign_digest(const Digest& digest, const PrivateKey& key, bool check_canonical)
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("signer", digest.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(SIGN, digest.size());
+    if (playchain_trace_span.traced())
+        PLAYCHAIN_TRACE_DIGEST(playchain::to_hex(digest));
+
+    secp256k1_context* _context = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY | SECP256K1_CONTEXT_SIGN);
+
+    PLAYCHAIN_ASSERT(_context);
+
+    try
+    {
+        CompactSignature sign = sign_digest(_context, digest, key, check_canonical);
+
         secp256k1_context_destroy(_context);
 
         return sign;
     }
     catch (const std::logic_error&)
     {
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+
+        secp256k1_context_destroy(_context);
+
+        throw;
+    }
+
+    return {};
+}
+
+std::vector<CompactSignature> sign_digests(const std::vector<Digest>& digests, const PrivateKey& key, bool check_canonical)
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("signer", digests.size() * sizeof(Digest));
+    PLAYCHAIN_TRACE_SPAN_BYTES(SIGN, digests.size() * sizeof(Digest));
+
+    secp256k1_context* _context = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+
+    PLAYCHAIN_ASSERT(_context);
+
+    try
+    {
+        std::vector<CompactSignature> result;
+        result.reserve(digests.size());
+
+        for (const auto& digest : digests)
+            result.push_back(sign_digest(_context, digest, key, check_canonical));
+
+        secp256k1_context_destroy(_context);
+
+        return result;
+    }
+    catch (const std::logic_error&)
+    {
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+
         secp256k1_context_destroy(_context);
 
         throw;
@@ -321,11 +486,19 @@ CompactSignature sign_digest(const Digest& digest, const PrivateKey& key, bool c
     PLAYCHAIN_ERROR("Required SECP256K1 lib");
     return {};
 }
+
+std::vector<CompactSignature> sign_digests(const std::vector<Digest>& digests, const PrivateKey& key, bool check_canonical)
+{
+    PLAYCHAIN_ERROR("Required SECP256K1 lib");
+    return {};
+}
 #endif //!SECP256K1
 
 #ifdef SECP256K1
 bool check_signature(const CompactSignature& sign, const Digest& digest, const CompressedPublicKey& key, bool check_canonical)
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("signer", digest.size());
+
     secp256k1_context* _context = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY | SECP256K1_CONTEXT_SIGN);
 
     PLAYCHAIN_ASSERT(_context);
@@ -355,6 +528,8 @@ bool check_signature(const CompactSignature& sign, const Digest& digest, const C
     }
     catch (const std::logic_error&)
     {
+        PLAYCHAIN_METRICS_FAILURE();
+
         secp256k1_context_destroy(_context);
 
         throw;
@@ -362,12 +537,66 @@ bool check_signature(const CompactSignature& sign, const Digest& digest, const C
 
     return false;
 }
+
+CompressedPublicKey recover_public_key(const CompactSignature& sign, const Digest& digest, bool check_canonical)
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("signer", digest.size());
+
+    //recovery only reads context, so it is shared by threads;
+    //never destroyed, threads can recover keys after static destructors
+    static const secp256k1_context* _context = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+
+    PLAYCHAIN_ASSERT(_context);
+
+    try
+    {
+        if (check_canonical)
+        {
+            PLAYCHAIN_ASSERT(is_canonical(sign));
+        }
+
+        //the first byte is 27 + 4 (compressed key) + recovery id
+        const int recid = (int)sign[0] - 27 - 4;
+        PLAYCHAIN_ASSERT(recid >= 0 && recid <= 3, "Invalid recovery id");
+
+        secp256k1_ecdsa_recoverable_signature signature;
+
+        PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_recoverable_signature_parse_compact(_context, &signature, &sign[1], recid));
+
+        secp256k1_pubkey public_key;
+
+        PLAYCHAIN_ASSERT(1 == secp256k1_ecdsa_recover(_context, &public_key, &signature, (unsigned char*)digest.data()));
+
+        CompressedPublicKey result;
+        size_t pk_len = result.size();
+
+        PLAYCHAIN_ASSERT(1 == secp256k1_ec_pubkey_serialize(_context, (unsigned char*)result.data(), &pk_len, &public_key, SECP256K1_EC_COMPRESSED));
+
+        PLAYCHAIN_ASSERT(pk_len == result.size());
+
+        return result;
+    }
+    catch (const std::logic_error&)
+    {
+        PLAYCHAIN_METRICS_FAILURE();
+
+        throw;
+    }
+
+    return {};
+}
 #else //SECP256K1
 bool check_signature(const CompactSignature& sign, const Digest& digest, const CompressedPublicKey& key, bool check_canonical)
 {
     PLAYCHAIN_ERROR("Required SECP256K1 lib");
     return false;
 }
+
+CompressedPublicKey recover_public_key(const CompactSignature& sign, const Digest& digest, bool check_canonical)
+{
+    PLAYCHAIN_ERROR("Required SECP256K1 lib");
+    return {};
+}
 #endif //!SECP256K1
 
 std::string to_hex(const char* d, uint32_t s)
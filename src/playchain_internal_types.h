@@ -6,11 +6,13 @@
 #include "sha256.h"
 #include "datastream.h"
 
-#include <rapidjson/writer.h>
+#include "json_backend.h"
 
+#include <cassert>
 #include <cstdint>
 #include <array>
 #include <map>
+#include <vector>
 
 namespace playchain {
 
@@ -126,7 +128,48 @@ using account_id_type = tp::PlaychainUserId;
 
 using witness_id_type = tp::PlaychainWitnessId;
 
-using raw_stream = sha256::encoder;
+//packed transaction body, it is digested on the fly by block-buffered encoder
+//or collected to be digested with bodies of other transactions by sha256::hash_batch
+class raw_stream
+{
+public:
+    raw_stream() = default;
+    //collects body instead of digesting it
+    explicit raw_stream(std::vector<char>& body)
+        : _body(&body)
+    {
+    }
+
+    void write(const char* d, uint32_t dlen)
+    {
+        _size += dlen;
+        if (_body)
+            _body->insert(_body->end(), d, d + dlen);
+        else
+            _encoder.write(d, dlen);
+    }
+    void put(char c)
+    {
+        write(&c, 1);
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    //digest of body written to not collecting stream
+    sha256 result()
+    {
+        assert(!_body);
+        return _encoder.result();
+    }
+
+private:
+    sha256::encoder _encoder;
+    std::vector<char>* _body = nullptr;
+    size_t _size = 0;
+};
 using json_stream = rapidjson::Writer<rapidjson::StringBuffer>;
 
 struct authority
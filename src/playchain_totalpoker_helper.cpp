@@ -2,9 +2,9 @@
 
 #include "playchain_defines.h"
 #include "pack_helper.h"
+#include "diagnostics.h"
 
-#include <rapidjson/document.h>
-#include <rapidjson/writer.h>
+#include "json_backend.h"
 
 #include <algorithm>
 #include <sstream>
@@ -104,9 +104,9 @@ PlaychainTotalpokerTableInfo PlaychainTotalpokerTableInfo::create(const Playchai
 
         return result;
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
@@ -3,14 +3,14 @@
 
 #include "convert_helper.h"
 #include "playchain_defines.h"
+#include "number_codec.h"
+#include "diagnostics.h"
 
-#include <rapidjson/document.h>
-#include <rapidjson/writer.h>
+#include "json_backend.h"
 
 #include <string>
-#include <sstream>
 #include <limits>
-#include <cstdlib>
+#include <cstring>
 
 namespace tp {
 
@@ -20,88 +20,48 @@ namespace {
     template <typename T>
     std::string id_to_str(const T& id)
     {
-        std::stringstream ss;
+        char buff[object_id_max_chars];
 
-        ss << id.space_id;
-        ss << '.';
-        ss << id.type_id;
-        ss << '.';
-        ss << id.instance;
-
-        return ss.str();
+        return std::string(buff, format_object_id(id.space_id, id.type_id, id.instance, buff));
     }
 
-#if !defined(PLAYCHAIN_LIB_FOR_MOBILE)
-    int to_int(const std::string& s)
-    {
-        try
-        {
-            auto r = std::stoull(s);
-            decltype(r) l = std::numeric_limits<uint32_t>::max();
-            PLAYCHAIN_ASSERT(r <= l, "32-bit integer is required");
-            return (int)r;
-        }
-        catch (const std::exception& e)
-        {
-            PLAYCHAIN_ERROR(e.what());
-        }
-    }
-#else //< !PLAYCHAIN_LIB_FOR_MOBILE
-    int to_int(const std::string& s)
-    {
-        try
-        {
-            auto r = std::atol(s.c_str());
-            PLAYCHAIN_ASSERT(r >= 0, "Unsigned integer is required");
-            decltype(r) l = std::numeric_limits<int>::max();
-            PLAYCHAIN_ASSERT(r <= l, "sizeof(int) integer is required");
-            return (int)r;
-        }
-        catch (const std::exception& e)
-        {
-            PLAYCHAIN_ERROR(e.what());
-        }
-    }
-#endif //< PLAYCHAIN_LIB_FOR_MOBILE
-
     template <typename T>
-    bool id_from_str(const std::string& s, T& id)
+    bool id_from_str(const char* s, const size_t size, T& id)
     {
-        try
-        {
-            auto first_dot = s.find('.');
-            auto second_dot = s.find('.', first_dot + 1);
-            if (first_dot == second_dot)
-                return false;
-            if (first_dot == 0 || first_dot == std::string::npos)
-                return false;
-
-            if (to_int(s.substr(0, first_dot)) != id.space_id || to_int(s.substr(first_dot + 1, second_dot - first_dot - 1)) != id.type_id)
-                return false;
-            id.instance = to_int(s.substr(second_dot + 1));
-        }
-        catch (std::logic_error&)
-        {
+        uint64_t space_id = 0, type_id = 0, instance = 0;
+
+        if (!parse_object_id(s, s + size, space_id, type_id, instance))
             return false;
-        }
+
+        if (space_id != (uint64_t)id.space_id || type_id != (uint64_t)id.type_id)
+            return false;
+        if (instance > (uint64_t)std::numeric_limits<int>::max())
+            return false;
+
+        id.instance = (int)instance;
         return true;
     }
 } // namespace
 
-#define IMPL_PLAYCHAIN_ID(OBJECT)                                                   \
-    Playchain##OBJECT##Id::operator std::string() const                             \
-    {                                                                               \
-        return id_to_str(*this);                                                    \
-    }                                                                               \
-                                                                                    \
-    Playchain##OBJECT##Id Playchain##OBJECT##Id::from_string(const std::string& id) \
-    {                                                                               \
-        Playchain##OBJECT##Id result;                                               \
-                                                                                    \
-        if (!id_from_str(id, result))                                               \
-            return {};                                                              \
-                                                                                    \
-        return result;                                                              \
+#define IMPL_PLAYCHAIN_ID(OBJECT)                                                                       \
+    Playchain##OBJECT##Id::operator std::string() const                                                 \
+    {                                                                                                   \
+        return id_to_str(*this);                                                                        \
+    }                                                                                                   \
+                                                                                                        \
+    Playchain##OBJECT##Id Playchain##OBJECT##Id::from_string(const std::string& id)                     \
+    {                                                                                                   \
+        return from_string(id.data(), id.size());                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    Playchain##OBJECT##Id Playchain##OBJECT##Id::from_string(const char* id, const size_t size)         \
+    {                                                                                                   \
+        Playchain##OBJECT##Id result;                                                                   \
+                                                                                                        \
+        if (!id_from_str(id, size, result))                                                             \
+            return {};                                                                                  \
+                                                                                                        \
+        return result;                                                                                  \
     }
 
 IMPL_PLAYCHAIN_ID(User)
@@ -125,129 +85,168 @@ PlaychainPLC::PlaychainPLC(const std::string& manual_plc_str)
 }
 
 PlaychainPLC PlaychainPLC::from_string(const std::string& manual_plc_str)
+{
+    return from_string(manual_plc_str.data(), manual_plc_str.size());
+}
+
+PlaychainPLC PlaychainPLC::from_string(const char* manual_plc_str, const size_t size)
 {
     static PlaychainDefaultSettings default_settings;
 
-    PlaychainPLC result;
+    static const size_t plc_length = std::strlen(PLC());
 
-    auto pos = manual_plc_str.rfind(PLC());
-    if (std::string::npos == pos)
+    //number before last PLC
+    if (size < plc_length)
         return {};
 
-    auto number = manual_plc_str.substr(0, pos);
+    const char* end = manual_plc_str + size - plc_length;
+    while (std::memcmp(end, PLC(), plc_length) != 0)
+    {
+        if (end == manual_plc_str)
+            return {};
+        --end;
+    }
 
-    auto it_space = number.rbegin();
-    while (it_space != number.rend())
+    while (end != manual_plc_str)
     {
-        char ch = *it_space;
+        char ch = end[-1];
         if (ch != ' ' && ch != '\t' && ch != '\n')
             break;
-        ++it_space;
+        --end;
     }
 
+    PlaychainPLC result;
     PlaychainMoney& amount = result._amount;
 
-    int order = 1;
+    //value of digit in fractional part, digits below precision are ignored
+    PlaychainMoney fraction_scale = 0;
     bool cents = false;
-    for (auto it_number = number.begin(); it_number != it_space.base(); ++it_number)
+    for (const char* pos = manual_plc_str; pos != end; ++pos)
     {
-        char ch[2] = { *it_number, '\0' };
-        if (ch[0] == '.' || ch[0] == ',')
+        const char ch = *pos;
+        if (ch == '.' || ch == ',')
         {
             if (cents)
                 break;
             cents = true;
-            order = 1;
+            fraction_scale = default_settings.PLC_PRECISION / 10;
             continue;
         }
-        if (ch[0] < '0' || ch[0] > '9')
+        if (ch < '0' || ch > '9')
             break;
-        PlaychainMoney a = (PlaychainMoney)atoi(ch);
-        a *= default_settings.PLC_PRECISION;
+
+        const PlaychainMoney digit = (PlaychainMoney)(ch - '0');
         if (cents)
         {
-            for (auto ci = 0; ci < order; ++ci)
-            {
-                a /= 10;
-            }
+            amount += digit * fraction_scale;
+            fraction_scale /= 10;
+        }
+        else
+        {
+            amount = amount * 10 + digit * default_settings.PLC_PRECISION;
         }
-        else if (order > 1)
-            amount *= 10;
-        amount += a;
-        ++order;
     }
 
     return result;
 }
 
-PlaychainPLC::operator std::string() const
+size_t PlaychainPLC::format(char* out) const
 {
     static PlaychainDefaultSettings default_settings;
 
-    std::stringstream ss;
-
-    ss << _amount / default_settings.PLC_PRECISION;
+    size_t size = format_uint64(_amount / default_settings.PLC_PRECISION, out);
 
-    auto fractional_part = _amount % default_settings.PLC_PRECISION;
+    PlaychainMoney fractional_part = _amount % default_settings.PLC_PRECISION;
     if (fractional_part > 0)
     {
-        ss << '.';
+        out[size++] = '.';
 
-        auto tmp = fractional_part;
-        tmp *= 10;
-        while (tmp < default_settings.PLC_PRECISION)
-        {
-            ss << '0';
-            tmp *= 10;
-        }
-        tmp = fractional_part;
-        while (tmp >= 10 && tmp % 10 == 0)
+        //leading zeros of fractional part without trailing ones
+        for (PlaychainMoney scale = default_settings.PLC_PRECISION / 10; scale > 0 && fractional_part > 0; scale /= 10)
         {
-            tmp /= 10;
+            out[size++] = (char)('0' + fractional_part / scale);
+            fractional_part %= scale;
         }
-        ss << tmp;
     }
 
-    ss << ' ' << PLC();
-    return ss.str();
+    out[size++] = ' ';
+
+    static const size_t plc_length = std::strlen(PLC());
+    std::memcpy(out + size, PLC(), plc_length);
+    return size + plc_length;
+}
+
+PlaychainPLC::operator std::string() const
+{
+    char buff[max_chars];
+
+    return std::string(buff, format(buff));
 }
 
 //////////////////////////////////////////////////////////////////////////
 ProtocolVersion::ProtocolVersion(const std::string& input_str)
+    : ProtocolVersion(input_str.data(), input_str.size())
 {
-    auto plus_pos = input_str.find('+');
-    if (std::string::npos != plus_pos)
-    {
-        metadata = input_str.substr(plus_pos+1);
-    }
+}
 
-    uint32_t major = 0, hardfork = 0, revision = 0;
-    char dot_a = 0, dot_b = 0;
+ProtocolVersion::ProtocolVersion(const char* input_str, const size_t size)
+{
+    const char* end = input_str + size;
 
-    std::stringstream s(input_str.substr(0, plus_pos));
-    s >> major >> dot_a >> hardfork >> dot_b >> revision;
+    const char* plus_pos = static_cast<const char*>(std::memchr(input_str, '+', size));
+    if (plus_pos)
+    {
+        metadata.assign(plus_pos + 1, end);
+        end = plus_pos;
+    }
 
-    // We'll accept either m.h.v or m_h_v as canonical version strings
-    PLAYCHAIN_ASSERT((dot_a == '.' || dot_a == '_') && dot_a == dot_b, "Input version does not contain proper dotted decimal format");
+    //"major.hardfork.revision", we'll accept either m.h.v or m_h_v as canonical version strings
+    const char* dot_a = input_str;
+    while (dot_a != end && *dot_a >= '0' && *dot_a <= '9')
+        ++dot_a;
+    const char* dot_b = dot_a == end ? end : dot_a + 1;
+    while (dot_b != end && *dot_b >= '0' && *dot_b <= '9')
+        ++dot_b;
+
+    PLAYCHAIN_ASSERT(dot_a != end && dot_b != end && (*dot_a == '.' || *dot_a == '_') && *dot_a == *dot_b,
+                     "Input version does not contain proper dotted decimal format");
+
+    uint64_t major = 0, hardfork = 0, revision = 0;
+    PLAYCHAIN_ASSERT(parse_uint64(input_str, dot_a, major) && parse_uint64(dot_a + 1, dot_b, hardfork),
+                     "Input version does not contain proper dotted decimal format");
+    PLAYCHAIN_ASSERT(parse_uint64(dot_b + 1, end, revision), "Extra information at end of version string");
     PLAYCHAIN_ASSERT(major <= 0xFF, "Major version is out of range");
     PLAYCHAIN_ASSERT(hardfork <= 0xFF, "Minor/Hardfork version is out of range");
     PLAYCHAIN_ASSERT(revision <= 0xFFFF, "Patch/Revision version is out of range");
-    PLAYCHAIN_ASSERT(s.eof(), "Extra information at end of version string");
 
-    v_num = 0 | (major << 24) | (hardfork << 16) | revision;
+    v_num = 0 | (uint32_t)(major << 24) | (uint32_t)(hardfork << 16) | (uint32_t)revision;
+}
+
+size_t ProtocolVersion::format_number(char* out) const
+{
+    size_t size = format_uint64(major(), out);
+    out[size++] = '.';
+    size += format_uint64(minor(), out + size);
+    out[size++] = '.';
+    size += format_uint64(patch(), out + size);
+    return size;
 }
 
 ProtocolVersion::operator std::string() const
 {
-    std::stringstream s;
-    s << (int)major() << '.' << (int)minor() << '.' << patch();
+    char buff[number_max_chars];
+    const size_t size = format_number(buff);
+
+    std::string result;
+    result.reserve(size + (metadata.empty() ? 0 : 1 + metadata.size()));
+    result.append(buff, size);
     if (!metadata.empty())
     {
-        s << '+';
-        s << metadata;
+        result += '+';
+        result += metadata;
     }
 
-    return s.str();
+    return result;
 }
 //////////////////////////////////////////////////////////////////////////
 
@@ -300,9 +299,9 @@ BlockchainRequest BlockchainRequest::from_legacy_transaction_string(const std::s
         return { PlaychainAPI {}.WALLET,
                  "broadcast_transaction", buff.GetString() };
     }
-    catch (std::exception&)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
@@ -338,9 +337,9 @@ std::string BlockchainRequest::to_legacy_transaction_string(const BlockchainRequ
 
         return { buff.GetString() };
     }
-    catch (std::exception&)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
@@ -373,9 +372,9 @@ BlockchainRequest BlockchainRequest::from_string(const std::string& serialized_r
         return { js_array[0].GetString(),
                  js_array[1].GetString(), buff.GetString() };
     }
-    catch (std::exception&)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
@@ -433,6 +432,47 @@ bool BlockchainRequest::valid() const
     return true;
 }
 
+int64_t BlockchainBatchRequest::add(const BlockchainRequest& request)
+{
+    PLAYCHAIN_ASSERT(request.valid(), "Invalid request");
+
+    _requests.push_back(request);
+    return id(_requests.size() - 1);
+}
+
+std::string BlockchainBatchRequest::to_string(const BlockchainBatchRequest& batch)
+{
+    PLAYCHAIN_ASSERT(batch.valid(), "Empty batch");
+
+    rapidjson::StringBuffer buff;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
+
+    writer.StartArray();
+    for (size_t ci = 0; ci < batch.size(); ++ci)
+    {
+        const std::string call = BlockchainRequest::to_string(batch._requests[ci]);
+
+        writer.StartObject();
+        writer.Key("jsonrpc");
+        writer.String("2.0");
+        writer.Key("id");
+        writer.Int64(batch.id(ci));
+        writer.Key("method");
+        writer.String("call");
+        writer.Key("params");
+        writer.RawValue(call.c_str(), call.length(), rapidjson::kArrayType);
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    return buff.GetString();
+}
+
+bool BlockchainBatchRequest::valid() const
+{
+    return !_requests.empty();
+}
+
 bool BlockchainDigestTransaction::valid() const
 {
     return !_digest.empty() && _request.valid();
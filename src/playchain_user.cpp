@@ -11,6 +11,15 @@ namespace tp {
 
 using namespace playchain;
 
+namespace {
+    uint64_t next_noise()
+    {
+        static uint32_t i = 0;
+
+        return create_pseudo_random_from_time(++i);
+    }
+} // namespace
+
 struct PlaychainUserContext
 {
     PlaychainUserContext(
@@ -23,9 +32,24 @@ struct PlaychainUserContext
     {
     }
 
+    PlaychainUserContext(
+        const std::string& name,
+        const PlaychainUserId& id,
+        const PrivateKey& key, const CompressedPublicKey& public_key, const uint64_t noise)
+        : name(name)
+        , id(id)
+        , private_key(key, noise)
+        , public_key(public_key)
+        , has_public_key(true)
+    {
+    }
+
     std::string name;
     PlaychainUserId id;
     private_key_sec private_key;
+    //computed on demand if it is not known
+    CompressedPublicKey public_key;
+    bool has_public_key = false;
 };
 
 PlaychainUser::PlaychainUser(
@@ -33,13 +57,22 @@ PlaychainUser::PlaychainUser(
     const PlaychainUserId& id,
     const std::string& private_key_wif)
 {
-    static uint32_t i = 0;
-
-    uint64_t rnd = create_pseudo_random_from_time(++i);
+    uint64_t rnd = next_noise();
 
     m_context.reset(new PlaychainUserContext(name, id, private_key_wif, rnd));
 }
 
+PlaychainUser::PlaychainUser(
+    const std::string& name,
+    const PlaychainUserId& id,
+    const PrivateKey& private_key,
+    const CompressedPublicKey& public_key)
+{
+    uint64_t rnd = next_noise();
+
+    m_context.reset(new PlaychainUserContext(name, id, private_key, public_key, rnd));
+}
+
 PlaychainUser::~PlaychainUser() {}
 
 const std::string PlaychainUser::name() const
@@ -69,11 +102,15 @@ std::string PlaychainUser::signDigest(const std::string&) const
 
 CompressedPublicKey PlaychainUser::getPublicKey() const
 {
+    if (m_context->has_public_key)
+        return m_context->public_key;
     return m_context->private_key.get_public();
 }
 
 std::string PlaychainUser::getSerializedPublicKey() const
 {
+    if (m_context->has_public_key)
+        return public_key_to_string(m_context->public_key);
     return m_context->private_key.get_public_str();
 }
 
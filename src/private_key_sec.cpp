@@ -79,6 +79,11 @@ private_key_sec::private_key_sec(const std::string& private_key_wif, const uint6
     _crypted = encode(key, noise);
 }
 
+private_key_sec::private_key_sec(const private_key& key, const uint64_t noise)
+    : _crypted(encode(key, noise))
+{
+}
+
 private_key private_key_sec::decrypt() const
 {
     return decode(_crypted);
@@ -11,6 +11,7 @@ using namespace tp;
 struct private_key_sec
 {
     private_key_sec(const std::string& private_key_wif, const uint64_t noise);
+    private_key_sec(const private_key& key, const uint64_t noise);
     ~private_key_sec() = default;
 
     private_key decrypt() const;
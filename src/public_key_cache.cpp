@@ -0,0 +1,184 @@
+#include <playchain/public_key_cache.h>
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace tp {
+
+namespace {
+    struct public_key_hash
+    {
+        size_t operator()(const CompressedPublicKey& pub_key) const
+        {
+            //first byte is parity of Y, X is uniformly distributed
+            size_t result = 0;
+            std::memcpy(&result, pub_key.data() + 1, sizeof(result));
+            return result;
+        }
+    };
+} // namespace
+
+struct PlaychainPublicKeyCacheContext
+{
+    struct entry
+    {
+        CompressedPublicKey pub_key;
+        std::string formatted_key;
+    };
+
+    //the most recently used entry is the first
+    using entries_type = std::list<entry>;
+
+    explicit PlaychainPublicKeyCacheContext(const size_t capacity)
+        : capacity(capacity)
+        , enabled(capacity > 0)
+    {
+    }
+
+    template <typename Index, typename Key>
+    entries_type::iterator find(Index& index, const Key& key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            ++misses;
+            return entries.end();
+        }
+
+        ++hits;
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second;
+    }
+
+    void insert(const CompressedPublicKey& pub_key, const std::string& formatted_key)
+    {
+        if (!capacity || by_key.count(pub_key))
+            return;
+
+        shrink(capacity - 1);
+
+        entries.push_front({ pub_key, formatted_key });
+        by_key.emplace(pub_key, entries.begin());
+        by_string.emplace(formatted_key, entries.begin());
+    }
+
+    void shrink(const size_t size)
+    {
+        while (entries.size() > size)
+        {
+            const entry& last = entries.back();
+            by_key.erase(last.pub_key);
+            by_string.erase(last.formatted_key);
+            entries.pop_back();
+            ++evictions;
+        }
+    }
+
+    size_t capacity = 0;
+    //checked without lock, disabled cache does not serialize threads
+    std::atomic<bool> enabled;
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+
+    entries_type entries;
+    std::unordered_map<CompressedPublicKey, entries_type::iterator, public_key_hash> by_key;
+    std::unordered_map<std::string, entries_type::iterator> by_string;
+
+    mutable std::mutex lock;
+};
+
+PlaychainPublicKeyCache::PlaychainPublicKeyCache(const size_t capacity)
+    : m_context(new PlaychainPublicKeyCacheContext(capacity))
+{
+}
+
+PlaychainPublicKeyCache::~PlaychainPublicKeyCache() {}
+
+bool PlaychainPublicKeyCache::find(const std::string& formatted_key, CompressedPublicKey& pub_key)
+{
+    if (!m_context->enabled)
+        return false;
+
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    auto it = m_context->find(m_context->by_string, formatted_key);
+    if (it == m_context->entries.end())
+        return false;
+
+    pub_key = it->pub_key;
+    return true;
+}
+
+bool PlaychainPublicKeyCache::find(const CompressedPublicKey& pub_key, std::string& formatted_key)
+{
+    if (!m_context->enabled)
+        return false;
+
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    auto it = m_context->find(m_context->by_key, pub_key);
+    if (it == m_context->entries.end())
+        return false;
+
+    formatted_key = it->formatted_key;
+    return true;
+}
+
+void PlaychainPublicKeyCache::insert(const CompressedPublicKey& pub_key, const std::string& formatted_key)
+{
+    if (!m_context->enabled)
+        return;
+
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    m_context->insert(pub_key, formatted_key);
+}
+
+void PlaychainPublicKeyCache::setCapacity(const size_t capacity)
+{
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    m_context->capacity = capacity;
+    m_context->enabled = capacity > 0;
+    m_context->shrink(capacity);
+}
+
+void PlaychainPublicKeyCache::clear()
+{
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    m_context->entries.clear();
+    m_context->by_key.clear();
+    m_context->by_string.clear();
+    m_context->hits = 0;
+    m_context->misses = 0;
+    m_context->evictions = 0;
+}
+
+PlaychainPublicKeyCacheStats PlaychainPublicKeyCache::stats() const
+{
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    PlaychainPublicKeyCacheStats result;
+
+    result.capacity = m_context->capacity;
+    result.size = m_context->entries.size();
+    result.hits = m_context->hits;
+    result.misses = m_context->misses;
+    result.evictions = m_context->evictions;
+
+    return result;
+}
+
+PlaychainPublicKeyCache& PlaychainPublicKeyCache::instance()
+{
+    static PlaychainPublicKeyCache cache;
+    return cache;
+}
+
+} // namespace tp
@@ -6,14 +6,17 @@
 
 #include "playchain_operations.h"
 #include "pack_helper.h"
+#include "metrics.h"
+#include "tracing.h"
+#include "diagnostics.h"
 
-#include <rapidjson/document.h>
+#include "json_backend.h"
 
 #include <cassert>
-#include <openssl/sha.h>
 #include <algorithm>
 #include <mutex>
 #include <limits>
+#include <numeric>
 
 namespace tp {
 using namespace playchain;
@@ -90,12 +93,15 @@ namespace {
 
     using operations = std::vector<const operation*>;
 
-    BlockchainDigestTransaction makeTransaction(
+    //JSON request of transaction and its packed body for digest
+    BlockchainRequest packTransaction(
         const PlaychainSettings& settings,
         const PlaychainRequestBuilderContext& context,
-        const operations& ops)
+        const operations& ops,
+        raw_stream& coder)
     {
-        BlockchainDigestTransaction result;
+        PLAYCHAIN_TRACE_SPAN(TRANSACTION_PACK);
+
         rapidjson::StringBuffer buff;
         rapidjson::Writer<rapidjson::StringBuffer> js_writer(buff);
 
@@ -111,8 +117,6 @@ namespace {
 
         //expiration = [t + settings.transaction_expiration_sec - settings.transaction_expiration_offset_sec, t + settings.transaction_expiration_sec]
 
-        digest_type::encoder coder;
-
         pack(coder, chain_id_type { context.chain_id });
         pack(coder, context.get_last_ref_block_num());
         pack(coder, context.get_last_ref_block_prefix());
@@ -120,7 +124,9 @@ namespace {
 
         pack_field(js_writer, "ref_block_num", context.get_last_ref_block_num());
         pack_field(js_writer, "ref_block_prefix", context.get_last_ref_block_prefix());
-        pack_field(js_writer, "expiration", to_iso_string(expiration));
+        char expiration_str[iso_time_chars + 1];
+        expiration_str[format_iso_time(expiration, expiration_str)] = '\0';
+        pack_field(js_writer, "expiration", (const char*)expiration_str);
 
         pack(coder, unsigned_int((uint32_t)ops.size()));
 
@@ -137,23 +143,112 @@ namespace {
         pack(coder, extensions);
         pack_field(js_writer, "extensions", extensions);
 
-        auto digest = coder.result().str();
-
         js_writer.EndObject();
         js_writer.EndArray();
 
-        auto request = BlockchainRequest { settings.API().GRAPHENE_NETWORK,
-                                           "broadcast_transaction", buff.GetString() };
+        PLAYCHAIN_METRICS_BYTES(buff.GetSize());
+        PLAYCHAIN_TRACE_BYTES(buff.GetSize());
+
+        return BlockchainRequest { settings.API().GRAPHENE_NETWORK,
+                                   "broadcast_transaction", buff.GetString() };
+    }
+
+    BlockchainDigestTransaction makeTransaction(
+        const PlaychainSettings& settings,
+        const PlaychainRequestBuilderContext& context,
+        const operations& ops)
+    {
+        PLAYCHAIN_TRACE_SPAN(TRANSACTION);
+
+        //body is digested while it is packed (TRANSACTION_PACK stage),
+        //only the last block is left
+        raw_stream coder;
+        auto request = packTransaction(settings, context, ops, coder);
+        std::string digest = coder.result().str();
+
+        PLAYCHAIN_TRACE_DIGEST(digest);
+        PLAYCHAIN_PROBE1(transaction_digest, digest.c_str());
 
         return { request, digest };
     }
 
+    //digests of all transactions are computed at once
+    std::vector<BlockchainDigestTransaction> makeTransactions(
+        const PlaychainSettings& settings,
+        const PlaychainRequestBuilderContext& context,
+        const std::vector<operations>& transactions)
+    {
+        PLAYCHAIN_TRACE_SPAN(TRANSACTION);
+
+        std::vector<std::vector<char>> bodies(transactions.size());
+        std::vector<BlockchainRequest> requests;
+        requests.reserve(transactions.size());
+        for (size_t ci = 0; ci < transactions.size(); ++ci)
+        {
+            bodies[ci].reserve(256);
+            raw_stream coder { bodies[ci] };
+            requests.push_back(packTransaction(settings, context, transactions[ci], coder));
+        }
+
+        std::vector<const char*> body_data;
+        std::vector<size_t> sizes;
+        body_data.reserve(bodies.size());
+        sizes.reserve(bodies.size());
+        for (const auto& body : bodies)
+        {
+            body_data.push_back(body.data());
+            sizes.push_back(body.size());
+        }
+        std::vector<digest_type> digests(bodies.size());
+        {
+            PLAYCHAIN_TRACE_SPAN_BYTES(TRANSACTION_HASH, std::accumulate(sizes.begin(), sizes.end(), size_t { 0 }));
+
+            digest_type::hash_batch(body_data.data(), sizes.data(), bodies.size(), digests.data());
+        }
+
+        std::vector<BlockchainDigestTransaction> result;
+        result.reserve(transactions.size());
+        for (size_t ci = 0; ci < transactions.size(); ++ci)
+        {
+            result.push_back({ requests[ci], digests[ci].str() });
+            PLAYCHAIN_PROBE1(transaction_digest, result.back().digest().c_str());
+        }
+        return result;
+    }
+
     BlockchainDigestTransaction makeTransaction(const PlaychainSettings& settings,
                                                 const PlaychainRequestBuilderContext& context,
                                                 const operation* pop)
     {
         return makeTransaction(settings, context, operations { pop });
     }
+
+    game_result_check_operation makeGameResultOperation(
+        const PlaychainSettings& settings,
+        const PlaychainUserId& voter,
+        const PlaychainUserId& table_owner,
+        const PlaychainTableId& table,
+        const GameResult& state)
+    {
+        game_result_check_operation op;
+        op.fee = asset(settings.fee_game_result_playing, settings.asset_id);
+        op.voter = voter;
+        op.table_owner = table_owner;
+        op.table = table;
+
+        std::transform(begin(state.cash), end(state.cash), std::inserter(op.result.cash, end(op.result.cash)),
+                       [&settings](const decltype(state.cash)::value_type& data) {
+                           gamer_cash_result r { asset(data.second.cash, settings.asset_id),
+                                                 asset(data.second.rake, settings.asset_id) };
+                           return std::make_pair(data.first, r);
+                       });
+
+        op.result.log = state.log;
+
+        op.fee += asset(calculate_data_fee(op.pack_size(), settings.fee_game_result_playing_price_per_kbyte),
+                        settings.asset_id);
+        return op;
+    }
 } // namespace
 
 PlaychainRequestBuilder::PlaychainRequestBuilder(const std::string& chain_id, const PlaychainSettings& settings)
@@ -192,6 +287,8 @@ BlockchainRequest PlaychainRequestBuilder::makeGetChainIdRequest()
 
 BlockchainRequest PlaychainRequestBuilder::makeLoginRequest(const std::string& player) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -204,6 +301,8 @@ BlockchainRequest PlaychainRequestBuilder::makeLoginRequest(const std::string& p
 
 BlockchainRequest PlaychainRequestBuilder::makeGetTablesInfoRequest(const std::set<PlaychainTableId>& ids) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -216,6 +315,8 @@ BlockchainRequest PlaychainRequestBuilder::makeGetTablesInfoRequest(const std::s
 
 BlockchainRequest PlaychainRequestBuilder::makeGetAccountIdByNameRequest(const std::set<std::string>& names) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -235,6 +336,8 @@ BlockchainRequest PlaychainRequestBuilder::makeListPlayerInvitationsRequest(cons
                                                                             const std::string& last_page_uid,
                                                                             const uint32_t limit) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -251,6 +354,8 @@ BlockchainRequest PlaychainRequestBuilder::makeListInvitedPlayersRequest(const P
                                                                          const std::string& last_page_uid,
                                                                          const uint32_t limit) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -265,6 +370,8 @@ BlockchainRequest PlaychainRequestBuilder::makeListInvitedPlayersRequest(const P
 
 BlockchainRequest PlaychainRequestBuilder::makeGetPlaychainBalanceRequest(const PlaychainUserId& account) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -282,6 +389,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCreatePendingBuyinTrans
     const PlaychainMoney amount,
     const std::string& metadata) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     buy_in_reserve_operation op;
     op.fee = asset(m_settings.fee_buy_in_reserve, m_settings.asset_id);
     op.player = player;
@@ -299,6 +408,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCancelPendingBuyinTrans
     const PlaychainUserId& player,
     const std::string& pending_buyin_uid) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     buy_in_reserving_cancel_operation op;
     op.fee = asset(m_settings.fee_buy_in_reserving_cancel,
                    m_settings.asset_id);
@@ -315,6 +426,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeResolvePendingBuyinTran
     const PlaychainTableId& table,
     const PlaychainPendingBuyinId& pending_buyin) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     buy_in_reserving_resolve_operation op;
     op.fee = asset(m_settings.fee_buy_in_reserving_resolve, m_settings.asset_id);
     op.table = table;
@@ -327,6 +440,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeResolvePendingBuyinTran
 BlockchainDigestTransaction PlaychainRequestBuilder::makeCancelAllPendingBuyinsTransaction(
     const PlaychainUserId& player) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     buy_in_reserving_cancel_all_operation op;
     op.fee = asset(m_settings.fee_buy_in_reserving_cancel_all, m_settings.asset_id);
     op.player = player;
@@ -338,6 +453,8 @@ BlockchainRequest PlaychainRequestBuilder::makeCheckIfTableAllocatedForPendingBu
     const PlaychainUserId& player,
     const std::string& pending_buyin_uid) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -353,6 +470,8 @@ BlockchainRequest PlaychainRequestBuilder::makeListTablesWithPlayerRequest(
     const PlaychainUserId& player,
     const uint32_t limit) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -370,6 +489,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCreatePlayerInvitationT
     const uint32_t& lifetime_in_sec,
     const std::string& metadata) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     player_invitation_create_operation op;
     op.fee = asset(m_settings.fee_create_player_invitation, m_settings.asset_id);
     op.inviter = inviter;
@@ -396,6 +517,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCancelPlayerInvitationT
     const PlaychainUserId& inviter,
     const std::string& uid) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     player_invitation_cancel_operation op;
     op.fee = asset(m_settings.fee_cancel_player_invitation, m_settings.asset_id);
     op.inviter = inviter;
@@ -413,6 +536,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeResolvePlayerInvitation
     const std::string& new_pub_key,
     const std::string& new_account_name) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     try
     {
         player_invitation_resolve_operation op;
@@ -430,8 +555,11 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeResolvePlayerInvitation
 
         return makeTransaction(m_settings, *m_context, &op);
     }
-    catch (std::exception&)
+    catch (std::exception& e)
     {
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
     return {};
 }
@@ -439,6 +567,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeResolvePlayerInvitation
 BlockchainRequest PlaychainRequestBuilder::makeLegacyLoginRequest(
     const std::string& player, const std::string& formatted_key) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -452,6 +582,8 @@ BlockchainRequest PlaychainRequestBuilder::makeLegacyLoginRequest(
 
 BlockchainRequest PlaychainRequestBuilder::makeLegacyGetAccountBalanceRequest(const std::string& player) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -467,6 +599,8 @@ BlockchainRequest PlaychainRequestBuilder::makeLegacyCreateAccountWithPubkeyRequ
     const std::string& player,
     const std::string& formatted_key) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -484,6 +618,8 @@ BlockchainRequest PlaychainRequestBuilder::makeLegacyCreateAccountWithPubkeyRequ
 
 BlockchainRequest PlaychainRequestBuilder::makeLegacyGetAccountIdByNameRequest(const std::set<std::string>& names) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -515,6 +651,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeBuyinTransaction(
     const PlaychainTableId& table,
     const PlaychainMoney amount) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     buy_in_table_operation op;
     op.fee = asset(m_settings.fee_buyin, m_settings.asset_id);
     op.player = player;
@@ -532,6 +670,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeBuyoutTransaction(
     const PlaychainMoney amount,
     const std::string& reason) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     buy_out_table_operation op;
     op.fee = asset(m_settings.fee_buyout, m_settings.asset_id);
     op.player = player;
@@ -551,6 +691,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeVoteForStartGameTransac
     const PlaychainTableId& table,
     const GameInitialData& state) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     game_start_playing_check_operation op;
     op.fee = asset(m_settings.fee_game_start_playing, m_settings.asset_id);
     op.voter = voter;
@@ -575,30 +717,37 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeVoteForGameResultTransa
     const PlaychainTableId& table,
     const GameResult& state) const
 {
-    game_result_check_operation op;
-    op.fee = asset(m_settings.fee_game_result_playing, m_settings.asset_id);
-    op.voter = voter;
-    op.table_owner = table_owner;
-    op.table = table;
-
-    std::transform(begin(state.cash), end(state.cash), std::inserter(op.result.cash, end(op.result.cash)),
-                   [this](const decltype(state.cash)::value_type& data) {
-                       gamer_cash_result r { asset(data.second.cash, m_settings.asset_id),
-                                             asset(data.second.rake, m_settings.asset_id) };
-                       return std::make_pair(data.first, r);
-                   });
-
-    op.result.log = state.log;
+    PLAYCHAIN_METRICS_SCOPE("builder");
 
-    op.fee += asset(calculate_data_fee(op.pack_size(), m_settings.fee_game_result_playing_price_per_kbyte),
-                    m_settings.asset_id);
+    auto op = makeGameResultOperation(m_settings, voter, table_owner, table, state);
     return makeTransaction(m_settings, *m_context, &op);
 }
 
+std::vector<BlockchainDigestTransaction> PlaychainRequestBuilder::makeVoteForGameResultTransactions(
+    const PlaychainUserId& voter,
+    const PlaychainUserId& table_owner,
+    const std::map<PlaychainTableId, GameResult>& results) const
+{
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
+    std::vector<game_result_check_operation> ops;
+    ops.reserve(results.size());
+    for (const auto& table_result : results)
+        ops.push_back(makeGameResultOperation(m_settings, voter, table_owner, table_result.first, table_result.second));
+
+    std::vector<operations> transactions;
+    transactions.reserve(ops.size());
+    for (const auto& op : ops)
+        transactions.push_back(operations { &op });
+    return makeTransactions(m_settings, *m_context, transactions);
+}
+
 BlockchainDigestTransaction PlaychainRequestBuilder::makeGameResetTransaction(const PlaychainUserId& table_owner,
                                                                               const PlaychainTableId& table,
                                                                               const bool rollback_table) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     game_reset_operation op;
     op.fee = asset(m_settings.fee_game_reset, m_settings.asset_id);
     op.table_owner = table_owner;
@@ -612,6 +761,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeWithdrawPlaychainVestin
     const PlaychainUserId& account,
     const WithdrawableBalanceInfo& to_withdraw) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     vesting_balance_withdraw_operation op_for_referral_balance;
     vesting_balance_withdraw_operation op_for_rake_balance;
     vesting_balance_withdraw_operation op_for_witness_balance;
@@ -656,6 +807,9 @@ BlockchainRequest PlaychainRequestBuilder::makeBroadcastTransaction(
     const BlockchainRequest& trx,
     const std::set<std::string>& signatures) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+    PLAYCHAIN_TRACE_SPAN(BROADCAST);
+
     try
     {
         rapidjson::Document document;
@@ -703,6 +857,9 @@ BlockchainRequest PlaychainRequestBuilder::makeBroadcastTransaction(
 
         document.Accept(writer);
 
+        PLAYCHAIN_METRICS_BYTES(buff.GetSize());
+        PLAYCHAIN_TRACE_BYTES(buff.GetSize());
+
         std::string api = m_settings.API().GRAPHENE_NETWORK;
         if (m_settings.all_legacy_from_wallet_api)
             api = m_settings.API().WALLET;
@@ -711,7 +868,9 @@ BlockchainRequest PlaychainRequestBuilder::makeBroadcastTransaction(
     }
     catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
@@ -719,6 +878,8 @@ BlockchainRequest PlaychainRequestBuilder::makeBroadcastTransaction(
 
 std::pair<BlockchainRequest, int> PlaychainRequestBuilder::makeSubscribeChangeTableInfoNotificationRequest(const std::set<PlaychainTableId>& ids, const int identifier) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     int _identifier = identifier;
     if (-1 == _identifier)
     {
@@ -740,6 +901,8 @@ std::pair<BlockchainRequest, int> PlaychainRequestBuilder::makeSubscribeChangeTa
 
 BlockchainRequest PlaychainRequestBuilder::makeCancelSubscriptionForChangeTableInfoNotificationRequest(const std::set<PlaychainTableId>& ids) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -757,6 +920,8 @@ BlockchainRequest PlaychainRequestBuilder::makeCancelSubscriptionForChangeTableI
 
 BlockchainRequest PlaychainRequestBuilder::makeGetPlayerIdByAccountIdRequest(const PlaychainUserId& account) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -771,6 +936,8 @@ BlockchainRequest PlaychainRequestBuilder::makeListRoomsRequest(const PlaychainU
                                                                 const uint32_t limit,
                                                                 const PlaychainRoomId& from) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -778,7 +945,7 @@ BlockchainRequest PlaychainRequestBuilder::makeListRoomsRequest(const PlaychainU
     pack(writer, owner);
     if (from.valid())
     {
-        pack(writer, (std::string)from);
+        pack(writer, from);
     }
     else
     {
@@ -792,6 +959,8 @@ BlockchainRequest PlaychainRequestBuilder::makeListRoomsRequest(const PlaychainU
 
 BlockchainRequest PlaychainRequestBuilder::makeGetRoomInfoRequest(const PlaychainUserId& owner, const std::string& metadata) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -807,6 +976,8 @@ BlockchainRequest PlaychainRequestBuilder::makeGetTablesInfoByMetadataRequest(co
                                                                               const std::string& metadata,
                                                                               const uint32_t limit) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -821,6 +992,8 @@ BlockchainRequest PlaychainRequestBuilder::makeGetTablesInfoByMetadataRequest(co
 
 BlockchainRequest PlaychainRequestBuilder::makeListTablesRequest(const PlaychainRoomId& room, const uint32_t limit, const PlaychainTableId& from) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -828,7 +1001,7 @@ BlockchainRequest PlaychainRequestBuilder::makeListTablesRequest(const Playchain
     pack(writer, room);
     if (from.valid())
     {
-        pack(writer, (std::string)from);
+        pack(writer, from);
     }
     else
     {
@@ -845,6 +1018,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeTransferRequest(
     const PlaychainUserId& to,
     const PlaychainMoney amount) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     transfer_operation op;
     op.fee = asset(m_settings.fee_transfer, m_settings.asset_id);
     op.from = from;
@@ -861,6 +1036,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCreateAccountWithPubkey
     const std::string& player,
     const std::string& new_pub_key) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     account_create_operation op;
     op.fee = asset(m_settings.fee_create_account_with_public_key, m_settings.asset_id);
     op.registrar = registrator;
@@ -883,6 +1060,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCreatePlayerByRoomOwner
     const PlaychainUserId& room_owner,
     const PlaychainUserId& account) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     player_create_by_room_owner_operation op;
     op.fee = asset(m_settings.fee_player_create_by_room_owner, m_settings.asset_id);
     op.account = account;
@@ -897,6 +1076,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCreateRoomRequest(
     const std::string& server_url,
     const std::string& metadata) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     room_create_operation op;
     op.fee = asset(m_settings.fee_create_room, m_settings.asset_id);
     op.owner = room_owner;
@@ -916,6 +1097,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeCreateTableRequest(
     const uint16_t required_witnesses,
     const PlaychainMoney min_accepted_proposal_asset) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     table_create_operation op;
     op.fee = asset(m_settings.fee_create_table, m_settings.asset_id);
     op.owner = room_owner;
@@ -936,6 +1119,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeUpdateRoomRequest(
     const std::string& server_url,
     const std::string& metadata) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     room_update_operation op;
     op.fee = asset(m_settings.fee_update_room, m_settings.asset_id);
     op.room = room;
@@ -956,6 +1141,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeUpdateTableRequest(
     const uint16_t required_witnesses,
     const PlaychainMoney min_accepted_proposal_asset) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     table_update_operation op;
     op.fee = asset(m_settings.fee_update_table, m_settings.asset_id);
     op.owner = room_owner;
@@ -973,6 +1160,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeAliveTableRequest(
     const std::set<PlaychainTableId>& tables,
     const PlaychainUserId& room_owner) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     table_alive_operation op;
     op.fee = asset(m_settings.fee_alive_table, m_settings.asset_id);
     op.owner = room_owner;
@@ -987,6 +1176,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeUpdateWitnessRequest(
     const std::string& new_url,
     const std::string& new_signing_key) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     witness_update_operation op;
     op.fee = asset(m_settings.fee_witness_update, m_settings.asset_id);
     op.witness = witness;
@@ -999,6 +1190,8 @@ BlockchainDigestTransaction PlaychainRequestBuilder::makeUpdateWitnessRequest(
 
 BlockchainRequest PlaychainRequestBuilder::makeGetBlockchainWitnessRequest(const PlaychainUserId& witness_account) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -1011,6 +1204,8 @@ BlockchainRequest PlaychainRequestBuilder::makeGetBlockchainWitnessRequest(const
 
 BlockchainRequest PlaychainRequestBuilder::makeGetBlockchainAccountsRequest(const std::vector<PlaychainUserId>& accounts) const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -1023,6 +1218,8 @@ BlockchainRequest PlaychainRequestBuilder::makeGetBlockchainAccountsRequest(cons
 
 BlockchainRequest PlaychainRequestBuilder::makeGetBlockchainGameWitnessesRequest() const
 {
+    PLAYCHAIN_METRICS_SCOPE("builder");
+
     rapidjson::StringBuffer buff;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buff);
 
@@ -5,8 +5,16 @@
 
 #include "playchain_defines.h"
 #include "playchain_operations.h"
+#include "json_decoder.h"
+#include "json_stream_parser.h"
+#include "json_parse_arena.h"
+#include "json_message.h"
+#include "metrics.h"
+#include "tracing.h"
+#include "diagnostics.h"
+#include "number_codec.h"
 
-#include <rapidjson/document.h>
+#include "json_backend.h"
 
 #include <iostream>
 #include <sstream>
@@ -21,41 +29,104 @@ namespace tp {
 
 using namespace playchain;
 
+//response of lazy views with member index of its objects
+struct PlaychainViewDocument
+{
+    //response copy that is parsed in place, empty for in-situ response
+    //(view uses buffer of caller then)
+    std::vector<char> buffer;
+    rapidjson::Document document;
+    PlaychainSettings settings;
+
+    std::vector<const rapidjson::Value*> objects;
+    //fields_count member values per object, nullptr for absent member
+    std::vector<const rapidjson::Value*> fields;
+    size_t fields_count = 0;
+
+    const rapidjson::Value* field(const size_t index, const size_t field) const
+    {
+        return fields[index * fields_count + field];
+    }
+};
+
 namespace {
     template <typename Id, typename TJsonObject>
     Id parse_id(TJsonObject&& json_id, const PlaychainSettings&)
     {
         PLAYCHAIN_ASSERT_JSON(json_id.IsString());
 
-        Id ret = Id::from_string(json_id.GetString());
+        Id ret = Id::from_string(json_id.GetString(), json_id.GetStringLength());
         PLAYCHAIN_ASSERT_JSON(ret.valid());
 
         return ret;
     }
 
-    template <typename TJsonObject>
-    PlaychainMoney parse_asset(TJsonObject&& js_object, const PlaychainSettings& settings)
+    template <typename TJsonValue>
+    time_t parse_time(const TJsonValue& js_time)
     {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+        PLAYCHAIN_ASSERT_JSON(js_time.IsString());
+
+        return from_iso_string(js_time.GetString(), js_time.GetStringLength());
+    }
+
+    json_decode_mode json_mode(const PlaychainSettings& settings)
+    {
+        if (settings.lenient_json_decoding)
+            return json_decode_mode::lenient;
+        return settings.unique_json_keys ? json_decode_mode::unique : json_decode_mode::strict;
+    }
+
+    //64-bit amounts are encoded as strings by node
+    template <typename TJsonValue>
+    PlaychainMoney parse_amount_string(const TJsonValue& js_amount)
+    {
+        const char* str = js_amount.GetString();
+
+        uint64_t result = 0;
+        PLAYCHAIN_ASSERT_JSON(parse_uint64(str, str + js_amount.GetStringLength(), result));
+        return result;
+    }
 
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("amount"));
-        PLAYCHAIN_ASSERT_JSON(js_object["amount"].IsInt64() || js_object["amount"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("asset_id"));
+    template <typename TJsonValue>
+    PlaychainMoney parse_amount(const TJsonValue& js_amount)
+    {
+        PLAYCHAIN_ASSERT_JSON(js_amount.IsInt64() || js_amount.IsString());
 
-        PlaychainAssetId asset_id = parse_id<PlaychainAssetId>(js_object["asset_id"], settings);
-        PLAYCHAIN_ASSERT_JSON(asset_id == settings.asset_id);
+        if (js_amount.IsInt64())
+            return js_amount.GetInt64();
+
+        return parse_amount_string(js_amount);
+    }
 
-        if (js_object["amount"].IsInt64())
-            return js_object["amount"].GetInt64();
+    enum asset_field : size_t
+    {
+        asset_amount = 0,
+        asset_asset_id,
+        asset_fields_count
+    };
+
+    constexpr json_key asset_keys[asset_fields_count] = { "amount", "asset_id" };
+
+    template <typename TJsonObject>
+    PlaychainMoney parse_asset(TJsonObject&& js_object, const PlaychainSettings& settings)
+    {
+        PlaychainMoney result = 0;
+
+        decode_json_object(js_object, asset_keys, json_fields_below(asset_fields_count), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               switch (field)
+                               {
+                               case asset_amount:
+                                   result = parse_amount(js_value);
+                                   break;
+                               case asset_asset_id:
+                                   PLAYCHAIN_ASSERT_JSON(parse_id<PlaychainAssetId>(js_value, settings) == settings.asset_id);
+                                   break;
+                               default:;
+                               }
+                           });
 
-#if !defined(PLAYCHAIN_LIB_FOR_MOBILE)
-        return std::atoll(js_object["amount"].GetString());
-#else //< !PLAYCHAIN_LIB_FOR_MOBILE
-        char* pEnd;
-        auto r = strtoull(js_object["amount"].GetString(), &pEnd, 10);
-        PLAYCHAIN_ASSERT_JSON(r >= 0);
-        return (uint64_t)r;
-#endif //< PLAYCHAIN_LIB_FOR_MOBILE
+        return result;
     }
 
     template <typename TJsonObject>
@@ -64,36 +135,55 @@ namespace {
         PLAYCHAIN_ASSERT_JSON(js_object.IsInt64() || js_object.IsString());
 
         if (js_object.IsInt64())
-            return js_object.IsInt64();
+            return js_object.GetInt64();
 
-#if !defined(PLAYCHAIN_LIB_FOR_MOBILE)
-        return std::atoll(js_object.GetString());
-#else //< !PLAYCHAIN_LIB_FOR_MOBILE
-        char* pEnd;
-        auto r = strtoull(js_object.GetString(), &pEnd, 10);
-        PLAYCHAIN_ASSERT_JSON(r >= 0);
-        return (uint64_t)r;
-#endif //< PLAYCHAIN_LIB_FOR_MOBILE
+        return parse_amount_string(js_object);
     }
 
-    template <typename TJsonObject>
-    PlaychainPendingBuyinInfo parse_pending_buyin_info(TJsonObject&& js_object, const PlaychainSettings& settings)
+    enum pending_buyin_field : size_t
     {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+        pending_buyin_name = 0,
+        pending_buyin_id,
+        pending_buyin_uid,
+        pending_buyin_amount,
+        pending_buyin_fields_count
+    };
 
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("name"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("id"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("uid"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("amount"));
-
-        PlaychainPendingBuyinInfo result;
+    constexpr json_key pending_buyin_keys[pending_buyin_fields_count] = { "name", "id", "uid", "amount" };
 
-        result.name = js_object["name"].GetString();
-        result.id = parse_id<PlaychainPendingBuyinId>(js_object["id"], settings);
-        result.uid = js_object["uid"].GetString();
-        result.amount = parse_asset(js_object["amount"], settings);
+    //keeps capacity of strings for decoding into reused object
+    void clear_for_decoding(PlaychainPendingBuyinInfo& info)
+    {
+        info.name.clear();
+        info.id = PlaychainPendingBuyinId {};
+        info.uid.clear();
+        info.amount = 0;
+    }
 
-        return result;
+    template <typename TJsonObject>
+    void decode_pending_buyin_info(TJsonObject&& js_object, PlaychainPendingBuyinInfo& result, const PlaychainSettings& settings)
+    {
+        clear_for_decoding(result);
+
+        decode_json_object(js_object, pending_buyin_keys, json_fields_below(pending_buyin_fields_count), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               switch (field)
+                               {
+                               case pending_buyin_name:
+                                   decode_json_string(js_value, result.name);
+                                   break;
+                               case pending_buyin_id:
+                                   result.id = parse_id<PlaychainPendingBuyinId>(js_value, settings);
+                                   break;
+                               case pending_buyin_uid:
+                                   decode_json_string(js_value, result.uid);
+                                   break;
+                               case pending_buyin_amount:
+                                   result.amount = parse_asset(js_value, settings);
+                                   break;
+                               default:;
+                               }
+                           });
     }
 
     PlaychainTableInfo::State parse_table_state(const std::string& state)
@@ -130,221 +220,570 @@ namespace {
         return result;
     }
 
-    template <typename TableObject, typename TJsonObject>
-    TableObject parse_table_impl(TJsonObject&& js_object, const PlaychainSettings& settings)
+    //table fields in node serialization order,
+    //PlaychainTableInfoExt fields follow PlaychainTableInfo ones
+    enum table_field : size_t
+    {
+        table_id = 0,
+        table_metadata,
+        table_required_witnesses,
+        table_owner,
+        table_owner_name,
+        table_state,
+        table_server_url,
+        table_min_accepted_proposal_asset,
+        table_base_fields_count,
+        table_pending_proposals = table_base_fields_count,
+        table_cash,
+        table_playing_cash,
+        table_missed_voters,
+        table_fields_count
+    };
+
+    constexpr json_key table_keys[table_fields_count] = {
+        "id",
+        "metadata",
+        "required_witnesses",
+        "owner",
+        "owner_name",
+        "state",
+        "server_url",
+        "min_accepted_proposal_asset",
+        "pending_proposals",
+        "cash",
+        "playing_cash",
+        "missed_voters",
+    };
+
+    template <typename TJsonValue>
+    void parse_table_field(PlaychainTableInfo& result, const size_t field, const TJsonValue& js_value, const PlaychainSettings& settings)
+    {
+        switch (field)
+        {
+        case table_id:
+            result.id = parse_id<PlaychainTableId>(js_value, settings);
+            break;
+        case table_metadata:
+            decode_json_string(js_value, result.metadata);
+            PLAYCHAIN_ASSERT_JSON(!result.metadata.empty());
+            break;
+        case table_required_witnesses:
+            PLAYCHAIN_ASSERT_JSON(js_value.IsInt());
+            result.required_witnesses = (uint16_t)js_value.GetInt();
+            break;
+        case table_owner:
+            result.owner = parse_id<PlaychainUserId>(js_value, settings);
+            break;
+        case table_owner_name:
+            decode_json_string(js_value, result.owner_name);
+            break;
+        case table_state:
+            PLAYCHAIN_ASSERT_JSON(js_value.IsString());
+            result.state = parse_table_state(js_value.GetString());
+            break;
+        case table_server_url:
+            decode_json_string(js_value, result.server_url);
+            break;
+        case table_min_accepted_proposal_asset:
+            result.min_accepted_proposal_asset = parse_asset(js_value, settings);
+            break;
+        default:;
+        }
+    }
+
+    void clear_for_decoding(PlaychainTableInfo& info)
     {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+        info.id = PlaychainTableId {};
+        info.owner = PlaychainUserId {};
+        info.owner_name.clear();
+        info.metadata.clear();
+        info.server_url.clear();
+        info.required_witnesses = 0;
+        info.min_accepted_proposal_asset = 0;
+        info.state = PlaychainTableInfo::State::NOP;
+    }
 
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("id"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("required_witnesses"));
-        PLAYCHAIN_ASSERT_JSON(js_object["required_witnesses"].IsInt());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("min_accepted_proposal_asset"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("state"));
-        PLAYCHAIN_ASSERT_JSON(js_object["state"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("owner"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("owner_name"));
-        PLAYCHAIN_ASSERT_JSON(js_object["owner_name"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("server_url"));
-        PLAYCHAIN_ASSERT_JSON(js_object["server_url"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("metadata"));
-        PLAYCHAIN_ASSERT_JSON(js_object["metadata"].IsString());
-
-        TableObject result;
-
-        result.id = parse_id<PlaychainTableId>(js_object["id"], settings);
-        result.owner = parse_id<PlaychainUserId>(js_object["owner"], settings);
-        result.owner_name = js_object["owner_name"].GetString();
-        result.required_witnesses = (uint16_t)js_object["required_witnesses"].GetInt();
-        result.min_accepted_proposal_asset = parse_asset(js_object["min_accepted_proposal_asset"], settings);
-        result.state = parse_table_state(js_object["state"].GetString());
-        result.metadata = js_object["metadata"].GetString();
-        PLAYCHAIN_ASSERT_JSON(!result.metadata.empty());
-        result.server_url = js_object["server_url"].GetString();
+    template <typename TJsonObject>
+    void decode_table(TJsonObject&& js_object, PlaychainTableInfo& result, const PlaychainSettings& settings)
+    {
+        clear_for_decoding(result);
 
-        return result;
+        decode_json_object(js_object, table_keys, table_base_fields_count, json_fields_below(table_base_fields_count), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               parse_table_field(result, field, js_value, settings);
+                           });
     }
 
     template <typename TJsonObject>
     PlaychainTableInfo parse_table(TJsonObject&& js_object, const PlaychainSettings& settings)
     {
-        return parse_table_impl<PlaychainTableInfo>(js_object, settings);
+        PlaychainTableInfo result;
+        decode_table(js_object, result, settings);
+        return result;
     }
 
-    template <typename TJsonObject>
-    PlaychainPlayerTableInfo parse_player_table(TJsonObject&& js_object, const PlaychainSettings& settings)
+    enum player_table_field : size_t
     {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+        player_table_state = 0,
+        player_table_balance,
+        player_table_buyouting_balance,
+        player_table_table,
+        player_table_fields_count
+    };
 
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("state"));
-        PLAYCHAIN_ASSERT_JSON(js_object["state"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("balance"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("buyouting_balance"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("table"));
-        PLAYCHAIN_ASSERT_JSON(js_object["table"].IsObject());
+    constexpr json_key player_table_keys[player_table_fields_count] = { "state", "balance", "buyouting_balance", "table" };
 
+    template <typename TJsonObject>
+    PlaychainPlayerTableInfo parse_player_table(TJsonObject&& js_object, const PlaychainSettings& settings)
+    {
         PlaychainPlayerTableInfo result;
 
-        result.state = parse_player_table_state(js_object["state"].GetString());
-        result.balance = parse_asset(js_object["balance"], settings);
-        result.buyouting_balance = parse_asset(js_object["buyouting_balance"], settings);
-        result.table = parse_table(js_object["table"], settings);
+        decode_json_object(js_object, player_table_keys, json_fields_below(player_table_fields_count), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               switch (field)
+                               {
+                               case player_table_state:
+                                   PLAYCHAIN_ASSERT_JSON(js_value.IsString());
+                                   result.state = parse_player_table_state(js_value.GetString());
+                                   break;
+                               case player_table_balance:
+                                   result.balance = parse_asset(js_value, settings);
+                                   break;
+                               case player_table_buyouting_balance:
+                                   result.buyouting_balance = parse_asset(js_value, settings);
+                                   break;
+                               case player_table_table:
+                                   result.table = parse_table(js_value, settings);
+                                   break;
+                               default:;
+                               }
+                           });
 
         return result;
     }
 
-    template <typename TJsonObject>
-    CashInfo parse_cash_info(TJsonObject&& js_object, const PlaychainSettings& settings)
+    enum cash_field : size_t
     {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
-
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("name"));
-        PLAYCHAIN_ASSERT_JSON(js_object["name"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("amount"));
-
-        CashInfo result;
+        cash_name = 0,
+        cash_amount,
+        cash_fields_count
+    };
 
-        result.name = js_object["name"].GetString();
-        result.amount = parse_asset(js_object["amount"], settings);
+    constexpr json_key cash_keys[cash_fields_count] = { "name", "amount" };
 
-        return result;
+    void clear_for_decoding(CashInfo& info)
+    {
+        info.name.clear();
+        info.amount = 0;
     }
 
     template <typename TJsonObject>
-    PlaychainTableInfoExt parse_table_ext(TJsonObject&& js_object, const PlaychainSettings& settings)
-    {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+    void decode_cash_info(TJsonObject&& js_object, CashInfo& result, const PlaychainSettings& settings)
+    {
+        clear_for_decoding(result);
+
+        decode_json_object(js_object, cash_keys, json_fields_below(cash_fields_count), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               switch (field)
+                               {
+                               case cash_name:
+                                   decode_json_string(js_value, result.name);
+                                   break;
+                               case cash_amount:
+                                   result.amount = parse_asset(js_value, settings);
+                                   break;
+                               default:;
+                               }
+                           });
+    }
+
+    /* Updates map from stream of keys in ascending order.
+     * Nodes with the same keys are reused, nodes with keys
+     * that are not in stream are erased when updater is destroyed.
+     * Keys out of order are also accepted but cause new nodes.
+    */
+    template <typename Map>
+    class map_updater
+    {
+    public:
+        explicit map_updater(Map& map)
+            : _map(map)
+            , _it(map.begin())
+        {
+        }
 
-        PlaychainTableInfoExt result = parse_table_impl<PlaychainTableInfoExt>(js_object, settings);
+        ~map_updater()
+        {
+            _map.erase(_it, _map.end());
+        }
 
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("pending_proposals"));
-        PLAYCHAIN_ASSERT_JSON(js_object["pending_proposals"].IsArray());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("cash"));
-        PLAYCHAIN_ASSERT_JSON(js_object["cash"].IsArray());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("playing_cash"));
-        PLAYCHAIN_ASSERT_JSON(js_object["playing_cash"].IsArray());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("missed_voters"));
-        PLAYCHAIN_ASSERT_JSON(js_object["missed_voters"].IsArray());
+        map_updater(const map_updater&) = delete;
+        map_updater& operator=(const map_updater&) = delete;
 
+        typename Map::mapped_type& at(const typename Map::key_type& key)
         {
-            for (const auto& item : js_object["pending_proposals"].GetArray())
-            {
-                PLAYCHAIN_ASSERT_JSON(item.IsArray());
-
-                auto&& js_array = item.GetArray();
+            while (_it != _map.end() && _map.key_comp()(_it->first, key))
+                _it = _map.erase(_it);
 
-                PLAYCHAIN_ASSERT_JSON(js_array.Size() == 2u);
+            if (_it != _map.end() && !_map.key_comp()(key, _it->first))
+                return (_it++)->second;
 
-                result.pending_proposals.emplace(std::make_pair(parse_id<PlaychainUserId>(js_array[0], settings), parse_pending_buyin_info(js_array[1], settings)));
-            }
+            return _map.emplace_hint(_it, key, typename Map::mapped_type {})->second;
         }
 
+        //for string keys to compare without key copy
+        typename Map::mapped_type& at(const char* key, const size_t length)
         {
-            for (const auto& item : js_object["cash"].GetArray())
-            {
-                PLAYCHAIN_ASSERT_JSON(item.IsArray());
+            while (_it != _map.end() && _it->first.compare(0, std::string::npos, key, length) < 0)
+                _it = _map.erase(_it);
 
-                auto&& js_array = item.GetArray();
+            if (_it != _map.end() && _it->first.compare(0, std::string::npos, key, length) == 0)
+                return (_it++)->second;
 
-                PLAYCHAIN_ASSERT_JSON(js_array.Size() == 2u);
-
-                result.cash.emplace(std::make_pair(parse_id<PlaychainUserId>(js_array[0], settings), parse_cash_info(js_array[1], settings)));
-            }
+            return _map.emplace_hint(_it, std::string { key, length }, typename Map::mapped_type {})->second;
         }
 
-        {
-            for (const auto& item : js_object["playing_cash"].GetArray())
-            {
-                PLAYCHAIN_ASSERT_JSON(item.IsArray());
+    private:
+        Map& _map;
+        typename Map::iterator _it;
+    };
 
-                auto&& js_array = item.GetArray();
+    /* Updates vector items in place keeping their capacity.
+     * Items that are not updated are erased by finish().
+    */
+    template <typename T>
+    class vector_updater
+    {
+    public:
+        explicit vector_updater(std::vector<T>& vector)
+            : _vector(vector)
+        {
+        }
 
-                PLAYCHAIN_ASSERT_JSON(js_array.Size() == 2u);
+        T& next()
+        {
+            if (_size < _vector.size())
+                return _vector[_size++];
 
-                result.playing_cash.emplace(std::make_pair(parse_id<PlaychainUserId>(js_array[0], settings), parse_cash_info(js_array[1], settings)));
-            }
+            _vector.emplace_back();
+            ++_size;
+            return _vector.back();
         }
 
+        void finish()
         {
-            for (const auto& item : js_object["missed_voters"].GetArray())
-            {
-                PLAYCHAIN_ASSERT_JSON(item.IsArray());
+            _vector.erase(_vector.begin() + _size, _vector.end());
+        }
 
-                auto&& js_array = item.GetArray();
+    private:
+        std::vector<T>& _vector;
+        size_t _size = 0;
+    };
 
-                PLAYCHAIN_ASSERT_JSON(js_array.Size() == 2u);
+    //[[id, object], ...]
+    template <typename TJsonArray, typename Handler>
+    void parse_id_pairs(const TJsonArray& js_array, Handler&& handler)
+    {
+        PLAYCHAIN_ASSERT_JSON(js_array.IsArray());
 
-                PLAYCHAIN_ASSERT_JSON(js_array[1].IsString());
+        for (const auto& item : js_array.GetArray())
+        {
+            PLAYCHAIN_ASSERT_JSON(item.IsArray());
+            PLAYCHAIN_ASSERT_JSON(item.Size() == 2u);
 
-                result.missed_voters.emplace(std::make_pair(parse_id<PlaychainUserId>(js_array[0], settings), js_array[1].GetString()));
-            }
+            handler(item[0], item[1]);
         }
+    }
 
-        return result;
+    static_assert(PlaychainTableFields::ID == json_field_bit(table_id)
+                      && PlaychainTableFields::METADATA == json_field_bit(table_metadata)
+                      && PlaychainTableFields::REQUIRED_WITNESSES == json_field_bit(table_required_witnesses)
+                      && PlaychainTableFields::OWNER == json_field_bit(table_owner)
+                      && PlaychainTableFields::OWNER_NAME == json_field_bit(table_owner_name)
+                      && PlaychainTableFields::STATE == json_field_bit(table_state)
+                      && PlaychainTableFields::SERVER_URL == json_field_bit(table_server_url)
+                      && PlaychainTableFields::MIN_ACCEPTED_PROPOSAL_ASSET == json_field_bit(table_min_accepted_proposal_asset)
+                      && PlaychainTableFields::PENDING_PROPOSALS == json_field_bit(table_pending_proposals)
+                      && PlaychainTableFields::CASH == json_field_bit(table_cash)
+                      && PlaychainTableFields::PLAYING_CASH == json_field_bit(table_playing_cash)
+                      && PlaychainTableFields::MISSED_VOTERS == json_field_bit(table_missed_voters)
+                      && PlaychainTableFields::ALL == json_fields_below(table_fields_count),
+                  "PlaychainTableFields must match table keys");
+
+    //table members that are not requested are skipped by SAX reader
+    json_projection table_projection(const PlaychainTableFieldsMask fields)
+    {
+        return { table_keys, table_fields_count, fields & json_fields_below(table_fields_count) };
     }
 
-    template <typename RoomObject, typename TJsonObject>
-    RoomObject parse_room_impl_base(TJsonObject&& js_object, const PlaychainSettings& settings)
+    //valid() for requested fields
+    void check_table(const PlaychainTableInfo& table, const PlaychainTableFieldsMask fields)
     {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+        PLAYCHAIN_ASSERT_JSON(!(fields & PlaychainTableFields::ID) || table.id.valid());
+        PLAYCHAIN_ASSERT_JSON(!(fields & PlaychainTableFields::OWNER) || table.owner.valid());
+    }
 
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("id"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("owner"));
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("server_url"));
-        PLAYCHAIN_ASSERT_JSON(js_object["server_url"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("metadata"));
-        PLAYCHAIN_ASSERT_JSON(js_object["metadata"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("rating"));
-        PLAYCHAIN_ASSERT_JSON(js_object["rating"].IsInt());
-
-        RoomObject result;
-
-        result.id = parse_id<PlaychainRoomId>(js_object["id"], settings);
-        result.owner = parse_id<PlaychainUserId>(js_object["owner"], settings);
-        result.metadata = js_object["metadata"].GetString();
-        result.server_url = js_object["server_url"].GetString();
-        result.rating = js_object["rating"].GetInt();
+    //maps reuse nodes of result, items that are absent in JSON are erased
+    template <typename TJsonValue>
+    void decode_pending_proposals(const TJsonValue& js_value, PlaychainTableInfoExt::PendingBuyinsType& result, const PlaychainSettings& settings)
+    {
+        map_updater<PlaychainTableInfoExt::PendingBuyinsType> proposals { result };
 
-        return result;
+        parse_id_pairs(js_value, [&](const rapidjson::Value& js_id, const rapidjson::Value& js_info) {
+            decode_pending_buyin_info(js_info, proposals.at(parse_id<PlaychainUserId>(js_id, settings)), settings);
+        });
+    }
+
+    template <typename TJsonValue>
+    void decode_cash_map(const TJsonValue& js_value, PlaychainTableInfoExt::CashDatasType& result, const PlaychainSettings& settings)
+    {
+        map_updater<PlaychainTableInfoExt::CashDatasType> cash { result };
+
+        parse_id_pairs(js_value, [&](const rapidjson::Value& js_id, const rapidjson::Value& js_info) {
+            decode_cash_info(js_info, cash.at(parse_id<PlaychainUserId>(js_id, settings)), settings);
+        });
     }
 
-    template <typename RoomObject, typename TJsonObject>
-    RoomObject parse_room_impl(TJsonObject&& js_object, const PlaychainSettings& settings)
+    template <typename TJsonValue>
+    void decode_accounts_map(const TJsonValue& js_value, PlaychainTableInfoExt::AccountsType& result, const PlaychainSettings& settings)
     {
-        RoomObject result = parse_room_impl_base<RoomObject>(js_object, settings);
+        map_updater<PlaychainTableInfoExt::AccountsType> accounts { result };
 
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("owner_name"));
-        PLAYCHAIN_ASSERT_JSON(js_object["owner_name"].IsString());
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("protocol_version"));
-        PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"].IsString());
+        parse_id_pairs(js_value, [&](const rapidjson::Value& js_id, const rapidjson::Value& js_name) {
+            decode_json_string(js_name, accounts.at(parse_id<PlaychainUserId>(js_id, settings)));
+        });
+    }
 
-        result.owner_name = js_object["owner_name"].GetString();
-        result.protocol_version = ProtocolVersion(js_object["protocol_version"].GetString());
+    //reuses map nodes and strings of result,
+    //fields that are not in mask are not required
+    template <typename TJsonObject>
+    void decode_table_ext(TJsonObject&& js_object, PlaychainTableInfoExt& result, const PlaychainSettings& settings,
+                          const PlaychainTableFieldsMask fields = PlaychainTableFields::ALL)
+    {
+        clear_for_decoding(result);
+
+        json_fields_mask decoded = decode_json_object(js_object, table_keys, fields & json_fields_below(table_fields_count), json_mode(settings),
+                                                      [&](const size_t field, const rapidjson::Value& js_value) {
+                                                          switch (field)
+                                                          {
+                                                          case table_pending_proposals:
+                                                              decode_pending_proposals(js_value, result.pending_proposals, settings);
+                                                              break;
+                                                          case table_cash:
+                                                              decode_cash_map(js_value, result.cash, settings);
+                                                              break;
+                                                          case table_playing_cash:
+                                                              decode_cash_map(js_value, result.playing_cash, settings);
+                                                              break;
+                                                          case table_missed_voters:
+                                                              decode_accounts_map(js_value, result.missed_voters, settings);
+                                                              break;
+                                                          default:
+                                                              parse_table_field(result, field, js_value, settings);
+                                                          }
+                                                      });
+
+        if (!(decoded & json_field_bit(table_pending_proposals)))
+            result.pending_proposals.clear();
+        if (!(decoded & json_field_bit(table_cash)))
+            result.cash.clear();
+        if (!(decoded & json_field_bit(table_playing_cash)))
+            result.playing_cash.clear();
+        if (!(decoded & json_field_bit(table_missed_voters)))
+            result.missed_voters.clear();
+    }
+
+    //room fields in node serialization order
+    enum room_field : size_t
+    {
+        room_id = 0,
+        room_owner,
+        room_owner_name,
+        room_metadata,
+        room_server_url,
+        room_protocol_version,
+        room_rating,
+        room_last_rating_update,
+        room_rake_balance,
+        room_rake_balance_id,
+        room_fields_count
+    };
+
+    constexpr json_key room_keys[room_fields_count] = {
+        "id",
+        "owner",
+        "owner_name",
+        "metadata",
+        "server_url",
+        "protocol_version",
+        "rating",
+        "last_rating_update",
+        "rake_balance",
+        "rake_balance_id",
+    };
+
+    constexpr json_fields_mask room_base_required = json_field_bit(room_id) | json_field_bit(room_owner) | json_field_bit(room_metadata) | json_field_bit(room_server_url) | json_field_bit(room_rating);
+    constexpr json_fields_mask room_required = room_base_required | json_field_bit(room_owner_name) | json_field_bit(room_protocol_version);
+    constexpr json_fields_mask room_ext_required = room_required | json_field_bit(room_last_rating_update) | json_field_bit(room_rake_balance);
+
+    template <typename TJsonValue>
+    void parse_room_base_field(PlaychainRoomInfo& result, const size_t field, const TJsonValue& js_value, const PlaychainSettings& settings)
+    {
+        switch (field)
+        {
+        case room_id:
+            result.id = parse_id<PlaychainRoomId>(js_value, settings);
+            break;
+        case room_owner:
+            result.owner = parse_id<PlaychainUserId>(js_value, settings);
+            break;
+        case room_metadata:
+            decode_json_string(js_value, result.metadata);
+            break;
+        case room_server_url:
+            decode_json_string(js_value, result.server_url);
+            break;
+        case room_rating:
+            PLAYCHAIN_ASSERT_JSON(js_value.IsInt());
+            result.rating = js_value.GetInt();
+            break;
+        default:;
+        }
+    }
 
+    template <typename TJsonValue>
+    void parse_room_field(PlaychainRoomInfo& result, const size_t field, const TJsonValue& js_value, const PlaychainSettings& settings)
+    {
+        switch (field)
+        {
+        case room_owner_name:
+            decode_json_string(js_value, result.owner_name);
+            break;
+        case room_protocol_version:
+            PLAYCHAIN_ASSERT_JSON(js_value.IsString());
+            result.protocol_version = ProtocolVersion(js_value.GetString());
+            break;
+        default:
+            parse_room_base_field(result, field, js_value, settings);
+        }
+    }
+
+    template <typename TJsonValue>
+    void parse_room_ext_field(PlaychainRoomInfoExt& result, const size_t field, const TJsonValue& js_value, const PlaychainSettings& settings)
+    {
+        switch (field)
+        {
+        case room_last_rating_update:
+            decode_json_string(js_value, result.last_rating_update_utc);
+            break;
+        case room_rake_balance:
+            result.rake_balance = parse_asset(js_value, settings);
+            break;
+        case room_rake_balance_id:
+            if (js_value.IsString())
+            {
+                result.rake_balance_id = parse_id<PlaychainVestingBalanceId>(js_value, settings);
+            }
+            break;
+        default:
+            parse_room_field(result, field, js_value, settings);
+        }
+    }
+
+    enum protocol_version_field : size_t
+    {
+        protocol_version_metadata = 0,
+        protocol_version_base,
+        protocol_version_fields_count
+    };
+
+    constexpr json_key protocol_version_keys[protocol_version_fields_count] = { "metadata", "base" };
+
+    constexpr json_key protocol_version_base_keys[] = { "v_num" };
+
+    //{"metadata": "...", "base": {"v_num": N}} as it is in room object
+    template <typename TJsonObject>
+    void decode_protocol_version_object(TJsonObject&& js_object, ProtocolVersion& result, const PlaychainSettings& settings)
+    {
+        result.v_num = 0;
+        result.metadata.clear();
+
+        decode_json_object(js_object, protocol_version_keys, json_fields_below(protocol_version_fields_count), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               switch (field)
+                               {
+                               case protocol_version_metadata:
+                                   decode_json_string(js_value, result.metadata);
+                                   break;
+                               case protocol_version_base:
+                                   decode_json_object(js_value, protocol_version_base_keys, json_fields_below(1), json_mode(settings),
+                                                      [&](const size_t, const rapidjson::Value& js_v_num) {
+                                                          PLAYCHAIN_ASSERT_JSON(js_v_num.IsUint());
+                                                          result.v_num = js_v_num.GetUint();
+                                                      });
+                                   break;
+                               default:;
+                               }
+                           });
+    }
+
+    void clear_for_decoding(PlaychainRoomInfo& info)
+    {
+        info.id = PlaychainRoomId {};
+        info.owner = PlaychainUserId {};
+        info.owner_name.clear();
+        info.server_url.clear();
+        info.metadata.clear();
+        info.rating = 0;
+        info.protocol_version.v_num = 0;
+        info.protocol_version.metadata.clear();
+    }
+
+    //room object from list_rooms where protocol version is not formatted
+    template <typename TJsonObject>
+    void decode_room_object(TJsonObject&& js_object, PlaychainRoomInfo& result, const PlaychainSettings& settings)
+    {
+        clear_for_decoding(result);
+
+        decode_json_object(js_object, room_keys, room_base_required | json_field_bit(room_protocol_version), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               if (field == room_protocol_version)
+                                   decode_protocol_version_object(js_value, result.protocol_version, settings);
+                               else
+                                   parse_room_base_field(result, field, js_value, settings);
+                           });
+    }
+
+    template <typename TJsonObject>
+    PlaychainRoomInfo parse_room_object(TJsonObject&& js_object, const PlaychainSettings& settings)
+    {
+        PlaychainRoomInfo result;
+        decode_room_object(js_object, result, settings);
         return result;
     }
 
     template <typename TJsonObject>
     PlaychainRoomInfo parse_room(TJsonObject&& js_object, const PlaychainSettings& settings)
     {
-        return parse_room_impl<PlaychainRoomInfo>(js_object, settings);
+        PlaychainRoomInfo result;
+
+        decode_json_object(js_object, room_keys, room_required, json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               parse_room_field(result, field, js_value, settings);
+                           });
+
+        return result;
     }
 
     template <typename TJsonObject>
     PlaychainRoomInfoExt parse_room_ext(TJsonObject&& js_object, const PlaychainSettings& settings)
     {
-        PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+        PlaychainRoomInfoExt result;
 
-        PlaychainRoomInfoExt result = parse_room_impl<PlaychainRoomInfoExt>(js_object, settings);
-
-        PLAYCHAIN_ASSERT_JSON(js_object.HasMember("last_rating_update"));
-        PLAYCHAIN_ASSERT_JSON(js_object["last_rating_update"].IsString());
-
-        result.last_rating_update_utc = js_object["last_rating_update"].GetString();
-        result.rake_balance = parse_asset(js_object["rake_balance"], settings);
-        if (js_object.HasMember("rake_balance_id") && js_object["rake_balance_id"].IsString())
-        {
-            result.rake_balance_id = parse_id<PlaychainVestingBalanceId>(js_object["rake_balance_id"], settings);
-        }
+        decode_json_object(js_object, room_keys, room_ext_required, json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               parse_room_ext_field(result, field, js_value, settings);
+                           });
 
         return result;
     }
@@ -471,10 +910,10 @@ namespace {
         settings.block_interval_sec = js_object["block_interval"].GetInt();
     }
 
-    void parse_blockchain_settings(const BlockchainResponse& response, PlaychainSettings& settings)
+    void parse_blockchain_settings(const BlockchainResponseView& response, PlaychainSettings& settings)
     {
         rapidjson::Document document;
-        document.Parse(response.c_str());
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
@@ -488,10 +927,10 @@ namespace {
         parse_blockchain_options(js_object["parameters"], settings);
     }
 
-    void parse_playchain_settings(const BlockchainResponse& response, PlaychainSettings& settings)
+    void parse_playchain_settings(const BlockchainResponseView& response, PlaychainSettings& settings)
     {
         rapidjson::Document document;
-        document.Parse(response.c_str());
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
@@ -552,6 +991,307 @@ namespace {
 
         return result;
     }
+    constexpr json_key object_id_keys[] = { "id" };
+
+    //object from list where only id is used
+    template <typename Id, typename TJsonObject>
+    Id parse_object_id(TJsonObject&& js_object, const PlaychainSettings& settings)
+    {
+        Id result;
+
+        decode_json_object(js_object, object_id_keys, json_fields_below(1), json_mode(settings),
+                           [&](const size_t, const rapidjson::Value& js_value) {
+                               result = parse_id<Id>(js_value, settings);
+                           });
+
+        return result;
+    }
+
+    enum account_field : size_t
+    {
+        account_id = 0,
+        account_name,
+        account_fields_count
+    };
+
+    constexpr json_key account_keys[account_fields_count] = { "id", "name" };
+
+    template <typename TJsonObject>
+    BlockchainAccount parse_blockchain_account(TJsonObject&& js_object, const PlaychainSettings& settings)
+    {
+        BlockchainAccount result;
+
+        decode_json_object(js_object, account_keys, json_fields_below(account_fields_count), json_mode(settings),
+                           [&](const size_t field, const rapidjson::Value& js_value) {
+                               switch (field)
+                               {
+                               case account_id:
+                                   result.id = parse_id<PlaychainUserId>(js_value, settings);
+                                   break;
+                               case account_name:
+                                   decode_json_string(js_value, result.name);
+                                   break;
+                               default:;
+                               }
+                           });
+
+        return result;
+    }
+
+    //streams elements of array at path filling envelope on the way, throws if JSON is malformed
+    template <size_t PathLength, typename OnElement>
+    void stream_array(PlaychainParseArena& arena, const BlockchainResponseView& response,
+                      const json_path_step (&path)[PathLength], const json_projection& projection,
+                      json_envelope& envelope, OnElement&& on_element)
+    {
+        json_stream_lease lease { arena };
+
+        if (response.insitu())
+        {
+            rapidjson::InsituStringStream stream(response.insitu_buffer());
+            stream_json_array<rapidjson::kParseInsituFlag>(lease.reader(), lease.element(), stream, path, projection, envelope, on_element);
+            //embedded null character ends stream
+            PLAYCHAIN_ASSERT_JSON(stream.Tell() == response.size());
+            return;
+        }
+        if (response.null_terminated())
+        {
+            rapidjson::StringStream stream(response.data());
+            stream_json_array<rapidjson::kParseDefaultFlags>(lease.reader(), lease.element(), stream, path, projection, envelope, on_element);
+            PLAYCHAIN_ASSERT_JSON(stream.Tell() == response.size());
+            return;
+        }
+
+        rapidjson::MemoryStream memory(response.data(), response.size());
+        rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> stream(memory);
+        stream_json_array<rapidjson::kParseDefaultFlags>(lease.reader(), lease.element(), stream, path, projection, envelope, on_element);
+        PLAYCHAIN_ASSERT_JSON(stream.Tell() == response.size());
+    }
+
+    //streams elements of array at path, throws if JSON is malformed
+    template <size_t PathLength, typename OnElement>
+    json_envelope stream_array(PlaychainParseArena& arena, const BlockchainResponseView& response,
+                               const json_path_step (&path)[PathLength], const json_projection& projection,
+                               OnElement&& on_element)
+    {
+        json_envelope envelope;
+        stream_array(arena, response, path, projection, envelope, std::forward<OnElement>(on_element));
+        return envelope;
+    }
+
+    //method is name of parser for diagnostics
+    template <typename Decode>
+    ParsedResponse<size_t> stream_result_array(const char* method, PlaychainParseArena& arena, const BlockchainResponseView& response,
+                                               const json_projection& projection, Decode&& decode)
+    {
+        try
+        {
+            size_t count = 0;
+
+            json_envelope envelope = stream_array(arena, response, json_result_path, projection, [&](const rapidjson::Value& js_element) {
+                try
+                {
+                    decode(js_element);
+                }
+                catch (const std::exception& e)
+                {
+                    diagnostics::add_json_index(e, count);
+                    diagnostics::add_json_key(e, "result");
+                    throw;
+                }
+                ++count;
+            });
+            if (!envelope.found)
+                return {};
+
+            PLAYCHAIN_ASSERT_JSON(envelope.found_array);
+
+            return { std::move(count) };
+        }
+        catch (std::exception& e)
+        {
+            PLAYCHAIN_METRICS_FAILURE();
+            PLAYCHAIN_TRACE_FAILURE();
+            diagnostics::report(method, e);
+        }
+
+        return {};
+    }
+
+    template <typename Decode>
+    ParsedResponse<size_t> stream_result_array(const char* method, PlaychainParseArena& arena, const BlockchainResponseView& response, Decode&& decode)
+    {
+        return stream_result_array(method, arena, response, json_projection {}, std::forward<Decode>(decode));
+    }
+    //payload of routed message of expected kind,
+    //nullptr for other kind or error response
+    const rapidjson::Value* message_payload(const PlaychainParsedMessage& message, const PlaychainParsedMessage::Kind kind)
+    {
+        if (message.kind() != kind || !message.context())
+            return nullptr;
+        return message.context()->payload;
+    }
+
+    //method is name of parser for diagnostics
+    template <typename Decode>
+    bool decode_message_array(const char* method, const rapidjson::Value* js_array, Decode&& decode)
+    {
+        try
+        {
+            if (!js_array)
+                return false;
+
+            PLAYCHAIN_ASSERT_JSON(js_array->IsArray());
+
+            size_t index = 0;
+            for (const auto& js_element : js_array->GetArray())
+            {
+                try
+                {
+                    decode(js_element);
+                }
+                catch (const std::exception& e)
+                {
+                    diagnostics::add_json_index(e, index);
+                    throw;
+                }
+                ++index;
+            }
+
+            return true;
+        }
+        catch (std::exception& e)
+        {
+            PLAYCHAIN_METRICS_FAILURE();
+            PLAYCHAIN_TRACE_FAILURE();
+            diagnostics::report(method, e);
+        }
+
+        return false;
+    }
+
+    //JSON type of member indexed for lazy view,
+    //content is checked by accessor when member is decoded
+    enum class view_type
+    {
+        any,
+        string,
+        int32,
+        object,
+        array,
+    };
+
+    bool is_view_type(const rapidjson::Value& js_value, const view_type type)
+    {
+        switch (type)
+        {
+        case view_type::string:
+            return js_value.IsString();
+        case view_type::int32:
+            return js_value.IsInt();
+        case view_type::object:
+            return js_value.IsObject();
+        case view_type::array:
+            return js_value.IsArray();
+        default:
+            return true;
+        }
+    }
+
+    constexpr view_type table_view_types[table_fields_count] = {
+        view_type::string, //id
+        view_type::string, //metadata
+        view_type::int32, //required_witnesses
+        view_type::string, //owner
+        view_type::string, //owner_name
+        view_type::string, //state
+        view_type::string, //server_url
+        view_type::object, //min_accepted_proposal_asset
+        view_type::array, //pending_proposals
+        view_type::array, //cash
+        view_type::array, //playing_cash
+        view_type::array, //missed_voters
+    };
+
+    constexpr view_type room_view_types[room_fields_count] = {
+        view_type::string, //id
+        view_type::string, //owner
+        view_type::string, //owner_name
+        view_type::string, //metadata
+        view_type::string, //server_url
+        view_type::object, //protocol_version
+        view_type::int32, //rating
+        view_type::any, //last_rating_update
+        view_type::any, //rake_balance
+        view_type::any, //rake_balance_id
+    };
+
+    //parses "result" array of objects and indexes their members,
+    //only presence of required members and their JSON types are checked,
+    //returns nullptr for error response.
+    //In-situ response is parsed in its buffer, other ones are copied
+    template <size_t N>
+    std::shared_ptr<PlaychainViewDocument> parse_view_document(const BlockchainResponseView& response, const PlaychainSettings& settings,
+                                                               const json_key (&keys)[N], const view_type (&types)[N],
+                                                               const json_fields_mask required)
+    {
+        std::shared_ptr<PlaychainViewDocument> result = std::make_shared<PlaychainViewDocument>();
+
+        rapidjson::Document& document = result->document;
+        if (response.insitu())
+        {
+            parse_document(document, response);
+        }
+        else
+        {
+            result->buffer.reserve(response.size() + 1);
+            result->buffer.assign(response.data(), response.data() + response.size());
+            result->buffer.push_back('\0');
+
+            parse_document(document, BlockchainResponseView::insitu(result->buffer.data(), response.size()));
+        }
+
+        PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
+        if (!document.IsObject() || !document.HasMember("result"))
+            return nullptr;
+
+        const rapidjson::Value& js_result = document["result"];
+        PLAYCHAIN_ASSERT_JSON(js_result.IsArray());
+
+        result->settings = settings;
+        result->fields_count = N;
+        result->objects.reserve(js_result.Size());
+        result->fields.assign(js_result.Size() * N, nullptr);
+
+        for (const auto& js_object : js_result.GetArray())
+        {
+            const rapidjson::Value** fields = result->fields.data() + result->objects.size() * N;
+
+            decode_json_object(js_object, keys, required, json_mode(settings),
+                               [&](const size_t field, const rapidjson::Value& js_value) {
+                                   PLAYCHAIN_ASSERT_JSON(is_view_type(js_value, types[field]));
+                                   fields[field] = &js_value;
+                               });
+
+            result->objects.push_back(&js_object);
+        }
+
+        return result;
+    }
+
+    std::string decode_view_string(const rapidjson::Value* js_value)
+    {
+        std::string result;
+        if (js_value)
+            decode_json_string(*js_value, result);
+        return result;
+    }
+
+    template <typename Id>
+    Id decode_view_id(const rapidjson::Value* js_value, const PlaychainSettings& settings)
+    {
+        return js_value ? parse_id<Id>(*js_value, settings) : Id {};
+    }
 } // namespace
 
 PlaychainResponseParser::PlaychainResponseParser(const PlaychainSettings& settings)
@@ -559,12 +1299,33 @@ PlaychainResponseParser::PlaychainResponseParser(const PlaychainSettings& settin
 {
 }
 
-ParsedResponse<std::string> PlaychainResponseParser::parseGetChainIdResponse(const BlockchainResponse& response)
+void PlaychainResponseParser::setParseArena(const std::shared_ptr<PlaychainParseArena>& arena)
+{
+    m_arena = arena;
+}
+
+PlaychainParseArenaStats PlaychainResponseParser::parseArenaStats() const
 {
+    return arena().stats();
+}
+
+PlaychainParseArena& PlaychainResponseParser::arena() const
+{
+    if (m_arena)
+        return *m_arena;
+    return PlaychainParseArena::threadDefault();
+}
+
+ParsedResponse<std::string> PlaychainResponseParser::parseGetChainIdResponse(const BlockchainResponseView& response)
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { PlaychainParseArena::threadDefault() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
 
@@ -579,59 +1340,84 @@ ParsedResponse<std::string> PlaychainResponseParser::parseGetChainIdResponse(con
 
         return { std::move(result) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<PlaychainTableInfoExt>> PlaychainResponseParser::parseGetTablesInfoResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<PlaychainTableInfoExt>> PlaychainResponseParser::parseGetTablesInfoResponse(const BlockchainResponseView& response) const
 {
-    try
-    {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-        PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
+    std::vector<PlaychainTableInfoExt> data;
 
-        if (!document.HasMember("result"))
-            return {};
-        PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
+    if (!parseGetTablesInfoResponse(response, data))
+        return {};
 
-        PLAYCHAIN_ASSERT_JSON(document["result"].IsArray());
+    return { std::move(data) };
+}
 
-        std::vector<PlaychainTableInfoExt> data;
+bool PlaychainResponseParser::parseGetTablesInfoResponse(const BlockchainResponseView& response, std::vector<PlaychainTableInfoExt>& result,
+                                                         const PlaychainTableFieldsMask fields) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-        auto&& infos = document["result"].GetArray();
+    vector_updater<PlaychainTableInfoExt> tables { result };
 
-        data.reserve(infos.Size());
-        for (const auto& info : infos)
-        {
-            PlaychainTableInfoExt table_object = parse_table_ext(info, m_settings);
+    auto&& decoded = stream_result_array(__func__, arena(), response, table_projection(fields), [&](const rapidjson::Value& js_object) {
+        PlaychainTableInfoExt& table_object = tables.next();
 
-            PLAYCHAIN_ASSERT_JSON(table_object.valid());
+        decode_table_ext(js_object, table_object, m_settings, fields);
 
-            data.emplace_back(table_object);
-        }
+        check_table(table_object, fields);
+    });
+    if (!decoded.valid())
+        return false;
 
-        return { std::move(data) };
-    }
-    catch (std::exception& /*e*/)
-    {
-        //LOG_ERROR(e.what());
-    }
+    tables.finish();
+    return true;
+}
 
-    return {};
+bool PlaychainResponseParser::parseGetTablesInfoResponse(const PlaychainParsedMessage& message, std::vector<PlaychainTableInfoExt>& result,
+                                                         const PlaychainTableFieldsMask fields) const
+{
+    PLAYCHAIN_METRICS_SCOPE("parser");
+    PLAYCHAIN_TRACE_SPAN(PARSE);
+
+    using Kind = PlaychainParsedMessage::Kind;
+
+    vector_updater<PlaychainTableInfoExt> tables { result };
+
+    if (!decode_message_array(__func__, message_payload(message, Kind::RESPONSE), [&](const rapidjson::Value& js_object) {
+            PlaychainTableInfoExt& table_object = tables.next();
+
+            decode_table_ext(js_object, table_object, m_settings, fields);
+
+            check_table(table_object, fields);
+        }))
+        return false;
+
+    tables.finish();
+    return true;
 }
 
-ParsedResponse<PlaychainTableInfo> PlaychainResponseParser::parseCheckIfTableAllocatedForPendingBuyinResponse(const BlockchainResponse& response) const
+ParsedResponse<PlaychainTableInfo> PlaychainResponseParser::parseCheckIfTableAllocatedForPendingBuyinResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
 
@@ -650,20 +1436,26 @@ ParsedResponse<PlaychainTableInfo> PlaychainResponseParser::parseCheckIfTableAll
 
         return { PlaychainTableInfo {} };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<PlaychainPlayerTableInfo>> PlaychainResponseParser::parseListTablesWithPlayerRequest(const BlockchainResponse& response) const
+ParsedResponse<std::vector<PlaychainPlayerTableInfo>> PlaychainResponseParser::parseListTablesWithPlayerRequest(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -687,31 +1479,47 @@ ParsedResponse<std::vector<PlaychainPlayerTableInfo>> PlaychainResponseParser::p
 
         return { std::move(data) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
     return {};
 }
 
-ParsedResponse<std::map<std::string, PlaychainUserId>> PlaychainResponseParser::parseGetAccountIdByNameResponse(const BlockchainResponse& response) const
+ParsedResponse<std::map<std::string, PlaychainUserId>> PlaychainResponseParser::parseGetAccountIdByNameResponse(const BlockchainResponseView& response) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
+    std::map<std::string, PlaychainUserId> data;
+
+    if (!parseGetAccountIdByNameResponse(response, data))
+        return {};
+
+    return { std::move(data) };
+}
+
+bool PlaychainResponseParser::parseGetAccountIdByNameResponse(const BlockchainResponseView& response, std::map<std::string, PlaychainUserId>& result) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
-            return {};
-        PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
+            return false;
         PLAYCHAIN_ASSERT_JSON(document["result"].IsArray());
 
-        std::map<std::string, PlaychainUserId> result;
-
-        auto&& js_object = document["result"].GetArray();
+        map_updater<std::map<std::string, PlaychainUserId>> accounts { result };
 
-        for (const auto& item : js_object)
+        for (const auto& item : document["result"].GetArray())
         {
             PLAYCHAIN_ASSERT_JSON(item.IsArray());
 
@@ -719,25 +1527,51 @@ ParsedResponse<std::map<std::string, PlaychainUserId>> PlaychainResponseParser::
             PLAYCHAIN_ASSERT_JSON(item_p.Size() == 2u);
             PLAYCHAIN_ASSERT_JSON(item_p[0].IsString());
 
-            result.emplace(item_p[0].GetString(), parse_id<PlaychainUserId>(item_p[1], m_settings));
+            accounts.at(item_p[0].GetString(), item_p[0].GetStringLength()) = parse_id<PlaychainUserId>(item_p[1], m_settings);
         }
 
-        return { std::move(result) };
+        return true;
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
-    return {};
+    return false;
+}
+
+bool PlaychainResponseParser::parseGetAccountIdByNameResponse(const PlaychainParsedMessage& message, std::map<std::string, PlaychainUserId>& result) const
+{
+    PLAYCHAIN_METRICS_SCOPE("parser");
+    PLAYCHAIN_TRACE_SPAN(PARSE);
+
+    using Kind = PlaychainParsedMessage::Kind;
+
+    map_updater<std::map<std::string, PlaychainUserId>> accounts { result };
+
+    return decode_message_array(__func__, message_payload(message, Kind::RESPONSE), [&](const rapidjson::Value& item) {
+        PLAYCHAIN_ASSERT_JSON(item.IsArray());
+
+        auto&& item_p = item.GetArray();
+        PLAYCHAIN_ASSERT_JSON(item_p.Size() == 2u);
+        PLAYCHAIN_ASSERT_JSON(item_p[0].IsString());
+
+        accounts.at(item_p[0].GetString(), item_p[0].GetStringLength()) = parse_id<PlaychainUserId>(item_p[1], m_settings);
+    });
 }
 
-ParsedResponse<PlaychainBlockHeaderInfo> PlaychainResponseParser::parseGetLastIrreversibleBlockHeaderResponse(const BlockchainResponse& response) const
+ParsedResponse<PlaychainBlockHeaderInfo> PlaychainResponseParser::parseGetLastIrreversibleBlockHeaderResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -758,24 +1592,30 @@ ParsedResponse<PlaychainBlockHeaderInfo> PlaychainResponseParser::parseGetLastIr
 
         playchain::from_hex(hex_id, info.previous);
 
-        info.timestamp_utc = from_iso_string(js_object["timestamp"].GetString());
+        info.timestamp_utc = parse_time(js_object["timestamp"]);
 
         return { std::move(info) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<PlayerInvitationInfo>> PlaychainResponseParser::parseListPlayerInvitationsResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<PlayerInvitationInfo>> PlaychainResponseParser::parseListPlayerInvitationsResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -791,7 +1631,7 @@ ParsedResponse<std::vector<PlayerInvitationInfo>> PlaychainResponseParser::parse
         PLAYCHAIN_ASSERT(infos_p[1].IsString());
 
         auto&& infos = infos_p[0].GetArray();
-        time_t now_time = from_iso_string(infos_p[1].GetString());
+        time_t now_time = parse_time(infos_p[1]);
 
         std::vector<PlayerInvitationInfo> data;
         data.reserve(infos.Size());
@@ -817,8 +1657,8 @@ ParsedResponse<std::vector<PlayerInvitationInfo>> PlaychainResponseParser::parse
             invitation_object.inviter = parse_id<PlaychainUserId>(js_object["inviter"], m_settings);
             invitation_object.uid = js_object["uid"].GetString();
             invitation_object.metadata = js_object["metadata"].GetString();
-            time_t created_time = from_iso_string(js_object["created"].GetString());
-            time_t expiration_time = from_iso_string(js_object["expiration"].GetString());
+            time_t created_time = parse_time(js_object["created"]);
+            time_t expiration_time = parse_time(js_object["expiration"]);
 
             invitation_object.lifetime_in_sec = expiration_time - created_time;
             invitation_object.lifetime_in_sec_left = expiration_time - now_time;
@@ -828,20 +1668,26 @@ ParsedResponse<std::vector<PlayerInvitationInfo>> PlaychainResponseParser::parse
 
         return { std::move(data) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<InvitedPlayerInfo>> PlaychainResponseParser::parseListInvitedPlayersResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<InvitedPlayerInfo>> PlaychainResponseParser::parseListInvitedPlayersResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -890,20 +1736,26 @@ ParsedResponse<std::vector<InvitedPlayerInfo>> PlaychainResponseParser::parseLis
 
         return { std::move(data) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<PlaychainUserBalanceInfo> PlaychainResponseParser::parseGetPlaychainBalanceResponse(const BlockchainResponse& response) const
+ParsedResponse<PlaychainUserBalanceInfo> PlaychainResponseParser::parseGetPlaychainBalanceResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -942,20 +1794,26 @@ ParsedResponse<PlaychainUserBalanceInfo> PlaychainResponseParser::parseGetPlaych
 
         return { std::move(info) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::pair<PlaychainUserId, CompressedPublicKey>> PlaychainResponseParser::parseLoginResponse(const BlockchainResponse& response) const
+ParsedResponse<std::pair<PlaychainUserId, CompressedPublicKey>> PlaychainResponseParser::parseLoginResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -978,20 +1836,26 @@ ParsedResponse<std::pair<PlaychainUserId, CompressedPublicKey>> PlaychainRespons
             return { std::make_pair(result_id, result_pk) };
         }
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<bool> PlaychainResponseParser::parseTransactionResponse(const BlockchainResponse& response) const
+ParsedResponse<bool> PlaychainResponseParser::parseTransactionResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
 
@@ -1003,20 +1867,40 @@ ParsedResponse<bool> PlaychainResponseParser::parseTransactionResponse(const Blo
 
         return { true };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<bool> PlaychainResponseParser::parseLegacyLoginResponse(const BlockchainResponse& response) const
+ParsedResponse<bool> PlaychainResponseParser::parseTransactionResponse(const PlaychainParsedMessage& message) const
+{
+    PLAYCHAIN_METRICS_SCOPE("parser");
+    PLAYCHAIN_TRACE_SPAN(PARSE);
+
+    using Kind = PlaychainParsedMessage::Kind;
+
+    const rapidjson::Value* js_result = message_payload(message, Kind::RESPONSE);
+    if (!js_result || !js_result->IsNull())
+        return {};
+
+    return { true };
+}
+
+ParsedResponse<bool> PlaychainResponseParser::parseLegacyLoginResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1026,20 +1910,26 @@ ParsedResponse<bool> PlaychainResponseParser::parseLegacyLoginResponse(const Blo
 
         return { document["result"].GetBool() };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<PlaychainMoney> PlaychainResponseParser::parseLegacyGetAccountBalanceResponse(const BlockchainResponse& response) const
+ParsedResponse<PlaychainMoney> PlaychainResponseParser::parseLegacyGetAccountBalanceResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1056,20 +1946,26 @@ ParsedResponse<PlaychainMoney> PlaychainResponseParser::parseLegacyGetAccountBal
 
         return { parse_asset(js_balance_array[0], m_settings) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::map<std::string, PlaychainUserId>> PlaychainResponseParser::parseLegacyGetAccountIdByNameResponse(const BlockchainResponse& response) const
+ParsedResponse<std::map<std::string, PlaychainUserId>> PlaychainResponseParser::parseLegacyGetAccountIdByNameResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1096,20 +1992,26 @@ ParsedResponse<std::map<std::string, PlaychainUserId>> PlaychainResponseParser::
 
         return { std::move(result) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<PlaychainBlockHeaderInfo> PlaychainResponseParser::parseLegacyGetLastBlockHeaderResponse(const BlockchainResponse& response) const
+ParsedResponse<PlaychainBlockHeaderInfo> PlaychainResponseParser::parseLegacyGetLastBlockHeaderResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1130,21 +2032,26 @@ ParsedResponse<PlaychainBlockHeaderInfo> PlaychainResponseParser::parseLegacyGet
 
         playchain::from_hex(hex_id, info.previous);
 
-        info.timestamp_utc = from_iso_string(js_object["time"].GetString());
+        info.timestamp_utc = parse_time(js_object["time"]);
 
         return { std::move(info) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<PlaychainSettings> PlaychainResponseParser::parsePlaychainSettingFromProperties(const BlockchainResponse& blockchain_response,
-                                                                                               const BlockchainResponse& playchain_response) const
+ParsedResponse<PlaychainSettings> PlaychainResponseParser::parsePlaychainSettingFromProperties(const BlockchainResponseView& blockchain_response,
+                                                                                               const BlockchainResponseView& playchain_response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", blockchain_response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, blockchain_response.size());
+
     try
     {
         PlaychainSettings settings;
@@ -1154,71 +2061,122 @@ ParsedResponse<PlaychainSettings> PlaychainResponseParser::parsePlaychainSetting
 
         return { std::move(settings) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
 ParsedResponse<std::vector<PlaychainTableInfoExt>>
-PlaychainResponseParser::parseChangeTableInfoNotification(const BlockchainResponse& response, const int identifier) const
+PlaychainResponseParser::parseChangeTableInfoNotification(const BlockchainResponseView& response, const int identifier) const
 {
-    try
-    {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+    std::vector<PlaychainTableInfoExt> data;
 
-        PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
-        PLAYCHAIN_ASSERT_JSON(document.HasMember("method"));
-        PLAYCHAIN_ASSERT_JSON(document["method"].IsString());
-        PLAYCHAIN_ASSERT_JSON(std::string(document["method"].GetString()) == "notice");
-        PLAYCHAIN_ASSERT_JSON(document.HasMember("params"));
-        PLAYCHAIN_ASSERT_JSON(document["params"].IsArray());
+    if (!parseChangeTableInfoNotification(response, identifier, data))
+        return {};
 
-        auto&& js_array = document["params"].GetArray();
+    return { std::move(data) };
+}
 
-        PLAYCHAIN_ASSERT_JSON(js_array.Size() == 2u);
-        PLAYCHAIN_ASSERT_JSON(js_array[0].IsInt());
-        PLAYCHAIN_ASSERT_JSON(js_array[0].GetInt() == identifier);
-        PLAYCHAIN_ASSERT_JSON(js_array[1].IsArray());
+bool PlaychainResponseParser::parseChangeTableInfoNotification(const BlockchainResponseView& response, const int identifier,
+                                                               std::vector<PlaychainTableInfoExt>& result,
+                                                               const PlaychainTableFieldsMask fields) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-        auto&& js_data = js_array[1].GetArray();
+    try
+    {
+        vector_updater<PlaychainTableInfoExt> tables { result };
 
-        PLAYCHAIN_ASSERT_JSON(js_data.Size() == 1u);
-        PLAYCHAIN_ASSERT_JSON(js_data[0].IsArray());
+        //cookie precedes tables in "params", notice of other subscription
+        //is rejected before result is touched
+        auto check_notice = [&](const json_envelope& envelope) {
+            PLAYCHAIN_ASSERT_JSON(envelope.has_cookie);
+            PLAYCHAIN_ASSERT_JSON(envelope.cookie == identifier);
+            PLAYCHAIN_ASSERT_JSON(envelope.method_length == 0 || envelope.is_method("notice"));
+        };
 
-        auto&& js_tables = js_data[0].GetArray();
+        json_envelope envelope;
+        bool checked = false;
 
-        std::vector<PlaychainTableInfoExt> data;
+        stream_array(arena(), response, json_notice_path, table_projection(fields), envelope, [&](const rapidjson::Value& js_object) {
+            if (!checked)
+            {
+                check_notice(envelope);
+                checked = true;
+            }
 
-        data.reserve(js_tables.Size());
-        for (const auto& info : js_tables)
-        {
-            PlaychainTableInfoExt table_object = parse_table_ext(info, m_settings);
+            PlaychainTableInfoExt& table_object = tables.next();
 
-            PLAYCHAIN_ASSERT_JSON(table_object.valid());
+            decode_table_ext(js_object, table_object, m_settings, fields);
 
-            data.emplace_back(table_object);
-        }
+            check_table(table_object, fields);
+        });
 
-        return { std::move(data) };
+        check_notice(envelope);
+        PLAYCHAIN_ASSERT_JSON(envelope.is_method("notice"));
+        PLAYCHAIN_ASSERT_JSON(envelope.found && envelope.found_array);
+        //"params": [cookie, [[...]]]
+        PLAYCHAIN_ASSERT_JSON(envelope.path_size[1] == 2u);
+        PLAYCHAIN_ASSERT_JSON(envelope.path_size[2] == 1u);
+
+        tables.finish();
+        return true;
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
-    return {};
+    return false;
+}
+
+bool PlaychainResponseParser::parseChangeTableInfoNotification(const PlaychainParsedMessage& message,
+                                                               std::vector<PlaychainTableInfoExt>& result,
+                                                               const PlaychainTableFieldsMask fields) const
+{
+    PLAYCHAIN_METRICS_SCOPE("parser");
+    PLAYCHAIN_TRACE_SPAN(PARSE);
+
+    using Kind = PlaychainParsedMessage::Kind;
+
+    //notice payload is [[table, ...]]
+    const rapidjson::Value* js_payload = message_payload(message, Kind::NOTICE);
+    if (!js_payload || !js_payload->IsArray() || js_payload->Size() != 1u)
+        return false;
+
+    vector_updater<PlaychainTableInfoExt> tables { result };
+
+    if (!decode_message_array(__func__, &(*js_payload)[0], [&](const rapidjson::Value& js_object) {
+            PlaychainTableInfoExt& table_object = tables.next();
+
+            decode_table_ext(js_object, table_object, m_settings, fields);
+
+            check_table(table_object, fields);
+        }))
+        return false;
+
+    tables.finish();
+    return true;
 }
 
-ParsedResponse<int> PlaychainResponseParser::parseNotificationCookie(const BlockchainResponse& response) const
+ParsedResponse<int> PlaychainResponseParser::parseNotificationCookie(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         if (!document.HasMember("method"))
             return {};
@@ -1237,20 +2195,26 @@ ParsedResponse<int> PlaychainResponseParser::parseNotificationCookie(const Block
 
         return { std::move(js_array[0].GetInt()) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<PlaychainPlayerId> PlaychainResponseParser::parseGetPlayerIdByAccountIdResponse(const BlockchainResponse& response) const
+ParsedResponse<PlaychainPlayerId> PlaychainResponseParser::parseGetPlayerIdByAccountIdResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1272,68 +2236,74 @@ ParsedResponse<PlaychainPlayerId> PlaychainResponseParser::parseGetPlayerIdByAcc
 
         return { PlaychainPlayerId {} };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<PlaychainRoomInfo>> PlaychainResponseParser::parseListRoomsResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<PlaychainRoomInfo>> PlaychainResponseParser::parseListRoomsResponse(const BlockchainResponseView& response) const
 {
-    try
-    {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-        PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
-        if (!document.HasMember("result"))
-            return {};
-        PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
-        PLAYCHAIN_ASSERT_JSON(document["result"].IsArray());
+    std::vector<PlaychainRoomInfo> data;
 
-        std::vector<PlaychainRoomInfo> data;
+    if (!parseListRoomsResponse(response, data))
+        return {};
 
-        auto&& infos = document["result"].GetArray();
+    return { std::move(data) };
+}
 
-        data.reserve(infos.Size());
-        for (auto&& js_object : infos)
-        {
-            auto&& room = parse_room_impl_base<PlaychainRoomInfo>(js_object, m_settings);
+bool PlaychainResponseParser::parseListRoomsResponse(const BlockchainResponseView& response, std::vector<PlaychainRoomInfo>& result) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-            PLAYCHAIN_ASSERT_JSON(js_object.HasMember("protocol_version"));
-            PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"].IsObject());
+    vector_updater<PlaychainRoomInfo> rooms { result };
 
-            PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"].HasMember("metadata"));
-            PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"]["metadata"].IsString());
-            PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"].HasMember("base"));
-            PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"]["base"].IsObject());
-            PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"]["base"].HasMember("v_num"));
-            PLAYCHAIN_ASSERT_JSON(js_object["protocol_version"]["base"]["v_num"].IsUint());
+    auto&& decoded = stream_result_array(__func__, arena(), response, [&](const rapidjson::Value& js_object) {
+        decode_room_object(js_object, rooms.next(), m_settings);
+    });
+    if (!decoded.valid())
+        return false;
 
-            room.protocol_version.v_num = js_object["protocol_version"]["base"]["v_num"].GetUint();
-            room.protocol_version.metadata = js_object["protocol_version"]["metadata"].GetString();
+    rooms.finish();
+    return true;
+}
 
-            data.emplace_back(room);
-        }
+bool PlaychainResponseParser::parseListRoomsResponse(const PlaychainParsedMessage& message, std::vector<PlaychainRoomInfo>& result) const
+{
+    PLAYCHAIN_METRICS_SCOPE("parser");
+    PLAYCHAIN_TRACE_SPAN(PARSE);
 
-        return { std::move(data) };
-    }
-    catch (std::exception& /*e*/)
-    {
-        //LOG_ERROR(e.what());
-    }
+    using Kind = PlaychainParsedMessage::Kind;
 
-    return {};
+    vector_updater<PlaychainRoomInfo> rooms { result };
+
+    if (!decode_message_array(__func__, message_payload(message, Kind::RESPONSE), [&](const rapidjson::Value& js_object) {
+            decode_room_object(js_object, rooms.next(), m_settings);
+        }))
+        return false;
+
+    rooms.finish();
+    return true;
 }
 
-ParsedResponse<PlaychainRoomInfoExt> PlaychainResponseParser::parseGetRoomInfoResponse(const BlockchainResponse& response) const
+ParsedResponse<PlaychainRoomInfoExt> PlaychainResponseParser::parseGetRoomInfoResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1349,20 +2319,26 @@ ParsedResponse<PlaychainRoomInfoExt> PlaychainResponseParser::parseGetRoomInfoRe
 
         return { PlaychainRoomInfoExt {} };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<PlaychainTableInfo>> PlaychainResponseParser::parseGetTablesInfoByMetadataResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<PlaychainTableInfo>> PlaychainResponseParser::parseGetTablesInfoByMetadataResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1386,49 +2362,54 @@ ParsedResponse<std::vector<PlaychainTableInfo>> PlaychainResponseParser::parseGe
 
         return { std::move(data) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<PlaychainTableId>> PlaychainResponseParser::parseListTablesResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<PlaychainTableId>> PlaychainResponseParser::parseListTablesResponse(const BlockchainResponseView& response) const
 {
-    try
-    {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-        PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
-        if (!document.HasMember("result"))
-            return {};
-        PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
-        PLAYCHAIN_ASSERT_JSON(document["result"].IsArray());
+    std::vector<PlaychainTableId> data;
 
-        std::vector<PlaychainTableId> data;
+    if (!parseListTablesResponse(response, data))
+        return {};
 
-        auto&& infos = document["result"].GetArray();
+    return { std::move(data) };
+}
 
-        data.reserve(infos.Size());
-        for (const auto& js_object : infos)
-        {
-            PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+bool PlaychainResponseParser::parseListTablesResponse(const BlockchainResponseView& response, std::vector<PlaychainTableId>& result) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-            PLAYCHAIN_ASSERT_JSON(js_object.HasMember("id"));
+    result.clear();
 
-            data.emplace_back(parse_id<PlaychainTableId>(js_object["id"], m_settings));
-        }
+    auto&& decoded = stream_result_array(__func__, arena(), response, [&](const rapidjson::Value& js_object) {
+        result.emplace_back(parse_object_id<PlaychainTableId>(js_object, m_settings));
+    });
+    return decoded.valid();
+}
 
-        return { std::move(data) };
-    }
-    catch (std::exception& /*e*/)
-    {
-        //LOG_ERROR(e.what());
-    }
+bool PlaychainResponseParser::parseListTablesResponse(const PlaychainParsedMessage& message, std::vector<PlaychainTableId>& result) const
+{
+    PLAYCHAIN_METRICS_SCOPE("parser");
+    PLAYCHAIN_TRACE_SPAN(PARSE);
 
-    return {};
+    using Kind = PlaychainParsedMessage::Kind;
+
+    result.clear();
+
+    return decode_message_array(__func__, message_payload(message, Kind::RESPONSE), [&](const rapidjson::Value& js_object) {
+        result.emplace_back(parse_object_id<PlaychainTableId>(js_object, m_settings));
+    });
 }
 
 PlaychainMoney PlaychainResponseParser::getFeeFromTransaction(const BlockchainDigestTransaction& trx) const
@@ -1438,7 +2419,8 @@ PlaychainMoney PlaychainResponseParser::getFeeFromTransaction(const BlockchainDi
 
     const auto& json_params = trx.request().params();
 
-    rapidjson::Document document;
+    json_document_lease lease { arena() };
+    json_document& document = lease.document();
     document.Parse(json_params.c_str());
 
     PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
@@ -1467,12 +2449,16 @@ PlaychainMoney PlaychainResponseParser::getFeeFromTransaction(const BlockchainDi
     return fee;
 }
 
-ParsedResponse<BlockchainWitness> PlaychainResponseParser::parseGetBlockchainWitnessResponse(const BlockchainResponse& response) const
+ParsedResponse<BlockchainWitness> PlaychainResponseParser::parseGetBlockchainWitnessResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         if (!document.HasMember("result"))
@@ -1488,20 +2474,26 @@ ParsedResponse<BlockchainWitness> PlaychainResponseParser::parseGetBlockchainWit
 
         return { BlockchainWitness {} };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<BlockchainGameWitness>> PlaychainResponseParser::parseGetBlockchainGameWitnessesResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<BlockchainGameWitness>> PlaychainResponseParser::parseGetBlockchainGameWitnessesResponse(const BlockchainResponseView& response) const
 {
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
     try
     {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+        json_document_lease lease { arena() };
+        json_document& document = lease.document();
+        parse_document(document, response);
 
         PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
         PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
@@ -1529,53 +2521,271 @@ ParsedResponse<std::vector<BlockchainGameWitness>> PlaychainResponseParser::pars
 
         return { std::move(data) };
     }
-    catch (std::exception& /*e*/)
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
-ParsedResponse<std::vector<BlockchainAccount>> PlaychainResponseParser::parseGetBlockchainAccountsResponse(const BlockchainResponse& response) const
+ParsedResponse<std::vector<BlockchainAccount>> PlaychainResponseParser::parseGetBlockchainAccountsResponse(const BlockchainResponseView& response) const
 {
-    try
-    {
-        rapidjson::Document document;
-        document.Parse(response.c_str());
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-        PLAYCHAIN_ASSERT_JSON(!document.HasParseError());
-        PLAYCHAIN_ASSERT_JSON(document.HasMember("result"));
-        PLAYCHAIN_ASSERT_JSON(document["result"].IsArray());
+    std::vector<BlockchainAccount> data;
 
-        std::vector<BlockchainAccount> data;
+    //not by streamGetBlockchainAccountsResponse, call is counted once
+    if (!stream_result_array(__func__, arena(), response, [&](const rapidjson::Value& js_object) {
+            data.emplace_back(parse_blockchain_account(js_object, m_settings));
+        }).valid())
+        return {};
 
-        auto&& infos = document["result"].GetArray();
+    return { std::move(data) };
+}
 
-        data.reserve(infos.Size());
-        for (const auto& js_object : infos)
-        {
-            PLAYCHAIN_ASSERT_JSON(js_object.IsObject());
+ParsedResponse<size_t> PlaychainResponseParser::streamGetTablesInfoResponse(const BlockchainResponseView& response,
+                                                                            const std::function<void(PlaychainTableInfoExt&&)>& callback,
+                                                                            const PlaychainTableFieldsMask fields) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-            PLAYCHAIN_ASSERT_JSON(js_object.HasMember("id"));
-            PLAYCHAIN_ASSERT_JSON(js_object.HasMember("name"));
+    return stream_result_array(__func__, arena(), response, table_projection(fields), [&](const rapidjson::Value& js_object) {
+        PlaychainTableInfoExt table_object;
+        decode_table_ext(js_object, table_object, m_settings, fields);
 
-            BlockchainAccount result;
+        check_table(table_object, fields);
 
-            result.id = parse_id<PlaychainUserId>(js_object["id"], m_settings);
-            result.name = js_object["name"].GetString();
+        callback(std::move(table_object));
+    });
+}
 
-            data.emplace_back(result);
-        }
+ParsedResponse<size_t> PlaychainResponseParser::streamListTablesResponse(const BlockchainResponseView& response,
+                                                                         const std::function<void(PlaychainTableId&&)>& callback) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
 
-        return { std::move(data) };
+    return stream_result_array(__func__, arena(), response, [&](const rapidjson::Value& js_object) {
+        callback(parse_object_id<PlaychainTableId>(js_object, m_settings));
+    });
+}
+
+ParsedResponse<size_t> PlaychainResponseParser::streamListRoomsResponse(const BlockchainResponseView& response,
+                                                                        const std::function<void(PlaychainRoomInfo&&)>& callback) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
+    return stream_result_array(__func__, arena(), response, [&](const rapidjson::Value& js_object) {
+        callback(parse_room_object(js_object, m_settings));
+    });
+}
+
+ParsedResponse<size_t> PlaychainResponseParser::streamGetBlockchainAccountsResponse(const BlockchainResponseView& response,
+                                                                                    const std::function<void(BlockchainAccount&&)>& callback) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
+    return stream_result_array(__func__, arena(), response, [&](const rapidjson::Value& js_object) {
+        callback(parse_blockchain_account(js_object, m_settings));
+    });
+}
+
+ParsedResponse<PlaychainTablesView> PlaychainResponseParser::parseGetTablesInfoView(const BlockchainResponseView& response) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
+    try
+    {
+        auto&& document = parse_view_document(response, m_settings, table_keys, table_view_types, json_fields_below(table_fields_count));
+        if (!document)
+            return {};
+
+        const size_t size = document->objects.size();
+        return { PlaychainTablesView { document, size } };
+    }
+    catch (std::exception& e)
+    {
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
-    catch (std::exception& /*e*/)
+
+    return {};
+}
+
+ParsedResponse<PlaychainRoomsView> PlaychainResponseParser::parseListRoomsView(const BlockchainResponseView& response) const
+{
+    PLAYCHAIN_METRICS_SCOPE_BYTES("parser", response.size());
+    PLAYCHAIN_TRACE_SPAN_BYTES(PARSE, response.size());
+
+    try
+    {
+        auto&& document = parse_view_document(response, m_settings, room_keys, room_view_types, room_base_required | json_field_bit(room_protocol_version));
+        if (!document)
+            return {};
+
+        const size_t size = document->objects.size();
+        return { PlaychainRoomsView { document, size } };
+    }
+    catch (std::exception& e)
     {
-        //LOG_ERROR(e.what());
+        PLAYCHAIN_METRICS_FAILURE();
+        PLAYCHAIN_TRACE_FAILURE();
+        PLAYCHAIN_LOG_ERROR(e);
     }
 
     return {};
 }
 
+PlaychainTableId PlaychainTableView::id() const
+{
+    return decode_view_id<PlaychainTableId>(m_document->field(m_index, table_id), m_document->settings);
+}
+
+PlaychainUserId PlaychainTableView::owner() const
+{
+    return decode_view_id<PlaychainUserId>(m_document->field(m_index, table_owner), m_document->settings);
+}
+
+std::string PlaychainTableView::owner_name() const
+{
+    return decode_view_string(m_document->field(m_index, table_owner_name));
+}
+
+std::string PlaychainTableView::metadata() const
+{
+    return decode_view_string(m_document->field(m_index, table_metadata));
+}
+
+std::string PlaychainTableView::server_url() const
+{
+    return decode_view_string(m_document->field(m_index, table_server_url));
+}
+
+uint16_t PlaychainTableView::required_witnesses() const
+{
+    const rapidjson::Value* js_value = m_document->field(m_index, table_required_witnesses);
+    if (!js_value)
+        return 0;
+
+    PLAYCHAIN_ASSERT_JSON(js_value->IsInt());
+    return (uint16_t)js_value->GetInt();
+}
+
+PlaychainMoney PlaychainTableView::min_accepted_proposal_asset() const
+{
+    const rapidjson::Value* js_value = m_document->field(m_index, table_min_accepted_proposal_asset);
+    return js_value ? parse_asset(*js_value, m_document->settings) : 0;
+}
+
+PlaychainTableInfo::State PlaychainTableView::state() const
+{
+    const rapidjson::Value* js_value = m_document->field(m_index, table_state);
+    if (!js_value)
+        return PlaychainTableInfo::State::NOP;
+
+    PLAYCHAIN_ASSERT_JSON(js_value->IsString());
+    return parse_table_state(js_value->GetString());
+}
+
+PlaychainTableInfoExt::PendingBuyinsType PlaychainTableView::pending_proposals() const
+{
+    PlaychainTableInfoExt::PendingBuyinsType result;
+    if (const rapidjson::Value* js_value = m_document->field(m_index, table_pending_proposals))
+        decode_pending_proposals(*js_value, result, m_document->settings);
+    return result;
+}
+
+PlaychainTableInfoExt::CashDatasType PlaychainTableView::cash() const
+{
+    PlaychainTableInfoExt::CashDatasType result;
+    if (const rapidjson::Value* js_value = m_document->field(m_index, table_cash))
+        decode_cash_map(*js_value, result, m_document->settings);
+    return result;
+}
+
+PlaychainTableInfoExt::CashDatasType PlaychainTableView::playing_cash() const
+{
+    PlaychainTableInfoExt::CashDatasType result;
+    if (const rapidjson::Value* js_value = m_document->field(m_index, table_playing_cash))
+        decode_cash_map(*js_value, result, m_document->settings);
+    return result;
+}
+
+PlaychainTableInfoExt::AccountsType PlaychainTableView::missed_voters() const
+{
+    PlaychainTableInfoExt::AccountsType result;
+    if (const rapidjson::Value* js_value = m_document->field(m_index, table_missed_voters))
+        decode_accounts_map(*js_value, result, m_document->settings);
+    return result;
+}
+
+PlaychainTableInfo PlaychainTableView::info() const
+{
+    return parse_table(*m_document->objects[m_index], m_document->settings);
+}
+
+PlaychainTableInfoExt PlaychainTableView::infoExt() const
+{
+    PlaychainTableInfoExt result;
+    decode_table_ext(*m_document->objects[m_index], result, m_document->settings);
+    return result;
+}
+
+PlaychainRoomId PlaychainRoomView::id() const
+{
+    return decode_view_id<PlaychainRoomId>(m_document->field(m_index, room_id), m_document->settings);
+}
+
+PlaychainUserId PlaychainRoomView::owner() const
+{
+    return decode_view_id<PlaychainUserId>(m_document->field(m_index, room_owner), m_document->settings);
+}
+
+std::string PlaychainRoomView::owner_name() const
+{
+    return decode_view_string(m_document->field(m_index, room_owner_name));
+}
+
+std::string PlaychainRoomView::metadata() const
+{
+    return decode_view_string(m_document->field(m_index, room_metadata));
+}
+
+std::string PlaychainRoomView::server_url() const
+{
+    return decode_view_string(m_document->field(m_index, room_server_url));
+}
+
+int32_t PlaychainRoomView::rating() const
+{
+    const rapidjson::Value* js_value = m_document->field(m_index, room_rating);
+    if (!js_value)
+        return 0;
+
+    PLAYCHAIN_ASSERT_JSON(js_value->IsInt());
+    return js_value->GetInt();
+}
+
+ProtocolVersion PlaychainRoomView::protocol_version() const
+{
+    ProtocolVersion result;
+    if (const rapidjson::Value* js_value = m_document->field(m_index, room_protocol_version))
+        decode_protocol_version_object(*js_value, result, m_document->settings);
+    return result;
+}
+
+PlaychainRoomInfo PlaychainRoomView::info() const
+{
+    return parse_room_object(*m_document->objects[m_index], m_document->settings);
+}
+
 } // namespace tp
@@ -3,6 +3,7 @@
 #include "convert_helper.h"
 #include "playchain_defines.h"
 #include "hash_helper.h"
+#include "sha256_kernels.h"
 
 #include <string.h>
 #include <cmath>
@@ -50,6 +51,22 @@ sha256 sha256::hash(const sha256& s)
     return hash(s.data(), sizeof(s._hash));
 }
 
+void sha256::hash_batch(const char* const* data, const size_t* sizes, const size_t count, sha256* out)
+{
+    static_assert(sizeof(sha256) == 32, "digests are written to array of sha256");
+
+    const sha256_lanes_kernel* kernel = default_sha256_lanes_kernel();
+    if (kernel && count > 1)
+    {
+        sha256_hash_lanes(*kernel, (const uint8_t* const*)data, sizes, count, (uint8_t*)out);
+        return;
+    }
+
+    for (size_t ci = 0; ci < count; ++ci)
+        out[ci] = hash(data[ci], (uint32_t)sizes[ci]);
+}
+
+#if defined(PLAYCHAIN_SHA256_BACKEND_OPENSSL)
 void sha256::encoder::write(const char* d, uint32_t dlen)
 {
     SHA256_Update(&_context, d, dlen);
@@ -64,6 +81,76 @@ void sha256::encoder::reset()
 {
     SHA256_Init(&_context);
 }
+#else
+void sha256::encoder::write(const char* d, uint32_t dlen)
+{
+    const size_t pos = (size_t)(_size % sha256_block_size);
+    _size += dlen;
+
+    //the most of writes are small fields of packed transaction
+    if (pos + dlen < sha256_block_size)
+    {
+        if (dlen)
+            memcpy(_buffer + pos, d, dlen);
+        return;
+    }
+
+    const sha256_kernel& kernel = default_sha256_kernel();
+    const uint8_t* data = (const uint8_t*)d;
+    if (pos)
+    {
+        const size_t tail = sha256_block_size - pos;
+        memcpy(_buffer + pos, data, tail);
+        kernel.compress(_state, _buffer, 1);
+        data += tail;
+        dlen -= (uint32_t)tail;
+    }
+
+    const size_t blocks = dlen / sha256_block_size;
+    if (blocks)
+    {
+        kernel.compress(_state, data, blocks);
+        data += blocks * sha256_block_size;
+        dlen -= (uint32_t)(blocks * sha256_block_size);
+    }
+    if (dlen)
+        memcpy(_buffer, data, dlen);
+}
+sha256 sha256::encoder::result()
+{
+    const sha256_kernel& kernel = default_sha256_kernel();
+    const uint64_t bits = _size * 8;
+
+    size_t pos = (size_t)(_size % sha256_block_size);
+    _buffer[pos++] = 0x80;
+    if (pos > sha256_block_size - 8)
+    {
+        memset(_buffer + pos, 0, sha256_block_size - pos);
+        kernel.compress(_state, _buffer, 1);
+        pos = 0;
+    }
+    memset(_buffer + pos, 0, sha256_block_size - 8 - pos);
+    for (size_t ci = 0; ci < 8; ++ci)
+        _buffer[sha256_block_size - 1 - ci] = (uint8_t)(bits >> (ci * 8));
+    kernel.compress(_state, _buffer, 1);
+
+    sha256 h;
+    uint8_t* out = (uint8_t*)h.data();
+    for (size_t ci = 0; ci < 8; ++ci)
+    {
+        out[ci * 4] = (uint8_t)(_state[ci] >> 24);
+        out[ci * 4 + 1] = (uint8_t)(_state[ci] >> 16);
+        out[ci * 4 + 2] = (uint8_t)(_state[ci] >> 8);
+        out[ci * 4 + 3] = (uint8_t)_state[ci];
+    }
+    return h;
+}
+void sha256::encoder::reset()
+{
+    memcpy(_state, sha256_initial_state, sizeof(_state));
+    _size = 0;
+}
+#endif
 
 sha256 operator<<(const sha256& h1, uint32_t i)
 {
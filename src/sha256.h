@@ -1,7 +1,10 @@
 #pragma once
 
+#if defined(PLAYCHAIN_SHA256_BACKEND_OPENSSL)
 #include <openssl/sha.h>
+#endif
 
+#include <cstdint>
 #include <string>
 
 namespace playchain {
@@ -21,6 +24,9 @@ public:
     static sha256 hash(const char* d, uint32_t dlen);
     static sha256 hash(const std::string&);
     static sha256 hash(const sha256&);
+    //digests of count independent messages, several messages are hashed
+    //at once by multi-buffer kernel if CPU supports it (see sha256_kernels.h)
+    static void hash_batch(const char* const* data, const size_t* sizes, const size_t count, sha256* out);
 
     template <typename T>
     static sha256 hash(const T& t)
@@ -42,7 +48,14 @@ public:
         sha256 result();
 
     private:
+#if defined(PLAYCHAIN_SHA256_BACKEND_OPENSSL)
         SHA256_CTX _context;
+#else
+        //built-in (src/sha256_kernels.h), small writes are collected in block buffer
+        uint32_t _state[8];
+        uint8_t _buffer[64];
+        uint64_t _size = 0;
+#endif
     };
 
     template <typename T>
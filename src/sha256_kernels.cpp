@@ -0,0 +1,541 @@
+#include "sha256_kernels.h"
+#include "cpu_features.h"
+
+#include <cassert>
+#include <cstring>
+
+#if defined(PLAYCHAIN_X86_DISPATCH)
+#include <immintrin.h>
+#endif
+
+namespace playchain {
+
+namespace {
+    const uint32_t round_constants[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    inline uint32_t ror(const uint32_t x, const unsigned n)
+    {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    inline uint32_t load_be32(const uint8_t* p)
+    {
+        return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+
+    //64 rounds with precomputed message schedule plus round constants
+    inline void rounds(uint32_t* state, const uint32_t* wk)
+    {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (size_t ci = 0; ci < 64; ++ci)
+        {
+            const uint32_t t1 = h + (ror(e, 6) ^ ror(e, 11) ^ ror(e, 25)) + ((e & f) ^ (~e & g)) + wk[ci];
+            const uint32_t t2 = (ror(a, 2) ^ ror(a, 13) ^ ror(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    void compress_scalar(uint32_t* state, const uint8_t* blocks, const size_t count)
+    {
+        uint32_t w[64];
+        for (size_t block = 0; block < count; ++block, blocks += sha256_block_size)
+        {
+            for (size_t ci = 0; ci < 16; ++ci)
+                w[ci] = load_be32(blocks + ci * 4);
+            for (size_t ci = 16; ci < 64; ++ci)
+            {
+                const uint32_t s0 = ror(w[ci - 15], 7) ^ ror(w[ci - 15], 18) ^ (w[ci - 15] >> 3);
+                const uint32_t s1 = ror(w[ci - 2], 17) ^ ror(w[ci - 2], 19) ^ (w[ci - 2] >> 10);
+                w[ci] = w[ci - 16] + s0 + w[ci - 7] + s1;
+            }
+            for (size_t ci = 0; ci < 64; ++ci)
+                w[ci] += round_constants[ci];
+
+            rounds(state, w);
+        }
+    }
+
+#if defined(PLAYCHAIN_X86_DISPATCH)
+    PLAYCHAIN_TARGET("sha,sse4.1,ssse3")
+    void compress_shani(uint32_t* state, const uint8_t* blocks, const size_t count)
+    {
+        const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        //ABEF and CDGH layout of sha256rnds2
+        __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0xB1);
+        __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(state + 4)), 0x1B);
+        __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+        for (size_t block = 0; block < count; ++block, blocks += sha256_block_size)
+        {
+            const __m128i abef = state0;
+            const __m128i cdgh = state1;
+
+            __m128i msgs[4];
+            for (size_t ci = 0; ci < 4; ++ci)
+                msgs[ci] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + ci * 16)), byte_swap);
+
+            //4 rounds per step, schedule of step + 4 from 4 previous ones
+            for (size_t ci = 0; ci < 16; ++ci)
+            {
+                __m128i& current = msgs[ci % 4];
+
+                __m128i msg = _mm_add_epi32(current, _mm_loadu_si128((const __m128i*)(round_constants + ci * 4)));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+                msg = _mm_shuffle_epi32(msg, 0x0E);
+                state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+                if (ci < 12)
+                {
+                    const __m128i& next1 = msgs[(ci + 1) % 4];
+                    const __m128i& next2 = msgs[(ci + 2) % 4];
+                    const __m128i& next3 = msgs[(ci + 3) % 4];
+                    tmp = _mm_add_epi32(_mm_sha256msg1_epu32(current, next1), _mm_alignr_epi8(next3, next2, 4));
+                    current = _mm_sha256msg2_epu32(tmp, next3);
+                }
+            }
+
+            state0 = _mm_add_epi32(state0, abef);
+            state1 = _mm_add_epi32(state1, cdgh);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);
+        state1 = _mm_shuffle_epi32(state1, 0xB1);
+        _mm_storeu_si128((__m128i*)state, _mm_blend_epi16(tmp, state1, 0xF0));
+        _mm_storeu_si128((__m128i*)(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+    }
+
+    template <int N>
+    PLAYCHAIN_TARGET("avx2")
+    __m256i ror_avx2(const __m256i x)
+    {
+        return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+    }
+
+    //message schedule plus round constants of two blocks, one per 128-bit lane
+    PLAYCHAIN_TARGET("avx2")
+    void schedule_avx2(const uint8_t* first, const uint8_t* second, uint32_t (&wk)[2][64])
+    {
+        const __m256i byte_swap = _mm256_broadcastsi128_si256(_mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL));
+
+        __m256i w[16];
+        for (size_t ci = 0; ci < 4; ++ci)
+        {
+            const __m256i both = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(first + ci * 16))),
+                                                         _mm_loadu_si128((const __m128i*)(second + ci * 16)), 1);
+            w[ci] = _mm256_shuffle_epi8(both, byte_swap);
+        }
+
+        //W[t..t+3] = W[t-16..t-13] + s0(W[t-15..t-12]) + W[t-7..t-4] + s1(W[t-2..t+1]),
+        //s1 of W[t], W[t+1] is known after the first half
+        for (size_t ci = 4; ci < 16; ++ci)
+        {
+            const __m256i w15 = _mm256_alignr_epi8(w[ci - 3], w[ci - 4], 4);
+            const __m256i w7 = _mm256_alignr_epi8(w[ci - 1], w[ci - 2], 4);
+            const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ror_avx2<7>(w15), ror_avx2<18>(w15)), _mm256_srli_epi32(w15, 3));
+            const __m256i sum = _mm256_add_epi32(_mm256_add_epi32(w[ci - 4], s0), w7);
+
+            const __m256i w2 = _mm256_shuffle_epi32(w[ci - 1], 0xEE);
+            const __m256i low = _mm256_add_epi32(sum, _mm256_xor_si256(_mm256_xor_si256(ror_avx2<17>(w2), ror_avx2<19>(w2)), _mm256_srli_epi32(w2, 10)));
+            const __m256i w0 = _mm256_shuffle_epi32(low, 0x44);
+            const __m256i high = _mm256_add_epi32(sum, _mm256_xor_si256(_mm256_xor_si256(ror_avx2<17>(w0), ror_avx2<19>(w0)), _mm256_srli_epi32(w0, 10)));
+            w[ci] = _mm256_blend_epi32(low, high, 0xCC);
+        }
+
+        for (size_t ci = 0; ci < 16; ++ci)
+        {
+            const __m256i k = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(round_constants + ci * 4)));
+            const __m256i sum = _mm256_add_epi32(w[ci], k);
+            _mm_storeu_si128((__m128i*)(wk[0] + ci * 4), _mm256_castsi256_si128(sum));
+            _mm_storeu_si128((__m128i*)(wk[1] + ci * 4), _mm256_extracti128_si256(sum, 1));
+        }
+    }
+
+    //rounds are scalar, BMI2 gives rorx for them
+    PLAYCHAIN_TARGET("avx2,bmi2")
+    void compress_avx2(uint32_t* state, const uint8_t* blocks, const size_t count)
+    {
+        uint32_t wk[2][64];
+
+        size_t block = 0;
+        for (; block + 2 <= count; block += 2, blocks += 2 * sha256_block_size)
+        {
+            schedule_avx2(blocks, blocks + sha256_block_size, wk);
+            rounds(state, wk[0]);
+            rounds(state, wk[1]);
+        }
+        compress_scalar(state, blocks, count - block);
+    }
+
+    //transposed big endian words of one block of every lane
+    template <size_t Lanes>
+    inline void transpose_blocks(const uint8_t* const* blocks, uint32_t* words)
+    {
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            for (size_t ci = 0; ci < 16; ++ci)
+                words[ci * Lanes + lane] = load_be32(blocks[lane] + ci * 4);
+        }
+    }
+
+    //SHA-256 of Ops::lanes messages, each operation works with all lanes.
+    //Body is expanded in every kernel to be compiled with its target,
+    //Ops members are inlined into it and vectors never cross functions of other target
+#define PLAYCHAIN_SHA256_LANES_KERNEL(NAME, Ops, EXTENSIONS)                                                                            \
+    PLAYCHAIN_TARGET(EXTENSIONS)                                                                                                        \
+    void NAME(uint32_t* states, const uint8_t* const* blocks)                                                                           \
+    {                                                                                                                                   \
+        using vec = Ops::vec;                                                                                                           \
+        constexpr size_t lanes = Ops::lanes;                                                                                            \
+                                                                                                                                        \
+        uint32_t words[16 * lanes];                                                                                                     \
+        transpose_blocks<lanes>(blocks, words);                                                                                         \
+                                                                                                                                        \
+        vec w[16];                                                                                                                      \
+        for (size_t ci = 0; ci < 16; ++ci)                                                                                              \
+            w[ci] = Ops::load(words + ci * lanes);                                                                                      \
+                                                                                                                                        \
+        vec a = Ops::load(states), b = Ops::load(states + lanes);                                                                       \
+        vec c = Ops::load(states + 2 * lanes), d = Ops::load(states + 3 * lanes);                                                       \
+        vec e = Ops::load(states + 4 * lanes), f = Ops::load(states + 5 * lanes);                                                       \
+        vec g = Ops::load(states + 6 * lanes), h = Ops::load(states + 7 * lanes);                                                       \
+                                                                                                                                        \
+        for (size_t ci = 0; ci < 64; ++ci)                                                                                              \
+        {                                                                                                                               \
+            if (ci >= 16)                                                                                                               \
+            {                                                                                                                           \
+                const vec w15 = w[(ci - 15) % 16];                                                                                      \
+                const vec w2 = w[(ci - 2) % 16];                                                                                        \
+                const vec s0 = Ops::xor3(Ops::ror<7>(w15), Ops::ror<18>(w15), Ops::shr<3>(w15));             \
+                const vec s1 = Ops::xor3(Ops::ror<17>(w2), Ops::ror<19>(w2), Ops::shr<10>(w2));              \
+                w[ci % 16] = Ops::add(Ops::add(w[ci % 16], s0), Ops::add(w[(ci - 7) % 16], s1));                                        \
+            }                                                                                                                           \
+                                                                                                                                        \
+            const vec s1 = Ops::xor3(Ops::ror<6>(e), Ops::ror<11>(e), Ops::ror<25>(e));                      \
+            const vec t1 = Ops::add(Ops::add(h, s1), Ops::add(Ops::ch(e, f, g), Ops::add(w[ci % 16], Ops::set1(round_constants[ci])))); \
+            const vec s0 = Ops::xor3(Ops::ror<2>(a), Ops::ror<13>(a), Ops::ror<22>(a));                      \
+            const vec t2 = Ops::add(s0, Ops::maj(a, b, c));                                                                             \
+            h = g;                                                                                                                      \
+            g = f;                                                                                                                      \
+            f = e;                                                                                                                      \
+            e = Ops::add(d, t1);                                                                                                        \
+            d = c;                                                                                                                      \
+            c = b;                                                                                                                      \
+            b = a;                                                                                                                      \
+            a = Ops::add(t1, t2);                                                                                                       \
+        }                                                                                                                               \
+                                                                                                                                        \
+        Ops::store(states, Ops::add(Ops::load(states), a));                                                                             \
+        Ops::store(states + lanes, Ops::add(Ops::load(states + lanes), b));                                                             \
+        Ops::store(states + 2 * lanes, Ops::add(Ops::load(states + 2 * lanes), c));                                                     \
+        Ops::store(states + 3 * lanes, Ops::add(Ops::load(states + 3 * lanes), d));                                                     \
+        Ops::store(states + 4 * lanes, Ops::add(Ops::load(states + 4 * lanes), e));                                                     \
+        Ops::store(states + 5 * lanes, Ops::add(Ops::load(states + 5 * lanes), f));                                                     \
+        Ops::store(states + 6 * lanes, Ops::add(Ops::load(states + 6 * lanes), g));                                                     \
+        Ops::store(states + 7 * lanes, Ops::add(Ops::load(states + 7 * lanes), h));                                                     \
+    }
+
+    struct ssse3_ops
+    {
+        using vec = __m128i;
+        static constexpr size_t lanes = 4;
+
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec load(const uint32_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE void store(uint32_t* p, const vec v) { _mm_storeu_si128((__m128i*)p, v); }
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec set1(const uint32_t x) { return _mm_set1_epi32((int)x); }
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec add(const vec x, const vec y) { return _mm_add_epi32(x, y); }
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec xor3(const vec x, const vec y, const vec z) { return _mm_xor_si128(_mm_xor_si128(x, y), z); }
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec ch(const vec x, const vec y, const vec z) { return _mm_xor_si128(_mm_and_si128(x, y), _mm_andnot_si128(x, z)); }
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec maj(const vec x, const vec y, const vec z) { return _mm_or_si128(_mm_and_si128(x, y), _mm_and_si128(z, _mm_or_si128(x, y))); }
+        template <int N>
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec ror(const vec x) { return _mm_or_si128(_mm_srli_epi32(x, N), _mm_slli_epi32(x, 32 - N)); }
+        template <int N>
+        PLAYCHAIN_TARGET("ssse3")
+        static PLAYCHAIN_FORCE_INLINE vec shr(const vec x) { return _mm_srli_epi32(x, N); }
+    };
+
+    struct avx2_ops
+    {
+        using vec = __m256i;
+        static constexpr size_t lanes = 8;
+
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec load(const uint32_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE void store(uint32_t* p, const vec v) { _mm256_storeu_si256((__m256i*)p, v); }
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec set1(const uint32_t x) { return _mm256_set1_epi32((int)x); }
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec add(const vec x, const vec y) { return _mm256_add_epi32(x, y); }
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec xor3(const vec x, const vec y, const vec z) { return _mm256_xor_si256(_mm256_xor_si256(x, y), z); }
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec ch(const vec x, const vec y, const vec z) { return _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z)); }
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec maj(const vec x, const vec y, const vec z) { return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y))); }
+        template <int N>
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec ror(const vec x) { return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N)); }
+        template <int N>
+        PLAYCHAIN_TARGET("avx2")
+        static PLAYCHAIN_FORCE_INLINE vec shr(const vec x) { return _mm256_srli_epi32(x, N); }
+    };
+
+    //native rotations and ternary logic,
+    //rotation and shift are masked forms, unmasked ones warn about undefined source in GCC 12 headers
+    struct avx512_ops
+    {
+        using vec = __m512i;
+        static constexpr size_t lanes = 16;
+
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec load(const uint32_t* p) { return _mm512_loadu_si512(p); }
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE void store(uint32_t* p, const vec v) { _mm512_storeu_si512(p, v); }
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec set1(const uint32_t x) { return _mm512_set1_epi32((int)x); }
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec add(const vec x, const vec y) { return _mm512_add_epi32(x, y); }
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec xor3(const vec x, const vec y, const vec z) { return _mm512_ternarylogic_epi32(x, y, z, 0x96); }
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec ch(const vec x, const vec y, const vec z) { return _mm512_ternarylogic_epi32(x, y, z, 0xCA); }
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec maj(const vec x, const vec y, const vec z) { return _mm512_ternarylogic_epi32(x, y, z, 0xE8); }
+        template <int N>
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec ror(const vec x) { return _mm512_mask_ror_epi32(x, (__mmask16)-1, x, N); }
+        template <int N>
+        PLAYCHAIN_TARGET("avx512f")
+        static PLAYCHAIN_FORCE_INLINE vec shr(const vec x) { return _mm512_mask_srli_epi32(x, (__mmask16)-1, x, N); }
+    };
+
+    PLAYCHAIN_SHA256_LANES_KERNEL(compress_ssse3_x4, ssse3_ops, "ssse3")
+    PLAYCHAIN_SHA256_LANES_KERNEL(compress_avx2_x8, avx2_ops, "avx2")
+    PLAYCHAIN_SHA256_LANES_KERNEL(compress_avx512_x16, avx512_ops, "avx512f")
+
+#undef PLAYCHAIN_SHA256_LANES_KERNEL
+#endif //< PLAYCHAIN_X86_DISPATCH
+
+    std::vector<sha256_kernel> detect_sha256_kernels()
+    {
+        std::vector<sha256_kernel> result;
+
+        result.push_back({ "scalar", compress_scalar });
+#if defined(PLAYCHAIN_X86_DISPATCH)
+        const cpu_features& features = detect_cpu_features();
+        if (features.avx2 && features.bmi2)
+            result.push_back({ "avx2", compress_avx2 });
+        if (features.sha && features.sse41 && features.ssse3)
+            result.push_back({ "sha-ni", compress_shani });
+#endif
+        return result;
+    }
+
+    std::vector<sha256_lanes_kernel> detect_sha256_lanes_kernels()
+    {
+        std::vector<sha256_lanes_kernel> result;
+#if defined(PLAYCHAIN_X86_DISPATCH)
+        const cpu_features& features = detect_cpu_features();
+        if (features.ssse3)
+            result.push_back({ "ssse3x4", 4, compress_ssse3_x4 });
+        if (features.avx2)
+            result.push_back({ "avx2x8", 8, compress_avx2_x8 });
+        if (features.avx512f)
+            result.push_back({ "avx512x16", 16, compress_avx512_x16 });
+#endif
+        return result;
+    }
+
+    const sha256_lanes_kernel* select_sha256_lanes_kernel()
+    {
+        const auto& kernels = supported_sha256_lanes_kernels();
+        if (kernels.empty())
+            return nullptr;
+        //only 16 lanes are faster than one SHA-NI stream
+        if (kernels.back().lanes < 16 && detect_cpu_features().sha)
+            return nullptr;
+        return &kernels.back();
+    }
+
+    //message of lane with padding in tail blocks
+    struct lane_message
+    {
+        size_t index = 0;
+        const uint8_t* data = nullptr;
+        size_t full_blocks = 0;
+        size_t blocks = 0;
+        size_t block = 0;
+        uint8_t tail[2 * sha256_block_size];
+
+        void assign(const size_t message, const uint8_t* message_data, const size_t size)
+        {
+            index = message;
+            data = message_data;
+            full_blocks = size / sha256_block_size;
+            block = 0;
+
+            const size_t rest = size % sha256_block_size;
+            const size_t tail_size = rest + 9 <= sha256_block_size ? sha256_block_size : 2 * sha256_block_size;
+            blocks = full_blocks + tail_size / sha256_block_size;
+
+            if (rest)
+                memcpy(tail, data + full_blocks * sha256_block_size, rest);
+            tail[rest] = 0x80;
+            memset(tail + rest + 1, 0, tail_size - rest - 1 - 8);
+            const uint64_t bits = (uint64_t)size * 8;
+            for (size_t ci = 0; ci < 8; ++ci)
+                tail[tail_size - 1 - ci] = (uint8_t)(bits >> (ci * 8));
+        }
+
+        const uint8_t* current() const
+        {
+            return block < full_blocks ? data + block * sha256_block_size : tail + (block - full_blocks) * sha256_block_size;
+        }
+    };
+
+    void store_digest(const uint32_t* state, const size_t stride, uint8_t* digest)
+    {
+        for (size_t ci = 0; ci < 8; ++ci)
+        {
+            const uint32_t word = state[ci * stride];
+            digest[ci * 4] = (uint8_t)(word >> 24);
+            digest[ci * 4 + 1] = (uint8_t)(word >> 16);
+            digest[ci * 4 + 2] = (uint8_t)(word >> 8);
+            digest[ci * 4 + 3] = (uint8_t)word;
+        }
+    }
+} // namespace
+
+const std::vector<sha256_kernel>& supported_sha256_kernels()
+{
+    static const std::vector<sha256_kernel> kernels = detect_sha256_kernels();
+    return kernels;
+}
+
+const sha256_kernel& default_sha256_kernel()
+{
+    static const sha256_kernel& kernel = supported_sha256_kernels().back();
+    return kernel;
+}
+
+const std::vector<sha256_lanes_kernel>& supported_sha256_lanes_kernels()
+{
+    static const std::vector<sha256_lanes_kernel> kernels = detect_sha256_lanes_kernels();
+    return kernels;
+}
+
+const sha256_lanes_kernel* default_sha256_lanes_kernel()
+{
+    static const sha256_lanes_kernel* kernel = select_sha256_lanes_kernel();
+    return kernel;
+}
+
+void sha256_hash_lanes(const sha256_lanes_kernel& kernel,
+                       const uint8_t* const* messages, const size_t* sizes, const size_t count,
+                       uint8_t* digests)
+{
+    constexpr size_t max_lanes = 16;
+    const size_t lanes = kernel.lanes;
+    assert(lanes <= max_lanes);
+
+    lane_message jobs[max_lanes];
+    bool active[max_lanes] = {};
+    uint32_t states[8 * max_lanes];
+    const uint8_t* blocks[max_lanes];
+    //for lanes without messages
+    const uint8_t idle[sha256_block_size] = {};
+
+    size_t next = 0;
+    size_t active_count = 0;
+    auto start = [&](const size_t lane) {
+        active[lane] = next < count;
+        if (!active[lane])
+            return;
+        jobs[lane].assign(next, messages[next], sizes[next]);
+        for (size_t ci = 0; ci < 8; ++ci)
+            states[ci * lanes + lane] = sha256_initial_state[ci];
+        ++next;
+        ++active_count;
+    };
+
+    for (size_t lane = 0; lane < lanes; ++lane)
+        start(lane);
+
+    //the last message is finished without lanes
+    while (active_count > 1 || (active_count == 1 && next < count))
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+            blocks[lane] = active[lane] ? jobs[lane].current() : idle;
+
+        kernel.compress(states, blocks);
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            if (!active[lane] || ++jobs[lane].block < jobs[lane].blocks)
+                continue;
+
+            store_digest(states + lane, lanes, digests + jobs[lane].index * 32);
+            --active_count;
+            start(lane);
+        }
+    }
+
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        if (!active[lane])
+            continue;
+
+        lane_message& job = jobs[lane];
+        uint32_t state[8];
+        for (size_t ci = 0; ci < 8; ++ci)
+            state[ci] = states[ci * lanes + lane];
+
+        const sha256_kernel& single = default_sha256_kernel();
+        if (job.block < job.full_blocks)
+        {
+            single.compress(state, job.current(), job.full_blocks - job.block);
+            job.block = job.full_blocks;
+        }
+        single.compress(state, job.current(), job.blocks - job.block);
+        store_digest(state, 1, digests + job.index * 32);
+    }
+}
+
+} // namespace playchain
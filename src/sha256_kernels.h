@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* SHA-256 compression of whole 64-byte blocks.
+ *
+ * Kernel is selected at run time by CPU extensions (see cpu_features.h):
+ * SHA-NI, AVX2 (message schedule of two blocks at once) or portable scalar one.
+ * Padding and buffering of partial blocks are done by sha256::encoder.
+ *
+ * Multi-buffer kernels compress one block of 4, 8 or 16 independent
+ * messages at once (SSSE3, AVX2, AVX-512 lanes), sha256_hash_lanes
+ * feeds them with batch of messages of any sizes.
+*/
+
+namespace playchain {
+
+constexpr size_t sha256_block_size = 64;
+
+constexpr uint32_t sha256_initial_state[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                               0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+struct sha256_kernel
+{
+    const char* name;
+    //updates state by count blocks of data
+    void (*compress)(uint32_t* state, const uint8_t* blocks, const size_t count);
+};
+
+//the fastest kernel supported by CPU
+const sha256_kernel& default_sha256_kernel();
+//all kernels supported by CPU (for tests and benchmarks)
+const std::vector<sha256_kernel>& supported_sha256_kernels();
+
+struct sha256_lanes_kernel
+{
+    const char* name;
+    size_t lanes;
+    //updates states of lanes by one block of every lane,
+    //states are transposed: word i of lane j is states[i * lanes + j]
+    void (*compress)(uint32_t* states, const uint8_t* const* blocks);
+};
+
+//the widest kernel supported by CPU, nullptr if there is no one
+//(or if single message kernel is faster than multi-buffer one)
+const sha256_lanes_kernel* default_sha256_lanes_kernel();
+//all multi-buffer kernels supported by CPU (for tests and benchmarks)
+const std::vector<sha256_lanes_kernel>& supported_sha256_lanes_kernels();
+
+//digests (32 bytes each) of count independent messages
+void sha256_hash_lanes(const sha256_lanes_kernel& kernel,
+                       const uint8_t* const* messages, const size_t* sizes, const size_t count,
+                       uint8_t* digests);
+
+} // namespace playchain
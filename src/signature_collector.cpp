@@ -0,0 +1,199 @@
+#include <playchain/signature_collector.h>
+#include <playchain/playchain_helper.h>
+
+#include "playchain_defines.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace tp {
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    std::chrono::microseconds elapsed(const clock_type::time_point& from, const clock_type::time_point& to)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(to - from);
+    }
+} // namespace
+
+struct PlaychainSignatureCollectorContext
+{
+    struct pending_transaction
+    {
+        BlockchainRequest request;
+        Digest digest;
+        //signature by signer, empty until it is received
+        std::map<CompressedPublicKey, std::string> signatures;
+        size_t received = 0;
+        clock_type::time_point expected_at;
+        clock_type::time_point first_signature_at;
+    };
+
+    PlaychainSignatureCollectorContext(const PlaychainRequestBuilder& builder, const PlaychainSignatureCollector::Handler& on_complete)
+        : builder(builder)
+        , on_complete(on_complete)
+    {
+    }
+
+    //copy, chain settings of origin could be updated concurrently
+    const PlaychainRequestBuilder builder;
+    const PlaychainSignatureCollector::Handler on_complete;
+
+    std::unordered_map<std::string, pending_transaction> pending;
+
+    PlaychainSignatureCollectorStats stats;
+
+    mutable std::mutex lock;
+};
+
+PlaychainSignatureCollector::PlaychainSignatureCollector(const PlaychainRequestBuilder& builder, const Handler& on_complete)
+    : m_context(new PlaychainSignatureCollectorContext(builder, on_complete))
+{
+    PLAYCHAIN_ASSERT(on_complete);
+}
+
+PlaychainSignatureCollector::~PlaychainSignatureCollector() {}
+
+bool PlaychainSignatureCollector::expect(const BlockchainDigestTransaction& trx, const std::set<CompressedPublicKey>& signers)
+{
+    PLAYCHAIN_ASSERT(trx.valid());
+    PLAYCHAIN_ASSERT(!signers.empty(), "Signers are required");
+
+    PlaychainSignatureCollectorContext::pending_transaction transaction;
+    transaction.request = trx.request();
+    transaction.digest = convert_digest(trx.digest());
+    for (auto&& key : signers)
+        transaction.signatures.emplace(key, std::string {});
+    transaction.expected_at = clock_type::now();
+
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    if (!m_context->pending.emplace(trx.digest(), std::move(transaction)).second)
+        return false;
+
+    ++m_context->stats.pending;
+    return true;
+}
+
+bool PlaychainSignatureCollector::cancel(const std::string& digest)
+{
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    if (!m_context->pending.erase(digest))
+        return false;
+
+    --m_context->stats.pending;
+    return true;
+}
+
+PlaychainSignatureCollector::Status PlaychainSignatureCollector::addSignature(const std::string& digest, const std::string& signature)
+{
+    Digest digest_data;
+    {
+        std::unique_lock<std::mutex> lck(m_context->lock);
+
+        auto it = m_context->pending.find(digest);
+        if (it == m_context->pending.end())
+            return Status::UNKNOWN;
+
+        auto&& transaction = it->second;
+        for (auto&& item : transaction.signatures)
+        {
+            //empty slot is not filled yet
+            if (!item.second.empty() && item.second == signature)
+            {
+                ++m_context->stats.duplicate_signatures;
+                return Status::DUPLICATE;
+            }
+        }
+        digest_data = transaction.digest;
+    }
+
+    //verification is the most expensive part, other signers are not blocked.
+    //Key is recovered once instead of checking signature by every signer
+    CompressedPublicKey signer;
+    bool recovered = false;
+    try
+    {
+        signer = recover_public_key(convert_signature(signature), digest_data);
+        recovered = true;
+    }
+    catch (const std::logic_error&)
+    {
+    }
+
+    const auto now = clock_type::now();
+
+    BlockchainRequest request;
+    std::set<std::string> signatures;
+    PlaychainSignatureLatency latency;
+    {
+        std::unique_lock<std::mutex> lck(m_context->lock);
+
+        if (!recovered)
+        {
+            ++m_context->stats.invalid_signatures;
+            return Status::INVALID;
+        }
+
+        //completed or canceled while signature was verified
+        auto it = m_context->pending.find(digest);
+        if (it == m_context->pending.end())
+            return Status::UNKNOWN;
+
+        //signer is not expected (or transaction was expected again with other signers)
+        auto&& transaction = it->second;
+        auto signer_it = transaction.signatures.find(signer);
+        if (signer_it == transaction.signatures.end())
+        {
+            ++m_context->stats.invalid_signatures;
+            return Status::INVALID;
+        }
+
+        auto&& slot = signer_it->second;
+        if (!slot.empty())
+        {
+            //the same signer has sent other signature concurrently
+            ++m_context->stats.duplicate_signatures;
+            return Status::DUPLICATE;
+        }
+
+        slot = signature;
+        ++m_context->stats.accepted_signatures;
+        if (!transaction.received++)
+            transaction.first_signature_at = now;
+
+        if (transaction.received < transaction.signatures.size())
+            return Status::ACCEPTED;
+
+        request = std::move(transaction.request);
+        for (auto&& item : transaction.signatures)
+            signatures.emplace(item.second);
+        latency.first_signature = elapsed(transaction.expected_at, transaction.first_signature_at);
+        latency.complete = elapsed(transaction.expected_at, now);
+
+        m_context->pending.erase(it);
+
+        auto&& stats = m_context->stats;
+        --stats.pending;
+        ++stats.completed;
+        stats.total_latency += latency.complete;
+        stats.max_latency = std::max(stats.max_latency, latency.complete);
+    }
+
+    m_context->on_complete(m_context->builder.makeBroadcastTransaction(request, signatures), digest, latency);
+
+    return Status::COMPLETED;
+}
+
+PlaychainSignatureCollectorStats PlaychainSignatureCollector::stats() const
+{
+    std::unique_lock<std::mutex> lck(m_context->lock);
+
+    return m_context->stats;
+}
+
+} // namespace tp
@@ -0,0 +1,89 @@
+#include <playchain/tracing.h>
+
+#include "tracing.h"
+
+#include <cstring>
+
+namespace playchain {
+namespace tracing {
+
+std::atomic<bool> attached { false };
+thread_local span* current_span = nullptr;
+
+namespace {
+    using handler_type = tp::PlaychainTracing::Handler;
+
+    //replaced atomically, span being finished keeps previous handler alive;
+    //never destroyed, threads can finish spans after static destructors
+    std::shared_ptr<handler_type>& get_handler()
+    {
+        static auto* handler = new std::shared_ptr<handler_type>;
+        return *handler;
+    }
+
+    std::atomic<uint64_t> last_span_id { 0 };
+} // namespace
+
+void span::start()
+{
+    //overloads calling each other are traced once
+    if (current_span && current_span->_kind == _kind && !std::strcmp(current_span->_name, _name))
+        return;
+
+    _data.reset(new tp::PlaychainSpan);
+    _data->kind = _kind;
+    _data->name = _name;
+    _data->id = ++last_span_id;
+    if (current_span)
+        _data->parent_id = current_span->_data->id;
+
+    _parent = current_span;
+    current_span = this;
+
+    _data->start = std::chrono::steady_clock::now();
+}
+
+void span::finish()
+{
+    _data->finish = std::chrono::steady_clock::now();
+
+    current_span = _parent;
+
+    _data->bytes = _bytes;
+    _data->failed = _failed;
+
+    auto handler = std::atomic_load(&get_handler());
+    if (!handler)
+        return;
+
+    //exception from destructor would terminate
+    try
+    {
+        (*handler)(*_data);
+    }
+    catch (...)
+    {
+    }
+}
+
+} // namespace tracing
+} // namespace playchain
+
+namespace tp {
+
+void PlaychainTracing::setHandler(const Handler& handler)
+{
+    std::shared_ptr<Handler> value;
+    if (handler)
+        value = std::make_shared<Handler>(handler);
+
+    std::atomic_store(&playchain::tracing::get_handler(), value);
+    playchain::tracing::attached = value != nullptr;
+}
+
+bool PlaychainTracing::attached()
+{
+    return playchain::tracing::attached;
+}
+
+} // namespace tp
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <playchain/tracing.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+//Span hooks of pipeline stages (see include/playchain/tracing.h)
+
+#if defined(PLAYCHAIN_USDT)
+#include <sys/sdt.h>
+
+#define PLAYCHAIN_PROBE1(NAME, A1) DTRACE_PROBE1(playchain, NAME, A1)
+#define PLAYCHAIN_PROBE2(NAME, A1, A2) DTRACE_PROBE2(playchain, NAME, A1, A2)
+#define PLAYCHAIN_PROBE4(NAME, A1, A2, A3, A4) DTRACE_PROBE4(playchain, NAME, A1, A2, A3, A4)
+#else
+#define PLAYCHAIN_PROBE1(NAME, A1) ((void)0)
+#define PLAYCHAIN_PROBE2(NAME, A1, A2) ((void)0)
+#define PLAYCHAIN_PROBE4(NAME, A1, A2, A3, A4) ((void)0)
+#endif //!PLAYCHAIN_USDT
+
+namespace playchain {
+namespace tracing {
+
+    extern std::atomic<bool> attached;
+
+    class span;
+    //the innermost traced span of thread
+    extern thread_local span* current_span;
+
+    class span
+    {
+    public:
+        using kind_type = tp::PlaychainSpan::Kind;
+
+        span(const kind_type kind, const char* name, const size_t bytes = 0)
+            : _kind(kind)
+            , _name(name)
+            , _bytes(bytes)
+        {
+            PLAYCHAIN_PROBE2(span_start, (int)kind, name);
+
+            if (attached.load(std::memory_order_relaxed))
+                start();
+        }
+        ~span()
+        {
+            PLAYCHAIN_PROBE4(span_end, (int)_kind, _name, _bytes, (int)_failed);
+
+            if (_data)
+                finish();
+        }
+
+        span(const span&) = delete;
+        span& operator=(const span&) = delete;
+
+        //subscriber is attached, digest should be set then
+        bool traced() const
+        {
+            return _data != nullptr;
+        }
+
+        void set_digest(const std::string& digest)
+        {
+            if (_data)
+                _data->digest = digest;
+        }
+        void add_bytes(const size_t bytes)
+        {
+            _bytes += bytes;
+        }
+        void fail()
+        {
+            _failed = true;
+        }
+
+    private:
+        void start();
+        void finish();
+
+        const kind_type _kind;
+        const char* _name;
+        size_t _bytes = 0;
+        bool _failed = false;
+        //allocated only for subscriber
+        std::unique_ptr<tp::PlaychainSpan> _data;
+        span* _parent = nullptr;
+    };
+
+    inline void fail()
+    {
+        if (attached.load(std::memory_order_relaxed) && current_span)
+            current_span->fail();
+    }
+} // namespace tracing
+} // namespace playchain
+
+#define PLAYCHAIN_TRACE_SPAN_BYTES(KIND, BYTES) \
+    playchain::tracing::span playchain_trace_span { tp::PlaychainSpan::Kind::KIND, __func__, BYTES }
+
+#define PLAYCHAIN_TRACE_SPAN(KIND) PLAYCHAIN_TRACE_SPAN_BYTES(KIND, 0)
+#define PLAYCHAIN_TRACE_BYTES(BYTES) playchain_trace_span.add_bytes(BYTES)
+#define PLAYCHAIN_TRACE_DIGEST(DIGEST) playchain_trace_span.set_digest(DIGEST)
+#define PLAYCHAIN_TRACE_FAILURE() playchain::tracing::fail()
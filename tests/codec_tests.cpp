@@ -0,0 +1,510 @@
+#include "playchain_tests_common.h"
+
+#include "../src/number_codec.h"
+#include "../src/convert_helper.h"
+#include "../src/hex_codec.h"
+#include "../src/base58.h"
+#include "../src/sha256.h"
+#include "../src/sha256_kernels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+namespace codec_tests {
+using namespace tp;
+
+namespace utility = playchain::test;
+
+BOOST_AUTO_TEST_SUITE(codec_tests)
+
+BOOST_AUTO_TEST_CASE(format_number_check)
+{
+    char buff[playchain::uint64_max_chars];
+
+    for (uint64_t value : { (uint64_t)0, (uint64_t)7, (uint64_t)10, (uint64_t)99, (uint64_t)100, (uint64_t)12345,
+                            (uint64_t)1000000000000, std::numeric_limits<uint64_t>::max() })
+    {
+        std::stringstream ss;
+        ss << value;
+
+        BOOST_CHECK_EQUAL(std::string(buff, playchain::format_uint64(value, buff)), ss.str());
+    }
+
+    for (int64_t value : { (int64_t)0, (int64_t)-1, (int64_t)-100, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() })
+    {
+        std::stringstream ss;
+        ss << value;
+
+        BOOST_CHECK_EQUAL(std::string(buff, playchain::format_int64(value, buff)), ss.str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parse_number_check)
+{
+    uint64_t value = 0;
+
+    BOOST_CHECK(playchain::parse_uint64("0", value));
+    BOOST_CHECK_EQUAL(value, 0u);
+    BOOST_CHECK(playchain::parse_uint64("1234567890", value));
+    BOOST_CHECK_EQUAL(value, 1234567890u);
+    BOOST_CHECK(playchain::parse_uint64("18446744073709551615", value));
+    BOOST_CHECK_EQUAL(value, std::numeric_limits<uint64_t>::max());
+
+    BOOST_CHECK(!playchain::parse_uint64("", value));
+    BOOST_CHECK(!playchain::parse_uint64("18446744073709551616", value));
+    BOOST_CHECK(!playchain::parse_uint64("99999999999999999999", value));
+    BOOST_CHECK(!playchain::parse_uint64("-1", value));
+    BOOST_CHECK(!playchain::parse_uint64("+1", value));
+    BOOST_CHECK(!playchain::parse_uint64(" 1", value));
+    BOOST_CHECK(!playchain::parse_uint64("12a", value));
+    BOOST_CHECK(!playchain::parse_uint64("1.5", value));
+
+    //value is not changed by error
+    BOOST_CHECK_EQUAL(value, std::numeric_limits<uint64_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(object_id_check)
+{
+    BOOST_CHECK_EQUAL((std::string)PlaychainUserId { 10 }, "1.2.10");
+    BOOST_CHECK_EQUAL((std::string)PlaychainTableId { 123 }, "3.4.123");
+    BOOST_CHECK_EQUAL((std::string)PlaychainAssetId {}, "1.3.-1");
+    BOOST_CHECK_EQUAL((std::string)PlaychainTableId { std::numeric_limits<int>::max() }, "3.4.2147483647");
+
+    for (int instance : { 0, 1, 9, 10, 99, 100, 65536, std::numeric_limits<int>::max() })
+    {
+        PlaychainRoomId id { instance };
+        BOOST_CHECK_EQUAL(PlaychainRoomId::from_string((std::string)id).instance, instance);
+    }
+
+    BOOST_CHECK_EQUAL(PlaychainUserId::from_string("1.2.10").instance, 10);
+    BOOST_CHECK_EQUAL(PlaychainUserId::from_string("1.2.10xyz", 6).instance, 10);
+
+    //other object type
+    BOOST_CHECK(!PlaychainUserId::from_string("1.3.10").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string("3.2.10").valid());
+    //malformed
+    BOOST_CHECK(!PlaychainUserId::from_string("").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string("1.2").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string("1.2.").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string(".1.2.10").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string("1.2.10.").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string("1.2.-10").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string("1.2.1x").valid());
+    //instance out of range
+    BOOST_CHECK(!PlaychainUserId::from_string("1.2.2147483648").valid());
+    BOOST_CHECK(!PlaychainUserId::from_string("1.2.99999999999999999999999").valid());
+}
+
+BOOST_AUTO_TEST_CASE(string_amount_check)
+{
+    utility::parser_fixture fixture;
+
+    auto response = R"j(
+                    {
+                        "id": 0,
+                        "jsonrpc": "2.0",
+                        "result": [
+                            {"id": "3.4.1", "metadata": "", "required_witnesses": 0, "state": "free",
+                             "owner": "1.2.10", "owner_name": "andrew", "server_url": "",
+                             "min_accepted_proposal_asset": {"amount": "18446744073709551615", "asset_id": "1.3.0"},
+                             "pending_proposals": [], "cash": [], "playing_cash": [], "missed_voters": []}
+                        ]
+                    }
+                   )j";
+
+    auto&& result = fixture.parser.parseGetTablesInfoResponse(response);
+
+    BOOST_REQUIRE(result.valid());
+
+    const std::vector<PlaychainTableInfoExt>& tables = result;
+
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_CHECK_EQUAL(tables[0].min_accepted_proposal_asset, std::numeric_limits<uint64_t>::max());
+
+    std::string malformed = response;
+    malformed.replace(malformed.find("18446744073709551615"), 20, "1844674407370955161x");
+
+    BOOST_CHECK(!fixture.parser.parseGetTablesInfoResponse(malformed).valid());
+}
+
+BOOST_AUTO_TEST_CASE(iso_time_check)
+{
+    BOOST_CHECK_EQUAL(playchain::from_iso_string("1970-01-01T00:00:00"), 0);
+    BOOST_CHECK_EQUAL(playchain::from_iso_string("2000-02-29T12:00:00"), 951825600);
+    BOOST_CHECK_EQUAL(playchain::from_iso_string("2038-01-19T03:14:07"), 2147483647);
+    BOOST_CHECK_EQUAL(playchain::from_iso_string("2018-12-06T10:28:20"), 1544092100);
+    //fractions and zone designator of node time are ignored
+    BOOST_CHECK_EQUAL(playchain::from_iso_string("2018-12-06T10:28:20.500Z"), 1544092100);
+
+    BOOST_CHECK_EQUAL(playchain::to_iso_string(0), "1970-01-01T00:00:00");
+    BOOST_CHECK_EQUAL(playchain::to_iso_string(951825600), "2000-02-29T12:00:00");
+    BOOST_CHECK_EQUAL(playchain::to_iso_string(4102444799), "2099-12-31T23:59:59");
+
+    //round trip over days of several 400-year cycles and times of day
+    char buff[playchain::iso_time_chars];
+    for (int64_t t = -62135596800; t < 253402300800; t += 86400 * 7 + 3607)
+    {
+        const size_t size = playchain::format_iso_time(t, buff);
+        BOOST_REQUIRE_EQUAL(size, playchain::iso_time_chars);
+
+        int64_t parsed = 0;
+        BOOST_REQUIRE(playchain::parse_iso_time(buff, buff + size, parsed));
+        BOOST_REQUIRE_EQUAL(parsed, t);
+    }
+
+    for (const char* invalid : { "", "2018-12-06", "2018-12-06T10:28", "2018-12-06 10:28:20", "2018/12/06T10:28:20",
+                                 "2018-13-06T10:28:20", "2018-00-06T10:28:20", "2018-12-00T10:28:20", "2018-12-32T10:28:20",
+                                 "2018-02-29T10:28:20", "1900-02-29T10:28:20", "2018-12-06T24:28:20", "2018-12-06T10:60:20",
+                                 "2018-12-06T10:28:60", "2018-1a-06T10:28:20", "-018-12-06T10:28:20" })
+    {
+        int64_t parsed = 0;
+        BOOST_CHECK_MESSAGE(!playchain::parse_iso_time(invalid, invalid + std::strlen(invalid), parsed), invalid);
+        BOOST_CHECK_EQUAL(playchain::from_iso_string(invalid), 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(plc_round_trip_check)
+{
+    //amounts of all fractional lengths and large integer parts
+    for (PlaychainMoney amount : { (PlaychainMoney)0, (PlaychainMoney)1, (PlaychainMoney)10, (PlaychainMoney)120,
+                                   (PlaychainMoney)99999, (PlaychainMoney)100000, (PlaychainMoney)100001, (PlaychainMoney)125000,
+                                   (PlaychainMoney)67001000, std::numeric_limits<PlaychainMoney>::max() })
+    {
+        PlaychainPLC plc { amount };
+        BOOST_CHECK_EQUAL(PlaychainPLC::from_string(plc.str()).amount(), amount);
+    }
+
+    uint64_t seed = 88172645463325252ull;
+    for (size_t ci = 0; ci < 100000; ++ci)
+    {
+        //xorshift
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        const PlaychainMoney amount = seed >> (seed % 64);
+
+        char buff[PlaychainPLC::max_chars];
+        const size_t size = PlaychainPLC { amount }.format(buff);
+        BOOST_REQUIRE_EQUAL(PlaychainPLC::from_string(buff, size).amount(), amount);
+    }
+
+    BOOST_CHECK_EQUAL(PlaychainPLC { 0 }.str(), "0 PLC");
+    BOOST_CHECK_EQUAL(PlaychainPLC { 100001 }.str(), "1.00001 PLC");
+    BOOST_CHECK_EQUAL(PlaychainPLC { 120 }.str(), "0.0012 PLC");
+    BOOST_CHECK_EQUAL(PlaychainPLC::from_string("1,5 PLC").amount(), 150000u);
+    BOOST_CHECK_EQUAL(PlaychainPLC::from_string("2 \t PLC").amount(), 200000u);
+    BOOST_CHECK_EQUAL(PlaychainPLC::from_string("2").amount(), 0u);
+    BOOST_CHECK_EQUAL(PlaychainPLC::from_string("").amount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_version_check)
+{
+    for (uint32_t v_num : { 0u, 0x01020003u, 0x0101ffffu, 0xffffffffu, 0x0a0b0c0du })
+    {
+        ProtocolVersion version;
+        version.v_num = v_num;
+
+        for (const char* metadata : { "", "beta", "rc+1" })
+        {
+            version.metadata = metadata;
+
+            ProtocolVersion parsed { (std::string)version };
+            BOOST_CHECK_EQUAL(parsed.v_num, v_num);
+            BOOST_CHECK_EQUAL(parsed.metadata, version.metadata);
+        }
+    }
+
+    BOOST_CHECK_EQUAL((std::string)ProtocolVersion { 1, 2, 300 }, "1.2.300");
+    BOOST_CHECK_EQUAL(ProtocolVersion { "1_2_3" }.v_num, ProtocolVersion(1, 2, 3).v_num);
+
+    for (const char* invalid : { "", "1.2", "1.2.", "1.2_3", "1..3", "a.b.c", "1.2.3x", " 1.2.3", "256.0.0", "0.256.0", "0.0.65536" })
+        BOOST_CHECK_THROW(ProtocolVersion { invalid }, std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(hex_kernels_check)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    std::vector<uint8_t> data(300);
+    for (size_t ci = 0; ci < data.size(); ++ci)
+        data[ci] = (uint8_t)(ci * 167 + 13);
+
+    for (const auto& kernel : playchain::supported_hex_kernels())
+    {
+        BOOST_TEST_CHECKPOINT(kernel.name);
+
+        //sizes around vector widths
+        for (size_t size = 0; size <= data.size(); size += (size < 70 ? 1 : 23))
+        {
+            std::string hex(size * 2, '\0');
+            kernel.encode(data.data(), size, &hex[0]);
+
+            std::string required;
+            for (size_t ci = 0; ci < size; ++ci)
+            {
+                required += digits[data[ci] >> 4];
+                required += digits[data[ci] & 0x0f];
+            }
+            BOOST_REQUIRE_EQUAL(hex, required);
+
+            std::vector<uint8_t> decoded(size);
+            BOOST_REQUIRE(kernel.decode(hex.data(), hex.size(), decoded.data()));
+            BOOST_REQUIRE(std::equal(decoded.begin(), decoded.end(), data.begin()));
+
+            std::string upper = hex;
+            for (auto& ch : upper)
+                ch = (char)std::toupper(ch);
+            BOOST_REQUIRE(kernel.decode(upper.data(), upper.size(), decoded.data()));
+            BOOST_REQUIRE(std::equal(decoded.begin(), decoded.end(), data.begin()));
+
+            //invalid character at every position
+            for (size_t pos = 0; pos < hex.size(); pos += (size < 70 ? 1 : 7))
+            {
+                for (char invalid : { 'g', 'G', '/', ':', '@', '`', ' ', '\0', (char)0x80, (char)0xb0 })
+                {
+                    std::string malformed = hex;
+                    malformed[pos] = invalid;
+                    BOOST_REQUIRE(!kernel.decode(malformed.data(), malformed.size(), decoded.data()));
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hex_conversions_check)
+{
+    const uint8_t data[] = { 0x00, 0x01, 0x7f, 0x80, 0xab, 0xff };
+
+    BOOST_CHECK_EQUAL(playchain::to_hex(data, sizeof(data)), "00017f80abff");
+    BOOST_CHECK_EQUAL(playchain::to_hex(data, 0), "");
+
+    uint8_t decoded[sizeof(data)] = {};
+    BOOST_CHECK_EQUAL(playchain::from_hex("00017F80ABff", decoded, sizeof(decoded)), sizeof(data));
+    BOOST_CHECK(std::equal(decoded, decoded + sizeof(decoded), data));
+
+    //odd character is the high nibble of the last byte
+    BOOST_CHECK_EQUAL(playchain::from_hex("abc", decoded, sizeof(decoded)), 2u);
+    BOOST_CHECK_EQUAL(decoded[1], 0xc0);
+    //output is limited by buffer
+    BOOST_CHECK_EQUAL(playchain::from_hex("0102030405060708", decoded, 3), 3u);
+    BOOST_CHECK_EQUAL(decoded[2], 0x03);
+
+    BOOST_CHECK_THROW(playchain::from_hex("01x2", decoded, sizeof(decoded)), std::logic_error);
+    BOOST_CHECK_THROW(playchain::from_hex("01g", decoded, sizeof(decoded)), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(base58_vectors_check)
+{
+    struct base58_vector
+    {
+        const char* hex;
+        const char* base58;
+    };
+    const base58_vector vectors[] = {
+        { "", "" },
+        { "61", "2g" },
+        { "626262", "a3gV" },
+        { "636363", "aPEr" },
+        { "73696d706c792061206c6f6e6720737472696e67", "2cFupjhnEsSn59qHXstmK2ffpLv2" },
+        { "00eb15231dfceb60925886b67d065299925915aeb172c06647", "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L" },
+        { "516b6fcd0f", "ABnLTmg" },
+        { "bf4f89001e670274dd", "3SEo3LWLoPntC" },
+        { "572e4794", "3EFU7m" },
+        { "ecac89cad93923c02321", "EJDM8drfXA6uyA" },
+        { "10c8511e", "Rt5zm" },
+        { "00000000000000000000", "1111111111" },
+    };
+
+    for (const auto& vector : vectors)
+    {
+        BOOST_TEST_CHECKPOINT(vector.base58);
+
+        std::vector<char> data(strlen(vector.hex) / 2);
+        if (!data.empty())
+            playchain::from_hex(vector.hex, data.data(), data.size());
+
+        BOOST_CHECK_EQUAL(playchain::to_base58(data), vector.base58);
+        BOOST_CHECK_EQUAL(playchain::to_base58_ct(data.data(), data.size()), vector.base58);
+        BOOST_CHECK(playchain::from_base58(vector.base58) == data);
+        BOOST_CHECK(playchain::from_base58_ct(vector.base58) == data);
+    }
+
+    //PLC public key without prefix (33 bytes of key and 4 bytes of checksum)
+    const std::string key = "7SijQHeekG9yYLK8cxwM9GRCiqbyUSubRsk4uMj2tifUdt3nYZ";
+    const auto key_data = playchain::from_base58(key);
+    BOOST_CHECK_EQUAL(key_data.size(), 37u);
+    BOOST_CHECK_EQUAL(playchain::to_base58(key_data), key);
+}
+
+BOOST_AUTO_TEST_CASE(base58_round_trip_check)
+{
+    //payloads on stack and longer ones, with and without leading zeros
+    for (size_t size : { 1, 4, 5, 25, 33, 37, 64, 65, 200 })
+    {
+        for (size_t zeros : { 0, 1, 3 })
+        {
+            BOOST_TEST_CHECKPOINT(size << " bytes with " << zeros << " zeros");
+
+            std::vector<uint8_t> data(size);
+            for (size_t ci = 0; ci < size; ++ci)
+                data[ci] = ci < zeros ? 0 : (uint8_t)(ci * 131 + 7);
+
+            std::string encoded(playchain::base58_max_chars(size), '\0');
+            const size_t encoded_size = playchain::encode_base58(data.data(), size, &encoded[0]);
+            BOOST_REQUIRE_LE(encoded_size, encoded.size());
+            encoded.resize(encoded_size);
+
+            std::string encoded_ct(playchain::base58_max_chars(size), '\0');
+            encoded_ct.resize(playchain::encode_base58_ct(data.data(), size, &encoded_ct[0]));
+            BOOST_REQUIRE_EQUAL(encoded, encoded_ct);
+            BOOST_REQUIRE_EQUAL(encoded.find_first_not_of('1'), zeros < size ? zeros : std::string::npos);
+
+            std::vector<uint8_t> decoded(playchain::base58_max_bytes(encoded.size()));
+            size_t decoded_size = 0;
+            BOOST_REQUIRE(playchain::decode_base58(encoded.data(), encoded.size(), decoded.data(), decoded.size(), decoded_size));
+            BOOST_REQUIRE_EQUAL(decoded_size, size);
+            BOOST_REQUIRE(std::equal(data.begin(), data.end(), decoded.begin()));
+
+            BOOST_REQUIRE(playchain::decode_base58_ct(encoded.data(), encoded.size(), decoded.data(), decoded.size(), decoded_size));
+            BOOST_REQUIRE_EQUAL(decoded_size, size);
+            BOOST_REQUIRE(std::equal(data.begin(), data.end(), decoded.begin()));
+
+            //too small buffer
+            BOOST_REQUIRE(!playchain::decode_base58(encoded.data(), encoded.size(), decoded.data(), size - 1, decoded_size));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(base58_invalid_check)
+{
+    for (const char* invalid : { "0", "O2g", "2gI", "2lg", "2g+", "a3 gV", "\x80" })
+    {
+        BOOST_TEST_CHECKPOINT(invalid);
+
+        BOOST_CHECK_THROW(playchain::from_base58(invalid), std::logic_error);
+        BOOST_CHECK_THROW(playchain::from_base58_ct(invalid), std::logic_error);
+    }
+
+    //spaces around are skipped
+    BOOST_CHECK(playchain::from_base58("  2g\n") == std::vector<char> { 'a' });
+
+    char out[3] = {};
+    BOOST_CHECK_EQUAL(playchain::from_base58("a3gV", out, sizeof(out)), 3u);
+    BOOST_CHECK_THROW(playchain::from_base58("a3gV", out, 2), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(sha256_encoder_check)
+{
+    struct sha256_vector
+    {
+        std::string message;
+        const char* digest;
+    };
+    const sha256_vector vectors[] = {
+        { "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+        { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+        { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+          "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1" },
+        { std::string(1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+    };
+
+    for (const auto& vector : vectors)
+    {
+        BOOST_TEST_CHECKPOINT(vector.message.size() << " bytes");
+
+        BOOST_CHECK_EQUAL(playchain::sha256::hash(vector.message).str(), vector.digest);
+
+        //small writes of packed fields
+        for (size_t step : { 1, 3, 7, 63, 65 })
+        {
+            playchain::sha256::encoder encoder;
+            for (size_t pos = 0; pos < vector.message.size(); pos += step)
+                encoder.write(vector.message.data() + pos, (uint32_t)std::min(step, vector.message.size() - pos));
+            BOOST_CHECK_EQUAL(encoder.result().str(), vector.digest);
+        }
+    }
+
+    playchain::sha256::encoder encoder;
+    encoder.write("garbage", 7);
+    encoder.reset();
+    encoder.put('a');
+    encoder.write("bc", 2);
+    BOOST_CHECK_EQUAL(encoder.result().str(), vectors[1].digest);
+}
+
+BOOST_AUTO_TEST_CASE(sha256_kernels_check)
+{
+    std::vector<uint8_t> blocks(playchain::sha256_block_size * 9);
+    for (size_t ci = 0; ci < blocks.size(); ++ci)
+        blocks[ci] = (uint8_t)(ci * 131 + 7);
+
+    const auto& scalar = playchain::supported_sha256_kernels().front();
+
+    for (const auto& kernel : playchain::supported_sha256_kernels())
+    {
+        //odd and even counts for two blocks AVX2 schedule
+        for (size_t count = 0; count <= 9; ++count)
+        {
+            BOOST_TEST_CHECKPOINT(kernel.name << ", " << count << " blocks");
+
+            uint32_t required[8];
+            std::memcpy(required, playchain::sha256_initial_state, sizeof(required));
+            scalar.compress(required, blocks.data(), count);
+
+            uint32_t state[8];
+            std::memcpy(state, playchain::sha256_initial_state, sizeof(state));
+            kernel.compress(state, blocks.data(), count);
+
+            BOOST_REQUIRE(std::equal(state, state + 8, required));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha256_lanes_check)
+{
+    //messages with one and two padding blocks, longer than lanes count
+    std::vector<std::string> messages;
+    for (size_t ci = 0; ci < 70; ++ci)
+    {
+        const size_t size = (ci * 37) % 300;
+        std::string message(size, '\0');
+        for (size_t cj = 0; cj < size; ++cj)
+            message[cj] = (char)(ci + cj * 131);
+        messages.push_back(message);
+    }
+
+    std::vector<const uint8_t*> data;
+    std::vector<size_t> sizes;
+    for (const auto& message : messages)
+    {
+        data.push_back((const uint8_t*)message.data());
+        sizes.push_back(message.size());
+    }
+
+    for (const auto& kernel : playchain::supported_sha256_lanes_kernels())
+    {
+        for (size_t count : std::vector<size_t> { 0, 1, 3, kernel.lanes, kernel.lanes + 1, messages.size() })
+        {
+            BOOST_TEST_CHECKPOINT(kernel.name << ", " << count << " messages");
+
+            std::vector<uint8_t> digests(count * 32);
+            playchain::sha256_hash_lanes(kernel, data.data(), sizes.data(), count, digests.data());
+
+            for (size_t ci = 0; ci < count; ++ci)
+                BOOST_REQUIRE_EQUAL(playchain::to_hex(digests.data() + ci * 32, 32), playchain::sha256::hash(messages[ci]).str());
+        }
+    }
+
+    std::vector<playchain::sha256> digests(messages.size());
+    playchain::sha256::hash_batch((const char* const*)data.data(), sizes.data(), messages.size(), digests.data());
+    for (size_t ci = 0; ci < messages.size(); ++ci)
+        BOOST_CHECK(digests[ci] == playchain::sha256::hash(messages[ci]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace codec_tests
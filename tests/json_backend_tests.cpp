@@ -0,0 +1,236 @@
+#include "playchain_tests_common.h"
+
+#include "../src/json_backend.h"
+
+namespace json_backend_tests {
+using namespace tp;
+
+namespace utility = playchain::test;
+
+//Conformance of parse paths (DOM, SAX stream from C string and from buffer,
+//in-situ, lazy views) with SIMD scanning of JSON selected by build
+
+//recorded get_tables_info response
+const char* tables_response = R"j({"id":3,"jsonrpc":"2.0","result":[{"id":"3.4.1","metadata":"{\"bb_price\":100000,\"rake\":450,\"game\":\"TP\",\"info\":\"master\",\"min_bb\":40,\"max_bb\":100,\"chips_bb\":10}","required_witnesses":2,"owner":"1.2.10","owner_name":"andrew","state":"playing","server_url":"stage.totalpoker.io:8092","min_accepted_proposal_asset":{"amount":20000,"asset_id":"1.3.0"},"pending_proposals":[["1.2.14",{"name":"dave","id":"3.7.3","uid":"e3a1f0","amount":{"amount":10000,"asset_id":"1.3.0"}}]],"cash":[["1.2.11",{"name":"alice","amount":{"amount":100,"asset_id":"1.3.0"}}],["1.2.12",{"name":"bob","amount":{"amount":200,"asset_id":"1.3.0"}}]],"playing_cash":[["1.2.11",{"name":"alice","amount":{"amount":50,"asset_id":"1.3.0"}}]],"missed_voters":[["1.2.13","carol"]]},{"id":"3.4.2","metadata":"{\"bb_price\":1000,\"rake\":450,\"game\":\"TP\",\"min_bb\":40,\"max_bb\":100,\"chips_bb\":10}","required_witnesses":0,"owner":"1.2.11","owner_name":"alice","state":"free","server_url":"","min_accepted_proposal_asset":{"amount":0,"asset_id":"1.3.0"},"pending_proposals":[],"cash":[],"playing_cash":[],"missed_voters":[]}]})j";
+
+//recorded list_rooms response
+const char* rooms_response = R"j({"id":7,"jsonrpc":"2.0","result":[{"id":"3.2.1","owner":"1.2.10","metadata":"{\"info\":\"main\"}","server_url":"stage.totalpoker.io:8092","protocol_version":{"metadata":"","base":{"v_num":16842752}},"rating":17},{"id":"3.2.5","owner":"1.2.11","metadata":"{}","server_url":"","protocol_version":{"metadata":"beta","base":{"v_num":16842753}},"rating":0}]})j";
+
+//puts new line and indent after every structural character
+//to move the rest of JSON along SIMD block boundaries
+std::string reformat(const std::string& json, const size_t indent)
+{
+    std::string result;
+    bool in_string = false;
+    bool escaped = false;
+    for (char ch : json)
+    {
+        result += ch;
+        if (in_string)
+        {
+            if (escaped)
+                escaped = false;
+            else if (ch == '\\')
+                escaped = true;
+            else if (ch == '"')
+                in_string = false;
+            continue;
+        }
+        if (ch == '"')
+            in_string = true;
+        else if (ch == '{' || ch == '[' || ch == ',' || ch == ':')
+            result += '\n' + std::string(indent, ' ');
+    }
+    return result;
+}
+
+void check_equal(const PlaychainTableInfoExt& a, const PlaychainTableInfoExt& b)
+{
+    BOOST_CHECK_EQUAL((std::string)a.id, (std::string)b.id);
+    BOOST_CHECK_EQUAL((std::string)a.owner, (std::string)b.owner);
+    BOOST_CHECK_EQUAL(a.owner_name, b.owner_name);
+    BOOST_CHECK_EQUAL(a.metadata, b.metadata);
+    BOOST_CHECK_EQUAL(a.server_url, b.server_url);
+    BOOST_CHECK_EQUAL(a.required_witnesses, b.required_witnesses);
+    BOOST_CHECK_EQUAL(a.min_accepted_proposal_asset, b.min_accepted_proposal_asset);
+    BOOST_CHECK_EQUAL((int)a.state, (int)b.state);
+
+    BOOST_REQUIRE_EQUAL(a.pending_proposals.size(), b.pending_proposals.size());
+    for (const auto& item : a.pending_proposals)
+    {
+        const auto& other = b.pending_proposals.at(item.first);
+        BOOST_CHECK_EQUAL(item.second.name, other.name);
+        BOOST_CHECK_EQUAL((std::string)item.second.id, (std::string)other.id);
+        BOOST_CHECK_EQUAL(item.second.uid, other.uid);
+        BOOST_CHECK_EQUAL(item.second.amount, other.amount);
+    }
+    BOOST_REQUIRE_EQUAL(a.cash.size(), b.cash.size());
+    for (const auto& item : a.cash)
+    {
+        BOOST_CHECK_EQUAL(item.second.name, b.cash.at(item.first).name);
+        BOOST_CHECK_EQUAL(item.second.amount, b.cash.at(item.first).amount);
+    }
+    BOOST_REQUIRE_EQUAL(a.playing_cash.size(), b.playing_cash.size());
+    for (const auto& item : a.playing_cash)
+    {
+        BOOST_CHECK_EQUAL(item.second.name, b.playing_cash.at(item.first).name);
+        BOOST_CHECK_EQUAL(item.second.amount, b.playing_cash.at(item.first).amount);
+    }
+    BOOST_CHECK(a.missed_voters == b.missed_voters);
+}
+
+void check_equal(const std::vector<PlaychainTableInfoExt>& a, const std::vector<PlaychainTableInfoExt>& b)
+{
+    BOOST_REQUIRE_EQUAL(a.size(), b.size());
+    for (size_t ci = 0; ci < a.size(); ++ci)
+        check_equal(a[ci], b[ci]);
+}
+
+void check_equal(const PlaychainRoomInfo& a, const PlaychainRoomInfo& b)
+{
+    BOOST_CHECK_EQUAL((std::string)a.id, (std::string)b.id);
+    BOOST_CHECK_EQUAL((std::string)a.owner, (std::string)b.owner);
+    BOOST_CHECK_EQUAL(a.owner_name, b.owner_name);
+    BOOST_CHECK_EQUAL(a.metadata, b.metadata);
+    BOOST_CHECK_EQUAL(a.server_url, b.server_url);
+    BOOST_CHECK_EQUAL(a.rating, b.rating);
+    BOOST_CHECK_EQUAL(a.protocol_version.v_num, b.protocol_version.v_num);
+    BOOST_CHECK_EQUAL(a.protocol_version.metadata, b.protocol_version.metadata);
+}
+
+//tables decoded by every parse path
+std::vector<std::vector<PlaychainTableInfoExt>> parse_tables_by_all_paths(const PlaychainResponseParser& parser, const std::string& json)
+{
+    std::vector<std::vector<PlaychainTableInfoExt>> results;
+
+    auto&& dom = parser.parseGetTablesInfoResponse(json);
+    BOOST_REQUIRE(dom.valid());
+    results.push_back(dom);
+
+    std::vector<PlaychainTableInfoExt> buffer;
+    BOOST_REQUIRE(parser.parseGetTablesInfoResponse(BlockchainResponseView { json.data(), json.size() }, buffer));
+    results.push_back(buffer);
+
+    std::string insitu_copy = json;
+    std::vector<PlaychainTableInfoExt> insitu;
+    BOOST_REQUIRE(parser.parseGetTablesInfoResponse(BlockchainResponseView::insitu(insitu_copy), insitu));
+    results.push_back(insitu);
+
+    std::vector<PlaychainTableInfoExt> streamed;
+    BOOST_REQUIRE(parser.streamGetTablesInfoResponse(json, [&streamed](PlaychainTableInfoExt&& table) { streamed.emplace_back(std::move(table)); }).valid());
+    results.push_back(streamed);
+
+    auto&& view = parser.parseGetTablesInfoView(json);
+    BOOST_REQUIRE(view.valid());
+    std::vector<PlaychainTableInfoExt> lazy;
+    for (const auto& table : (const PlaychainTablesView&)view)
+        lazy.push_back(table.infoExt());
+    results.push_back(lazy);
+
+    return results;
+}
+
+BOOST_FIXTURE_TEST_SUITE(json_backend_tests, utility::parser_fixture)
+
+BOOST_AUTO_TEST_CASE(json_simd_check)
+{
+    const std::string simd = playchain::json_simd_name;
+    BOOST_CHECK(simd == "none" || simd == "sse2" || simd == "sse4.2" || simd == "neon");
+    BOOST_TEST_MESSAGE("JSON SIMD: " << simd);
+}
+
+BOOST_AUTO_TEST_CASE(tables_conformance_check)
+{
+    auto&& reference = parser.parseGetTablesInfoResponse(tables_response);
+    BOOST_REQUIRE(reference.valid());
+
+    const std::vector<PlaychainTableInfoExt>& expected = reference;
+    BOOST_REQUIRE_EQUAL(expected.size(), 2u);
+    BOOST_REQUIRE_EQUAL(expected[0].cash.size(), 2u);
+
+    for (size_t indent : { 0, 1, 7, 15, 16, 17, 31, 33 })
+    {
+        BOOST_TEST_CHECKPOINT("indent " << indent);
+
+        for (const auto& result : parse_tables_by_all_paths(parser, reformat(tables_response, indent)))
+            check_equal(result, expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(strings_conformance_check)
+{
+    //escapes at every offset of SIMD block
+    for (size_t offset = 0; offset < 40; ++offset)
+    {
+        BOOST_TEST_CHECKPOINT("offset " << offset);
+
+        const std::string padding(offset, 'x');
+        const std::string json = R"j({"id":1,"result":[{"id":"3.4.1","metadata":"{}","required_witnesses":0,"owner":"1.2.10","owner_name":")j"
+            + padding + R"j(\"q\\\/\b\f\n\r\té€","state":"free","server_url":")j" + padding
+            + R"j(","min_accepted_proposal_asset":{"amount":1,"asset_id":"1.3.0"},"pending_proposals":[],"cash":[],"playing_cash":[],"missed_voters":[]}]})j";
+
+        for (const auto& result : parse_tables_by_all_paths(parser, json))
+        {
+            BOOST_REQUIRE_EQUAL(result.size(), 1u);
+            BOOST_CHECK_EQUAL(result[0].owner_name, padding + "\"q\\/\b\f\n\r\t\xc3\xa9\xe2\x82\xac");
+            BOOST_CHECK_EQUAL(result[0].server_url, padding);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rooms_conformance_check)
+{
+    for (size_t indent : { 0, 5, 16 })
+    {
+        const std::string json = reformat(rooms_response, indent);
+
+        auto&& dom = parser.parseListRoomsResponse(json);
+        BOOST_REQUIRE(dom.valid());
+        const std::vector<PlaychainRoomInfo>& expected = dom;
+        BOOST_REQUIRE_EQUAL(expected.size(), 2u);
+        BOOST_CHECK_EQUAL(expected[0].rating, 17);
+        BOOST_CHECK_EQUAL(expected[1].protocol_version.metadata, "beta");
+
+        std::vector<PlaychainRoomInfo> streamed;
+        BOOST_REQUIRE(parser.streamListRoomsResponse(BlockchainResponseView { json.data(), json.size() },
+                                                     [&streamed](PlaychainRoomInfo&& room) { streamed.emplace_back(std::move(room)); })
+                          .valid());
+
+        auto&& view = parser.parseListRoomsView(json);
+        BOOST_REQUIRE(view.valid());
+        const PlaychainRoomsView& rooms = view;
+
+        BOOST_REQUIRE_EQUAL(streamed.size(), expected.size());
+        BOOST_REQUIRE_EQUAL(rooms.size(), expected.size());
+        for (size_t ci = 0; ci < expected.size(); ++ci)
+        {
+            check_equal(streamed[ci], expected[ci]);
+            check_equal(rooms[ci].info(), expected[ci]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(malformed_conformance_check)
+{
+    const std::string valid = tables_response;
+
+    for (const std::string& json : { valid.substr(0, valid.size() / 2),
+                                     valid + "}",
+                                     valid + " x",
+                                     valid + std::string(1, '\0') + " x",
+                                     std::string { R"j({"id":1,"result":[{"id":"3.4.1","owner_name":"a)j" } + '\x01' + R"j("}]})j",
+                                     std::string { R"j({"id":1,"result":[}]})j" } })
+    {
+        std::vector<PlaychainTableInfoExt> tables;
+
+        BOOST_CHECK(!parser.parseGetTablesInfoResponse(json).valid());
+        BOOST_CHECK(!parser.parseGetTablesInfoResponse(BlockchainResponseView { json.data(), json.size() }, tables));
+
+        std::string insitu_copy = json;
+        BOOST_CHECK(!parser.parseGetTablesInfoResponse(BlockchainResponseView::insitu(insitu_copy), tables));
+        BOOST_CHECK(!parser.parseGetTablesInfoView(json).valid());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace json_backend_tests
@@ -1,9 +1,11 @@
 #include "playchain_tests_common.h"
 
 #include "../src/convert_helper.h"
+#include "../src/base58.h"
 #include <playchain/playchain_helper.h>
+#include <playchain/public_key_cache.h>
 
-#include <rapidjson/document.h>
+#include "../src/json_backend.h"
 #include <rapidjson/prettywriter.h>
 
 namespace playchain {
@@ -229,6 +231,18 @@ namespace test {
 
         BOOST_CHECK(priv_key_from_wif(with_priv_key) == priv_key);
 
+        std::vector<std::string> wif_keys;
+        std::vector<PrivateKey> priv_keys;
+        for (size_t ci = 0; ci < 20; ++ci)
+        {
+            priv_keys.push_back(priv_key_from_brain_key("BRAIN KEY " + std::to_string(ci)));
+            wif_keys.push_back(priv_key_to_wif(priv_keys.back()));
+        }
+        BOOST_CHECK(priv_keys_from_wif(wif_keys) == priv_keys);
+
+        wif_keys[7].back() = wif_keys[7].back() == 'a' ? 'b' : 'a';
+        BOOST_CHECK_THROW(priv_keys_from_wif(wif_keys), std::logic_error);
+
         auto&& pub_key = public_key_from_key(priv_key);
 
         auto&& wellformatted_pub_key = public_key_to_string(pub_key);
@@ -244,6 +258,78 @@ namespace test {
         BOOST_CHECK(public_key_from_string(hex_pub_key) == pub_key);
     }
 
+    BOOST_AUTO_TEST_CASE(public_key_cache_check)
+    {
+        auto&& cache = PlaychainPublicKeyCache::instance();
+        cache.clear();
+
+        const std::string formatted_key = "PLC7SijQHeekG9yYLK8cxwM9GRCiqbyUSubRsk4uMj2tifUdt3nYZ";
+        const std::string hex_key = "0350936a99e896ac4d6f365ca24a60703a30548c266bdab063fed15deab34167c2";
+
+        auto&& pub_key = public_key_from_string(formatted_key);
+        BOOST_CHECK_EQUAL(cache.stats().misses, 1u);
+        BOOST_CHECK_EQUAL(cache.stats().size, 1u);
+
+        BOOST_CHECK(public_key_from_string(formatted_key) == pub_key);
+        BOOST_CHECK_EQUAL(cache.stats().hits, 1u);
+
+        //the same entry for reverse conversion
+        BOOST_CHECK_EQUAL(public_key_to_string(pub_key), formatted_key);
+        BOOST_CHECK_EQUAL(cache.stats().hits, 2u);
+        BOOST_CHECK_EQUAL(cache.stats().size, 1u);
+
+        //raw keys are not cached
+        BOOST_CHECK_EQUAL(public_key_to_string(pub_key, false), hex_key);
+        BOOST_CHECK(public_key_from_string(hex_key) == pub_key);
+        BOOST_CHECK_EQUAL(cache.stats().hits + cache.stats().misses, 3u);
+
+        //invalid keys are not cached
+        std::string invalid_key = formatted_key;
+        invalid_key.back() = 'X';
+        BOOST_CHECK_THROW(public_key_from_string(invalid_key), std::logic_error);
+        BOOST_CHECK_THROW(public_key_from_string(invalid_key), std::logic_error);
+        BOOST_CHECK_EQUAL(cache.stats().size, 1u);
+
+        //strings with spaces are decoded but key keeps its own string
+        cache.clear();
+        const std::string spaced_key = "PLC  " + formatted_key.substr(3) + " ";
+        BOOST_CHECK(public_key_from_string(spaced_key) == pub_key);
+        BOOST_CHECK_EQUAL(public_key_to_string(pub_key), formatted_key);
+        BOOST_CHECK_EQUAL(cache.stats().size, 1u);
+
+        //trailing bytes after checksum are ignored, key keeps its own string
+        cache.clear();
+        std::vector<char> trailing_data = playchain::from_base58(formatted_key.substr(3));
+        trailing_data.push_back('\x01');
+        const std::string trailing_key = "PLC" + playchain::to_base58(trailing_data);
+        BOOST_CHECK(public_key_from_string(trailing_key) == pub_key);
+        BOOST_CHECK_EQUAL(public_key_to_string(pub_key), formatted_key);
+        BOOST_CHECK_EQUAL(cache.stats().size, 1u);
+
+        //least recently used keys are evicted
+        cache.setCapacity(2);
+        std::vector<CompressedPublicKey> keys(3, pub_key);
+        keys[1][1] ^= 1;
+        keys[2][1] ^= 2;
+        std::vector<std::string> strings;
+        for (auto&& key : keys)
+            strings.push_back(public_key_to_string(key));
+        BOOST_CHECK_EQUAL(cache.stats().size, 2u);
+        BOOST_CHECK_EQUAL(cache.stats().evictions, 1u);
+
+        for (size_t ci = 0; ci < keys.size(); ++ci)
+            BOOST_CHECK(public_key_from_string(strings[ci]) == keys[ci]);
+        BOOST_CHECK_EQUAL(strings[0], formatted_key);
+
+        cache.setCapacity(0);
+        BOOST_CHECK_EQUAL(cache.stats().size, 0u);
+        BOOST_CHECK(public_key_from_string(formatted_key) == pub_key);
+        BOOST_CHECK_EQUAL(cache.stats().size, 0u);
+
+        cache.setCapacity(PlaychainPublicKeyCache::DEFAULT_CAPACITY);
+        cache.clear();
+    }
+
     BOOST_AUTO_TEST_CASE(sign_digest_with_helper_and_check)
     {
         auto&& brain_key = priv_key_from_brain_key("ACHER APHASIC STAP SEMBLE WAVICLE HAGWEED JUNIPER DARAT FOSSOR TOOL KOLKHOS CONNATE GILLING NOVA UNBORN HIERON");
@@ -261,6 +347,19 @@ namespace test {
         CompactSignature sign = sign_digest(digest, priv_key);
 
         BOOST_REQUIRE(check_signature(sign, digest, pub_key));
+
+        std::vector<Digest> digests(8, digest);
+        for (size_t ci = 1; ci < digests.size(); ++ci)
+            digests[ci][0] ^= (uint8_t)ci;
+
+        auto&& signs = sign_digests(digests, priv_key);
+        BOOST_REQUIRE_EQUAL(signs.size(), digests.size());
+        BOOST_CHECK(signs[0] == sign);
+        for (size_t ci = 0; ci < digests.size(); ++ci)
+        {
+            BOOST_CHECK(signs[ci] == sign_digest(digests[ci], priv_key));
+            BOOST_CHECK(check_signature(signs[ci], digests[ci], pub_key));
+        }
     }
 
     BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,9 @@
 
 #include <playchain/playchain_user.h>
 #include <playchain/playchain_helper.h>
+#include <playchain/keystore.h>
+
+#include <cstdio>
 
 namespace playchain_user_tests {
 using namespace tp;
@@ -41,5 +44,53 @@ BOOST_AUTO_TEST_CASE(sign_digest_check)
     BOOST_CHECK(check_signature(convert_signature(hex_sign), convert_digest(digest), user.getPublicKey()));
 }
 
+BOOST_AUTO_TEST_CASE(keystore_check)
+{
+    const std::string path = "playchain_keystore_check.bin";
+
+    PlaychainKeystore::create(path,
+                              { { "bob", PlaychainUserId { 1 }, "5HtDVv4JevGEUjtChnYzqvZNepHqMQPanaR45LyspFQmSnyoVDe" },
+                                { "alice", PlaychainUserId { 12 }, "5Kf3Z8fUUdrMVqbozbrUVB6mAb2FFXxmcZ4hL6FJFYheD3hSmHW" },
+                                { "carol", PlaychainUserId { 2 }, "5JMhpyYAJLkDFWkFNqSquXPDwzc8tYT94jznQACykP7qJ6WQFZT" } },
+                              "password");
+
+    BOOST_CHECK_THROW(PlaychainKeystore(path, "wrong password"), std::logic_error);
+
+    PlaychainKeystore keystore { path, "password" };
+
+    BOOST_CHECK_EQUAL(keystore.size(), 3u);
+
+    auto&& alice = keystore.findUser(PlaychainUserId { 12 });
+    BOOST_REQUIRE(alice);
+    BOOST_CHECK_EQUAL(alice->name(), "alice");
+    BOOST_CHECK_EQUAL(alice->getSerializedPublicKey(), "PLC6BcNK8CWGj6herX8nvhwEJ625QuaPAtmZPZ6yxQafFnSFnX9VY");
+
+    auto&& carol = keystore.findUser("carol");
+    BOOST_REQUIRE(carol);
+    BOOST_CHECK_EQUAL(carol->id(), PlaychainUserId { 2 });
+    BOOST_CHECK_EQUAL(carol->getSerializedPublicKey(), "PLC8BBsSDaofVroXqLSP28fFQubFk4J7HGoqTXigHXSu9VKyx5rv7");
+
+    CompressedPublicKey bob_key;
+    BOOST_REQUIRE(keystore.findPublicKey(PlaychainUserId { 1 }, bob_key));
+    BOOST_CHECK_EQUAL(public_key_to_string(bob_key), "PLC83E5joJjQNJfNfbYYwGhNNY5zkDkkqCNLZVQU47EyJwJwUWzDr");
+
+    //decrypted key signs
+    auto&& bob = keystore.findUser("bob");
+    BOOST_REQUIRE(bob);
+    const std::string digest = "c14a0494ac87dccc09da5c7d25a551eab4e45777cedac2ea1978ff56947ed0d4";
+    BOOST_CHECK(check_signature(convert_signature(bob->signDigest(digest)), convert_digest(digest), bob_key));
+
+    BOOST_CHECK(!keystore.findUser(PlaychainUserId { 3 }));
+    BOOST_CHECK(!keystore.findUser("dave"));
+
+    BOOST_CHECK_THROW(PlaychainKeystore::create(path,
+                                                { { "bob", PlaychainUserId { 1 }, "5HtDVv4JevGEUjtChnYzqvZNepHqMQPanaR45LyspFQmSnyoVDe" },
+                                                  { "bob", PlaychainUserId { 2 }, "5JMhpyYAJLkDFWkFNqSquXPDwzc8tYT94jznQACykP7qJ6WQFZT" } },
+                                                "password"),
+                      std::logic_error);
+
+    std::remove(path.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace playchain_user_tests
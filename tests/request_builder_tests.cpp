@@ -2,6 +2,11 @@
 
 #include <playchain/playchain_user.h>
 #include <playchain/playchain_helper.h>
+#include <playchain/signature_collector.h>
+#include <playchain/tracing.h>
+
+#include <algorithm>
+#include <mutex>
 
 namespace request_builder_tests {
 using namespace tp;
@@ -182,6 +187,51 @@ BOOST_AUTO_TEST_CASE(makeGetAccountIdByNameRequest_check)
     BOOST_REQUIRE_EQUAL(result.str(), utility::remove_formatting(requied));
 }
 
+BOOST_AUTO_TEST_CASE(BlockchainBatchRequest_check)
+{
+    BlockchainBatchRequest batch { 10 };
+
+    BOOST_CHECK(!batch.valid());
+
+    BOOST_CHECK_EQUAL(batch.add(builder().makeGetChainIdRequest()), 10);
+    BOOST_CHECK_EQUAL(batch.add(builder().makeGetAccountIdByNameRequest("alice")), 11);
+
+    BOOST_REQUIRE(batch.valid());
+    BOOST_CHECK_EQUAL(batch.size(), 2u);
+    BOOST_CHECK_EQUAL(batch.next_id(), 12);
+
+    auto requied = R"j(
+                   [
+                       {
+                           "jsonrpc": "2.0",
+                           "id": 10,
+                           "method": "call",
+                           "params": [
+                               "database",
+                               "get_chain_id",
+                               []
+                           ]
+                       },
+                       {
+                           "jsonrpc": "2.0",
+                           "id": 11,
+                           "method": "call",
+                           "params": [
+                               "playchain",
+                               "get_account_id_by_name",
+                               [
+                                   [
+                                       "alice"
+                                   ]
+                               ]
+                           ]
+                       }
+                   ]
+                   )j";
+
+    BOOST_REQUIRE_EQUAL(batch.str(), utility::remove_formatting(requied));
+}
+
 BOOST_AUTO_TEST_CASE(makeGetLastIrreversibleBlockHeaderRequest_check)
 {
     BlockchainRequest result = builder().makeGetLastIrreversibleBlockHeaderRequest();
@@ -670,6 +720,42 @@ BOOST_AUTO_TEST_CASE(makeGameResultPlayingTransaction_check)
     BOOST_CHECK_EQUAL(result.digest(), "a0f7460a9c3386f18be3b1230ee524daa7bd20c4fe5e7c0176452e966f4fdf03");
 }
 
+BOOST_AUTO_TEST_CASE(makeGameResultPlayingTransactions_check)
+{
+    set_chain_info();
+
+    using CR = GameResult::CashResult;
+    std::map<PlaychainTableId, GameResult> results;
+    results[PlaychainTableId { 1 }] = GameResult { { std::make_pair(PlaychainUserId { 168 }, CR { 150000, 20000 }),
+                                                     std::make_pair(PlaychainUserId { 166 }, CR { 0, 0 }),
+                                                     std::make_pair(PlaychainUserId { 167 }, CR { 100000, 0 }) },
+                                                   "$p1:0:455;p2:1*:1000;p3:2*:1000;p4:3*:1000|D0:10|L1B2F3F0F1M2|W2:15;K0|0:455;1:995;2:1005;3:1000" };
+    //bodies of different sizes for lanes of multi-buffer digest
+    for (int table = 2; table <= 40; ++table)
+    {
+        results[PlaychainTableId { table }] = GameResult { { std::make_pair(PlaychainUserId { 168 }, CR { 1000 * table, 10 }),
+                                                             std::make_pair(PlaychainUserId { 167 }, CR { 0, 0 }) },
+                                                           std::string((size_t)table * 7, 'L') };
+    }
+
+    auto transactions = builder().makeVoteForGameResultTransactions(PlaychainUserId { 168 }, PlaychainUserId { 10 }, results);
+    BOOST_REQUIRE_EQUAL(transactions.size(), results.size());
+
+    BOOST_CHECK_EQUAL(transactions[0].digest(), "a0f7460a9c3386f18be3b1230ee524daa7bd20c4fe5e7c0176452e966f4fdf03");
+
+    size_t ci = 0;
+    for (const auto& table_result : results)
+    {
+        BlockchainDigestTransaction single = builder().makeVoteForGameResultTransaction(PlaychainUserId { 168 }, PlaychainUserId { 10 },
+                                                                                        table_result.first, table_result.second);
+        BOOST_CHECK_EQUAL(transactions[ci].str(), single.str());
+        BOOST_CHECK_EQUAL(transactions[ci].digest(), single.digest());
+        ++ci;
+    }
+
+    BOOST_CHECK(builder().makeVoteForGameResultTransactions(PlaychainUserId { 168 }, PlaychainUserId { 10 }, {}).empty());
+}
+
 BOOST_AUTO_TEST_CASE(makeWithdrawPlaychainVestingBalanceTransaction_check)
 {
     set_chain_info();
@@ -910,6 +996,142 @@ BOOST_AUTO_TEST_CASE(makeBroadcastTransaction_check)
     }
 }
 
+BOOST_AUTO_TEST_CASE(signature_collector_check)
+{
+    set_chain_info();
+
+    BlockchainDigestTransaction trx = builder().makeVoteForStartGameTransaction(PlaychainUserId { 168 }, PlaychainUserId { 10 },
+                                                                                PlaychainTableId { 1 },
+                                                                                GameInitialData { { std::make_pair(PlaychainUserId { 168 }, 100000),
+                                                                                                    std::make_pair(PlaychainUserId { 166 }, 50000),
+                                                                                                    std::make_pair(PlaychainUserId { 167 }, 100000) },
+                                                                                                  "Alice-is-diler" });
+
+    BOOST_REQUIRE(trx.valid());
+
+    PlaychainUser alice { "alice", PlaychainUserId { 166 }, "5JTLFAS3YcDyhzm2acyLTsqeA2t2fNrpMPY4dGQCtdf9SUKJZ1U" };
+    PlaychainUser bob { "bob", PlaychainUserId { 167 }, "5KeLCuMiCHt9gqAVKUr1imYVDLanFQbiHg95Gf84zzU8Ek2zjuH" };
+    PlaychainUser carol { "carol", PlaychainUserId { 12 }, "5Kf3Z8fUUdrMVqbozbrUVB6mAb2FFXxmcZ4hL6FJFYheD3hSmHW" };
+
+    size_t completed = 0;
+    BlockchainRequest broadcast;
+    PlaychainSignatureCollector collector(builder(), [&](const BlockchainRequest& request, const std::string& digest, const PlaychainSignatureLatency& latency) {
+        ++completed;
+        broadcast = request;
+        BOOST_CHECK_EQUAL(digest, trx.digest());
+        BOOST_CHECK(latency.first_signature <= latency.complete);
+    });
+
+    using Status = PlaychainSignatureCollector::Status;
+
+    BOOST_CHECK(Status::UNKNOWN == collector.addSignature(trx.digest(), alice.signDigest(trx.digest())));
+
+    BOOST_REQUIRE(collector.expect(trx, { alice.getPublicKey(), bob.getPublicKey() }));
+    BOOST_CHECK(!collector.expect(trx, { alice.getPublicKey() }));
+
+    auto&& alice_signature = alice.signDigest(trx.digest());
+
+    BOOST_CHECK(Status::ACCEPTED == collector.addSignature(trx.digest(), alice_signature));
+    BOOST_CHECK(Status::DUPLICATE == collector.addSignature(trx.digest(), alice_signature));
+    BOOST_CHECK(Status::INVALID == collector.addSignature(trx.digest(), carol.signDigest(trx.digest())));
+    BOOST_CHECK(Status::INVALID == collector.addSignature(trx.digest(), "not a signature"));
+    //empty signature does not match unfilled slot of bob
+    BOOST_CHECK(Status::INVALID == collector.addSignature(trx.digest(), ""));
+    BOOST_CHECK_EQUAL(completed, 0u);
+
+    BOOST_CHECK(Status::COMPLETED == collector.addSignature(trx.digest(), bob.signDigest(trx.digest())));
+    BOOST_REQUIRE_EQUAL(completed, 1u);
+
+    BOOST_CHECK(Status::UNKNOWN == collector.addSignature(trx.digest(), bob.signDigest(trx.digest())));
+
+    {
+        auto&& signatires = get_signatires_from_params_json(broadcast.params());
+
+        BOOST_REQUIRE_EQUAL(signatires.size(), 2u);
+        BOOST_CHECK(check_signature(convert_signature(signatires[0]), convert_digest(trx.digest()), alice.getPublicKey()) || check_signature(convert_signature(signatires[0]), convert_digest(trx.digest()), bob.getPublicKey()));
+        BOOST_CHECK(check_signature(convert_signature(signatires[1]), convert_digest(trx.digest()), alice.getPublicKey()) || check_signature(convert_signature(signatires[1]), convert_digest(trx.digest()), bob.getPublicKey()));
+    }
+
+    BOOST_REQUIRE(collector.expect(trx, { alice.getPublicKey() }));
+    BOOST_CHECK(collector.cancel(trx.digest()));
+    BOOST_CHECK(!collector.cancel(trx.digest()));
+
+    auto&& stats = collector.stats();
+
+    BOOST_CHECK_EQUAL(stats.pending, 0u);
+    BOOST_CHECK_EQUAL(stats.completed, 1u);
+    BOOST_CHECK_EQUAL(stats.accepted_signatures, 2u);
+    BOOST_CHECK_EQUAL(stats.invalid_signatures, 3u);
+    BOOST_CHECK_EQUAL(stats.duplicate_signatures, 1u);
+    BOOST_CHECK(stats.max_latency <= stats.total_latency);
+}
+
+BOOST_AUTO_TEST_CASE(tracing_check)
+{
+    set_chain_info();
+
+    PlaychainUser alice { "alice", PlaychainUserId { 166 }, "5JTLFAS3YcDyhzm2acyLTsqeA2t2fNrpMPY4dGQCtdf9SUKJZ1U" };
+
+    std::mutex lock;
+    std::vector<PlaychainSpan> spans;
+
+    PlaychainTracing::setHandler([&](const PlaychainSpan& span) {
+        std::unique_lock<std::mutex> lck(lock);
+        spans.push_back(span);
+    });
+
+    BOOST_REQUIRE(PlaychainTracing::attached());
+
+    BlockchainDigestTransaction trx = builder().makeVoteForStartGameTransaction(PlaychainUserId { 168 }, PlaychainUserId { 10 },
+                                                                                PlaychainTableId { 1 },
+                                                                                GameInitialData { { std::make_pair(PlaychainUserId { 166 }, 50000) },
+                                                                                                  "Alice-is-diler" });
+    BlockchainRequest broadcast = builder().makeBroadcastTransaction(trx, alice.signDigest(trx.digest()));
+
+    PlaychainResponseParser parser;
+    BOOST_REQUIRE(parser.parseTransactionResponse(R"j({"id": 0, "jsonrpc": "2.0", "result": null})j").valid());
+
+    PlaychainTracing::setHandler(nullptr);
+
+    BOOST_REQUIRE(!PlaychainTracing::attached());
+    BOOST_REQUIRE(builder().makeBroadcastTransaction(trx, alice.signDigest(trx.digest())).valid());
+
+    using Kind = PlaychainSpan::Kind;
+
+    auto find_span = [&spans](const Kind kind) -> PlaychainSpan {
+        auto it = std::find_if(spans.begin(), spans.end(), [kind](const PlaychainSpan& span) {
+            return span.kind == kind;
+        });
+        BOOST_REQUIRE(it != spans.end());
+        return *it;
+    };
+
+    //parent span finishes after its stages
+    BOOST_REQUIRE_EQUAL(spans.size(), 5u);
+
+    auto&& transaction = find_span(Kind::TRANSACTION);
+    BOOST_CHECK_EQUAL(transaction.digest, trx.digest());
+    BOOST_CHECK_EQUAL(transaction.parent_id, 0u);
+
+    auto&& pack = find_span(Kind::TRANSACTION_PACK);
+    BOOST_CHECK_EQUAL(pack.parent_id, transaction.id);
+    BOOST_CHECK_EQUAL(pack.bytes, trx.request().params().size());
+
+    BOOST_CHECK(pack.finish <= transaction.finish);
+
+    //single transaction is digested while it is packed
+    BOOST_CHECK(std::none_of(spans.begin(), spans.end(), [](const PlaychainSpan& span) {
+        return span.kind == Kind::TRANSACTION_HASH;
+    }));
+
+    BOOST_CHECK_EQUAL(find_span(Kind::SIGN).digest, trx.digest());
+    BOOST_CHECK_EQUAL(find_span(Kind::BROADCAST).bytes, broadcast.params().size());
+
+    auto&& parse = find_span(Kind::PARSE);
+    BOOST_CHECK_EQUAL(std::string { parse.name }, "parseTransactionResponse");
+    BOOST_CHECK(!parse.failed);
+}
+
 BOOST_AUTO_TEST_CASE(makeSubscribeChangeTableInfoNotificationRequest_check)
 {
     auto&& result = builder().makeSubscribeChangeTableInfoNotificationRequest(
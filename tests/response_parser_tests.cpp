@@ -1,6 +1,12 @@
 #include "playchain_tests_common.h"
 #include <playchain/playchain_helper.h>
 #include <playchain/playchain_totalpoker_helper.h>
+#include <playchain/metrics.h>
+#include <playchain/diagnostics.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 
 namespace response_parser_tests {
 using namespace tp;
@@ -183,6 +189,565 @@ BOOST_AUTO_TEST_CASE(parseCheckIfTableAllocatedForPendingBuyinResponse_check)
     BOOST_CHECK_EQUAL(tp_table.info, "master");
 }
 
+BOOST_AUTO_TEST_CASE(parseCheckIfTableAllocatedForPendingBuyinResponse_lenient_check)
+{
+    auto response = R"j(
+                    {
+                        "id": 111,
+                        "jsonrpc": "2.0",
+                        "result":
+                        {
+                            "id": "3.4.1",
+                            "metadata": "{\"bb_price\":100000,\"game\":\"TP\"}",
+                            "required_witnesses": 2,
+                            "required_witnesses": 3,
+                            "owner": "1.2.10",
+                            "state": "free",
+                            "server_url": "stage.totalpoker.io:8092"
+                        }
+                    }
+                   )j";
+
+    BOOST_CHECK(!parser.parseCheckIfTableAllocatedForPendingBuyinResponse(response).valid());
+
+    PlaychainSettings settings;
+    settings.lenient_json_decoding = true;
+
+    PlaychainResponseParser lenient_parser { settings };
+
+    auto&& result = lenient_parser.parseCheckIfTableAllocatedForPendingBuyinResponse(response);
+
+    BOOST_REQUIRE(result.valid());
+
+    PlaychainTableInfo table = result;
+
+    BOOST_CHECK_EQUAL((std::string)table.id, (std::string)PlaychainTableId { 1 });
+    BOOST_CHECK_EQUAL(table.required_witnesses, 2);
+    BOOST_CHECK_EQUAL((std::string)table.owner, (std::string)PlaychainUserId { 10 });
+    BOOST_CHECK(table.owner_name.empty());
+    BOOST_CHECK_EQUAL(table.min_accepted_proposal_asset, 0);
+}
+
+BOOST_AUTO_TEST_CASE(parseCheckIfTableAllocatedForPendingBuyinResponse_duplicated_keys_check)
+{
+    auto response = R"j(
+                    {
+                        "id": 111,
+                        "jsonrpc": "2.0",
+                        "result":
+                        {
+                            "id": "3.4.1",
+                            "metadata": "{}",
+                            "required_witnesses": 2,
+                            "required_witnesses": 3,
+                            "min_accepted_proposal_asset": {"amount": 20000, "asset_id": "1.3.0"},
+                            "owner": "1.2.10",
+                            "owner_name": "andrew",
+                            "state": "free",
+                            "server_url": ""
+                        }
+                    }
+                   )j";
+
+    //the first occurrence is decoded by default
+    auto&& result = parser.parseCheckIfTableAllocatedForPendingBuyinResponse(response);
+
+    BOOST_REQUIRE(result.valid());
+    BOOST_CHECK_EQUAL(((const PlaychainTableInfo&)result).required_witnesses, 2);
+
+    PlaychainSettings settings;
+    settings.unique_json_keys = true;
+
+    PlaychainResponseParser unique_parser { settings };
+
+    BOOST_CHECK(!unique_parser.parseCheckIfTableAllocatedForPendingBuyinResponse(response).valid());
+}
+
+BOOST_AUTO_TEST_CASE(streamListTablesResponse_check)
+{
+    auto response = R"j(
+                    {
+                        "id": 12,
+                        "jsonrpc": "2.0",
+                        "result": [
+                            {"id": "3.4.1", "metadata": "{}", "cash": [["1.2.10", {"name": "andrew"}]]},
+                            {"id": "3.4.2", "metadata": "{}", "cash": []},
+                            {"id": "3.4.7", "metadata": "{}", "cash": []}
+                        ],
+                        "trailer": {"result": []}
+                    }
+                   )j";
+
+    std::vector<PlaychainTableId> ids;
+
+    auto&& result = parser.streamListTablesResponse(response, [&ids](PlaychainTableId&& id) { ids.emplace_back(id); });
+
+    BOOST_REQUIRE(result.valid());
+    BOOST_CHECK_EQUAL((size_t)result, 3u);
+    BOOST_REQUIRE_EQUAL(ids.size(), 3u);
+    BOOST_CHECK_EQUAL((std::string)ids[0], (std::string)PlaychainTableId { 1 });
+    BOOST_CHECK_EQUAL((std::string)ids[2], (std::string)PlaychainTableId { 7 });
+
+    auto error_response = R"j({"id": 12, "jsonrpc": "2.0", "error": {"code": 1, "data": {"result": [1]}}})j";
+
+    BOOST_CHECK(!parser.streamListTablesResponse(error_response, [](PlaychainTableId&&) {}).valid());
+    BOOST_CHECK(!parser.parseListTablesResponse(R"j({"id": 12, "result": {}})j").valid());
+    BOOST_CHECK(!parser.parseListTablesResponse(R"j({"id": 12, "result": [{"id": "3.4.1"})j").valid());
+}
+
+BOOST_AUTO_TEST_CASE(parse_response_view_check)
+{
+    std::string response = R"j(
+                    {
+                        "id": 111,
+                        "jsonrpc": "2.0",
+                        "result":
+                        {
+                            "id": "3.4.1",
+                            "metadata": "{\"bb_price\":100000,\"game\":\"TP\"}",
+                            "required_witnesses": 2,
+                            "min_accepted_proposal_asset":
+                            {
+                                "amount": 20000,
+                                "asset_id": "1.3.0"
+                            },
+                            "owner": "1.2.10",
+                            "owner_name": "andrew",
+                            "state": "free",
+                            "server_url": "stage.totalpoker.io:8092"
+                        }
+                    }
+                   )j";
+
+    //not null-terminated part of network buffer
+    std::string buffer = response + "garbage";
+
+    auto&& result = parser.parseCheckIfTableAllocatedForPendingBuyinResponse(BlockchainResponseView { buffer.data(), response.size() });
+
+    BOOST_REQUIRE(result.valid());
+    BOOST_CHECK_EQUAL(((const PlaychainTableInfo&)result).metadata, "{\"bb_price\":100000,\"game\":\"TP\"}");
+
+    //in-situ parsing stops at null character
+    BOOST_CHECK_THROW(BlockchainResponseView::insitu(&buffer[0], response.size()), std::logic_error);
+    BOOST_CHECK(BlockchainResponseView::insitu(response).null_terminated());
+
+    auto&& insitu_result = parser.parseCheckIfTableAllocatedForPendingBuyinResponse(BlockchainResponseView::insitu(response));
+
+    BOOST_REQUIRE(insitu_result.valid());
+
+    PlaychainTableInfo table = insitu_result;
+
+    BOOST_CHECK_EQUAL((std::string)table.id, (std::string)PlaychainTableId { 1 });
+    BOOST_CHECK_EQUAL(table.metadata, "{\"bb_price\":100000,\"game\":\"TP\"}");
+    BOOST_CHECK_EQUAL(table.owner_name, "andrew");
+    BOOST_CHECK_EQUAL(table.server_url, "stage.totalpoker.io:8092");
+
+    std::string list_response = R"j({"id": 12, "result": [{"id": "1.2.10", "name": "andrew"}, {"id": "1.2.11", "name": "böb"}]})j";
+
+    std::vector<BlockchainAccount> accounts;
+    BOOST_REQUIRE(parser.streamGetBlockchainAccountsResponse(BlockchainResponseView::insitu(list_response),
+                                                             [&accounts](BlockchainAccount&& account) { accounts.emplace_back(account); })
+                      .valid());
+    BOOST_REQUIRE_EQUAL(accounts.size(), 2u);
+    BOOST_CHECK_EQUAL(accounts[0].name, "andrew");
+    BOOST_CHECK_EQUAL(accounts[1].name, "böb");
+}
+
+BOOST_AUTO_TEST_CASE(parse_arena_check)
+{
+    std::string accounts_response = R"j({"id": 12, "result": [)j";
+    std::string names_response = R"j({"id": 13, "result": [)j";
+    for (int ci = 1; ci <= 200; ++ci)
+    {
+        if (ci > 1)
+        {
+            accounts_response += ",";
+            names_response += ",";
+        }
+        std::string id = "1.2." + std::to_string(ci);
+        std::string name = "account-with-long-enough-name-" + std::to_string(ci);
+        accounts_response += R"j({"id": ")j" + id + R"j(", "name": ")j" + name + R"j("})j";
+        names_response += R"j([")j" + name + R"j(", ")j" + id + R"j("])j";
+    }
+    accounts_response += "]}";
+    names_response += "]}";
+
+    auto arena = std::make_shared<PlaychainParseArena>(1024);
+
+    PlaychainResponseParser arena_parser;
+    arena_parser.setParseArena(arena);
+
+    //warm up: arena grows buffers here
+    BOOST_REQUIRE(arena_parser.parseGetBlockchainAccountsResponse(accounts_response).valid());
+    BOOST_REQUIRE(arena_parser.parseGetAccountIdByNameResponse(names_response).valid());
+
+    auto&& warmed_up = arena->stats();
+
+    BOOST_CHECK_GT(warmed_up.high_water_mark, 0u);
+    BOOST_CHECK_GT(warmed_up.overflows, 0u);
+
+    for (int ci = 0; ci < 10; ++ci)
+    {
+        auto&& accounts = arena_parser.parseGetBlockchainAccountsResponse(accounts_response);
+
+        BOOST_REQUIRE(accounts.valid());
+        BOOST_REQUIRE_EQUAL(((const std::vector<BlockchainAccount>&)accounts).size(), 200u);
+
+        auto&& names = arena_parser.parseGetAccountIdByNameResponse(names_response);
+
+        BOOST_REQUIRE(names.valid());
+        BOOST_REQUIRE_EQUAL(((const std::map<std::string, PlaychainUserId>&)names).size(), 200u);
+    }
+
+    auto&& stats = arena->stats();
+
+    BOOST_CHECK_EQUAL(stats.parses, warmed_up.parses + 20);
+    BOOST_CHECK_EQUAL(stats.overflows, warmed_up.overflows);
+    BOOST_CHECK_EQUAL(stats.capacity, warmed_up.capacity);
+    BOOST_CHECK_EQUAL(stats.fallbacks, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_check)
+{
+    auto response = R"j({"id": 13, "result": [["alice", "1.2.12"], ["bob", "1.2.13"]]})j";
+    auto invalid_response = R"j({"id": 13, "result": [["alice", "1.2.12"], ["bob"]]})j";
+
+    PlaychainMetrics::setLatencySampling(1);
+    PlaychainMetrics::reset();
+
+    for (int ci = 0; ci < 3; ++ci)
+    {
+        BOOST_REQUIRE(parser.parseGetAccountIdByNameResponse(response).valid());
+    }
+    BOOST_REQUIRE(!parser.parseGetAccountIdByNameResponse(invalid_response).valid());
+    BOOST_REQUIRE(!parser.parseGetBlockchainAccountsResponse(R"j({"id": 1, "result": [{"id": "1.2.1", "name": 12}]})j").valid());
+
+    auto&& metrics = PlaychainMetrics::snapshot();
+
+    PlaychainMetrics::setLatencySampling(PlaychainMetrics::DEFAULT_LATENCY_SAMPLING);
+
+    if (!PlaychainMetrics::enabled())
+    {
+        BOOST_CHECK(metrics.empty());
+        return;
+    }
+
+    auto it = std::find_if(metrics.begin(), metrics.end(), [](const PlaychainMethodMetrics& item) {
+        return item.method == "parseGetAccountIdByNameResponse";
+    });
+    BOOST_REQUIRE(it != metrics.end());
+
+    //overloads calling each other are counted once
+    BOOST_CHECK_EQUAL(it->category, "parser");
+    BOOST_CHECK_EQUAL(it->calls, 4u);
+    BOOST_CHECK_EQUAL(it->failures, 1u);
+    BOOST_CHECK_EQUAL(it->bytes, 3 * std::strlen(response) + std::strlen(invalid_response));
+    BOOST_CHECK_EQUAL(it->latency_samples, 4u);
+    BOOST_CHECK_EQUAL(std::accumulate(it->latency_histogram.begin(), it->latency_histogram.end(), uint64_t { 0 }), 4u);
+
+    //wrapper of stream method is counted as one failed call
+    auto accounts = std::find_if(metrics.begin(), metrics.end(), [](const PlaychainMethodMetrics& item) {
+        return item.method == "parseGetBlockchainAccountsResponse";
+    });
+    BOOST_REQUIRE(accounts != metrics.end());
+    BOOST_CHECK_EQUAL(accounts->calls, 1u);
+    BOOST_CHECK_EQUAL(accounts->failures, 1u);
+    BOOST_CHECK(std::none_of(metrics.begin(), metrics.end(), [](const PlaychainMethodMetrics& item) {
+        return item.method == "streamGetBlockchainAccountsResponse";
+    }));
+
+    auto&& text = PlaychainMetrics::toPrometheus(metrics);
+
+    BOOST_CHECK(text.find("playchain_calls_total{category=\"parser\",method=\"parseGetAccountIdByNameResponse\"} 4\n") != std::string::npos);
+    BOOST_CHECK(text.find("playchain_latency_seconds_count{category=\"parser\",method=\"parseGetAccountIdByNameResponse\"} 4\n") != std::string::npos);
+
+    PlaychainMetrics::reset();
+
+    BOOST_CHECK(PlaychainMetrics::snapshot().empty());
+}
+
+BOOST_AUTO_TEST_CASE(diagnostics_check)
+{
+    auto invalid_name_response = R"j({"id": 1, "result": [{"id": "1.2.1", "name": "alice"}, {"id": "1.2.2", "name": 12}]})j";
+    auto absent_name_response = R"j({"id": 1, "result": [{"id": "1.2.1"}]})j";
+    auto invalid_response = R"j({"id": 13, "result": [["alice", "1.2.12"], ["bob"]]})j";
+
+    PlaychainDiagnostics::drain();
+
+    auto errors = PlaychainDiagnostics::errors();
+
+    BOOST_REQUIRE(!parser.parseGetBlockchainAccountsResponse(invalid_name_response).valid());
+    BOOST_REQUIRE(!parser.parseGetBlockchainAccountsResponse(absent_name_response).valid());
+    BOOST_REQUIRE(!parser.parseGetAccountIdByNameResponse(invalid_response).valid());
+
+    BOOST_CHECK_EQUAL(PlaychainDiagnostics::errors(), errors + 3);
+
+    auto&& records = PlaychainDiagnostics::drain();
+
+    BOOST_REQUIRE_EQUAL(records.size(), 3u);
+
+    BOOST_CHECK_EQUAL(records[0].method, "parseGetBlockchainAccountsResponse");
+    BOOST_CHECK_EQUAL(records[0].json_path, "result[1].name");
+    BOOST_CHECK(records[0].error.find("IsString()") != std::string::npos);
+    BOOST_CHECK_EQUAL(records[0].skipped, 0u);
+    BOOST_CHECK(records[0].time <= std::chrono::system_clock::now());
+
+    BOOST_CHECK_EQUAL(records[1].json_path, "result[0].name");
+
+    BOOST_CHECK_EQUAL(records[2].method, "parseGetAccountIdByNameResponse");
+    BOOST_CHECK(records[2].json_path.empty());
+    BOOST_CHECK(!records[2].error.empty());
+
+    BOOST_CHECK(PlaychainDiagnostics::drain().empty());
+
+    //every 2nd error
+    PlaychainDiagnostics::setSampling(2);
+
+    for (int ci = 0; ci < 4; ++ci)
+    {
+        BOOST_REQUIRE(!parser.parseGetAccountIdByNameResponse(invalid_response).valid());
+    }
+
+    PlaychainDiagnostics::setSampling(1);
+
+    records = PlaychainDiagnostics::drain();
+
+    BOOST_REQUIRE_EQUAL(records.size(), 2u);
+    BOOST_CHECK_EQUAL(records[1].skipped, 1u);
+
+    //full ring skips new records until it is drained
+    for (size_t ci = 0; ci < PlaychainDiagnostics::RING_CAPACITY + 2; ++ci)
+    {
+        BOOST_REQUIRE(!parser.parseGetAccountIdByNameResponse(invalid_response).valid());
+    }
+    BOOST_REQUIRE(!parser.parseGetBlockchainAccountsResponse(invalid_name_response).valid());
+
+    BOOST_CHECK_EQUAL(PlaychainDiagnostics::drain().size(), PlaychainDiagnostics::RING_CAPACITY);
+
+    BOOST_REQUIRE(!parser.parseGetBlockchainAccountsResponse(invalid_name_response).valid());
+
+    records = PlaychainDiagnostics::drain();
+
+    BOOST_REQUIRE_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(records[0].skipped, 3u);
+    BOOST_CHECK_EQUAL(records[0].json_path, "result[1].name");
+}
+
+BOOST_AUTO_TEST_CASE(parseGetTablesInfoResponse_into_existing_check)
+{
+    auto make_response = [](const std::string& cash) {
+        return R"j({"id": 1, "result": [{
+                    "id": "3.4.1",
+                    "metadata": "{\"game\":\"TP\"}",
+                    "required_witnesses": 0,
+                    "owner": "1.2.10",
+                    "owner_name": "andrew",
+                    "state": "playing",
+                    "server_url": "stage.totalpoker.io:8092",
+                    "min_accepted_proposal_asset": {"amount": 20000, "asset_id": "1.3.0"},
+                    "pending_proposals": [],
+                    "cash": [)j"
+            + cash + R"j(],
+                    "playing_cash": [],
+                    "missed_voters": []}]})j";
+    };
+
+    std::vector<PlaychainTableInfoExt> tables;
+
+    BOOST_REQUIRE(parser.parseGetTablesInfoResponse(make_response(R"j(["1.2.11", {"name": "alice", "amount": {"amount": 100, "asset_id": "1.3.0"}}],
+                                                                      ["1.2.12", {"name": "bob", "amount": {"amount": 200, "asset_id": "1.3.0"}}])j"),
+                                                    tables));
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_REQUIRE_EQUAL(tables[0].cash.size(), 2u);
+
+    const CashInfo* bob_node = &tables[0].cash.at(PlaychainUserId { 12 });
+
+    BOOST_REQUIRE(parser.parseGetTablesInfoResponse(make_response(R"j(["1.2.12", {"name": "bob", "amount": {"amount": 300, "asset_id": "1.3.0"}}],
+                                                                      ["1.2.13", {"name": "carol", "amount": {"amount": 400, "asset_id": "1.3.0"}}])j"),
+                                                    tables));
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_REQUIRE_EQUAL(tables[0].cash.size(), 2u);
+    BOOST_CHECK(!tables[0].cash.count(PlaychainUserId { 11 }));
+    BOOST_CHECK_EQUAL(&tables[0].cash.at(PlaychainUserId { 12 }), bob_node);
+    BOOST_CHECK_EQUAL(tables[0].cash.at(PlaychainUserId { 12 }).amount, 300u);
+    BOOST_CHECK_EQUAL(tables[0].cash.at(PlaychainUserId { 13 }).name, "carol");
+
+    BOOST_REQUIRE(parser.parseGetTablesInfoResponse(R"j({"id": 1, "result": []})j", tables));
+    BOOST_CHECK(tables.empty());
+
+    std::map<std::string, PlaychainUserId> accounts { { "zed", PlaychainUserId { 1 } } };
+
+    BOOST_REQUIRE(parser.parseGetAccountIdByNameResponse(R"j({"id": 1, "result": [["andrew", "1.2.168"], ["alice", "1.2.169"]]})j", accounts));
+    BOOST_CHECK_EQUAL(accounts.size(), 2u);
+    BOOST_CHECK(!accounts.count("zed"));
+    BOOST_CHECK_EQUAL((std::string)accounts["alice"], (std::string)PlaychainUserId { 169 });
+}
+
+BOOST_AUTO_TEST_CASE(parseGetTablesInfoResponse_projection_check)
+{
+    auto table = R"j({
+                    "id": "3.4.1",
+                    "metadata": "{\"game\":\"TP\"}",
+                    "required_witnesses": 0,
+                    "owner": "1.2.10",
+                    "owner_name": "andrew",
+                    "state": "playing",
+                    "server_url": "stage.totalpoker.io:8092",
+                    "min_accepted_proposal_asset": {"amount": 20000, "asset_id": "1.3.0"},
+                    "pending_proposals": [],
+                    "cash": [["1.2.11", {"name": "alice", "amount": {"amount": 100, "asset_id": "1.3.0"}}]],
+                    "playing_cash": [],
+                    "missed_voters": [],
+                    "unknown": {"nested": [1, [2, {"x": 3}]]}})j";
+
+    const PlaychainTableFieldsMask fields = PlaychainTableFields::ID | PlaychainTableFields::STATE;
+
+    std::vector<PlaychainTableInfoExt> tables;
+
+    BOOST_REQUIRE(parser.parseGetTablesInfoResponse(std::string { R"j({"id": 1, "result": [)j" } + table + "]}", tables, fields));
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_CHECK_EQUAL((std::string)tables[0].id, (std::string)PlaychainTableId { 1 });
+    BOOST_CHECK_EQUAL((int)tables[0].state, (int)PlaychainTableInfo::State::GAME);
+    BOOST_CHECK(!tables[0].owner.valid());
+    BOOST_CHECK(tables[0].metadata.empty());
+    BOOST_CHECK(tables[0].cash.empty());
+
+    //not requested fields are not required
+    BOOST_REQUIRE(parser.parseGetTablesInfoResponse(R"j({"id": 1, "result": [{"state": "free", "id": "3.4.2"}]})j", tables, fields));
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_CHECK_EQUAL((std::string)tables[0].id, (std::string)PlaychainTableId { 2 });
+    BOOST_CHECK(!parser.parseGetTablesInfoResponse(R"j({"id": 1, "result": [{"state": "free", "id": "3.4.2"}]})j", tables));
+
+    auto notification = std::string { R"j({"method": "notice", "params": [10, [[)j" } + table + "]]]}";
+
+    BOOST_REQUIRE(parser.parseChangeTableInfoNotification(notification, 10, tables, PlaychainTableFields::CASH | PlaychainTableFields::ID));
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_CHECK_EQUAL(tables[0].cash.at(PlaychainUserId { 11 }).amount, 100u);
+    BOOST_CHECK((int)tables[0].state == (int)PlaychainTableInfo::State::NOP);
+    BOOST_CHECK(!parser.parseChangeTableInfoNotification(notification, 11, tables, fields));
+    //notice of other subscription does not touch result
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_CHECK_EQUAL(tables[0].cash.at(PlaychainUserId { 11 }).amount, 100u);
+    BOOST_CHECK(!parser.parseChangeTableInfoNotification(std::string { R"j({"method": "notice", "params": [10, [[)j" } + table + "]], 1]}", 10, tables, PlaychainTableFields::CASH | PlaychainTableFields::ID));
+    BOOST_CHECK(!parser.parseChangeTableInfoNotification(std::string { R"j({"method": "notice", "params": [10, [[)j" } + table + "], []]]}", 10, tables, PlaychainTableFields::CASH | PlaychainTableFields::ID));
+
+    size_t streamed = 0;
+    BOOST_REQUIRE(parser.streamGetTablesInfoResponse(std::string { R"j({"id": 1, "result": [)j" } + table + "," + table + "]}",
+                                                     [&](PlaychainTableInfoExt&& info) {
+                                                         BOOST_CHECK(info.owner_name.empty());
+                                                         BOOST_CHECK_EQUAL(info.server_url, "stage.totalpoker.io:8092");
+                                                         ++streamed;
+                                                     },
+                                                     PlaychainTableFields::ID | PlaychainTableFields::SERVER_URL)
+                      .valid());
+    BOOST_CHECK_EQUAL(streamed, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(parse_views_check)
+{
+    auto tables_response = R"j({"id": 1, "result": [{
+                    "id": "3.4.1",
+                    "metadata": "{\"game\":\"TP\"}",
+                    "required_witnesses": 2,
+                    "owner": "1.2.10",
+                    "owner_name": "andrew",
+                    "state": "free",
+                    "server_url": "stage.totalpoker.io:8092",
+                    "min_accepted_proposal_asset": {"amount": 20000, "asset_id": "1.3.0"},
+                    "pending_proposals": [],
+                    "cash": [["1.2.11", {"name": "alice", "amount": {"amount": 100, "asset_id": "1.3.0"}}]],
+                    "playing_cash": [],
+                    "missed_voters": [["1.2.12", "bob"]]}, {
+                    "id": "3.4.2",
+                    "metadata": "{}",
+                    "required_witnesses": 0,
+                    "owner": "1.2.11",
+                    "owner_name": "alice",
+                    "state": "playing",
+                    "server_url": "",
+                    "min_accepted_proposal_asset": {"amount": 0, "asset_id": "1.3.0"},
+                    "pending_proposals": [],
+                    "cash": [],
+                    "playing_cash": [],
+                    "missed_voters": []}]})j";
+
+    PlaychainTablesView tables;
+    {
+        auto&& result = parser.parseGetTablesInfoView(std::string { tables_response });
+        BOOST_REQUIRE(result.valid());
+        tables = result;
+    }
+
+    BOOST_REQUIRE_EQUAL(tables.size(), 2u);
+    BOOST_CHECK_EQUAL((std::string)tables[0].id(), (std::string)PlaychainTableId { 1 });
+    BOOST_CHECK_EQUAL((int)tables[0].state(), (int)PlaychainTableInfo::State::NO_GAME);
+    BOOST_CHECK_EQUAL(tables[0].required_witnesses(), 2);
+    BOOST_CHECK_EQUAL(tables[0].min_accepted_proposal_asset(), 20000u);
+    BOOST_CHECK_EQUAL(tables[0].cash().at(PlaychainUserId { 11 }).name, "alice");
+    BOOST_CHECK_EQUAL(tables[0].missed_voters().at(PlaychainUserId { 12 }), "bob");
+    BOOST_CHECK_EQUAL((int)tables[1].state(), (int)PlaychainTableInfo::State::GAME);
+    BOOST_CHECK_EQUAL(tables[1].owner_name(), "alice");
+
+    size_t valid = 0;
+    for (const auto& table : tables)
+    {
+        PlaychainTableInfoExt info = table.infoExt();
+        BOOST_CHECK_EQUAL((std::string)info.id, (std::string)table.id());
+        BOOST_CHECK_EQUAL(info.cash.size(), table.cash().size());
+        valid += table.valid() ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(valid, 2u);
+
+    BOOST_CHECK(!parser.parseGetTablesInfoView(R"j({"id": 1, "error": {"code": 1}})j").valid());
+    BOOST_CHECK(!parser.parseGetTablesInfoView(R"j({"id": 1, "result": [{"id": "3.4.1"}]})j").valid());
+
+    //mistyped fields are rejected by parse, content is checked by accessors
+    std::string malformed_tables = tables_response;
+    malformed_tables.replace(malformed_tables.find("\"required_witnesses\": 2"), std::strlen("\"required_witnesses\": 2"), "\"required_witnesses\": \"2\"");
+    BOOST_CHECK(!parser.parseGetTablesInfoView(malformed_tables).valid());
+    malformed_tables = tables_response;
+    malformed_tables.replace(malformed_tables.find("[[\"1.2.12\", \"bob\"]]"), std::strlen("[[\"1.2.12\", \"bob\"]]"), "[[\"bob\", \"1.2.12\"]]");
+    {
+        auto&& result = parser.parseGetTablesInfoView(malformed_tables);
+        BOOST_REQUIRE(result.valid());
+        const PlaychainTablesView& view = result;
+        BOOST_CHECK_EQUAL(view[0].owner_name(), "andrew");
+        BOOST_CHECK_THROW(view[0].missed_voters(), std::logic_error);
+    }
+
+    //in-situ response is parsed in place
+    std::string insitu_tables = tables_response;
+    {
+        auto&& result = parser.parseGetTablesInfoView(BlockchainResponseView::insitu(insitu_tables));
+        BOOST_REQUIRE(result.valid());
+        const PlaychainTablesView& view = result;
+        BOOST_REQUIRE_EQUAL(view.size(), 2u);
+        BOOST_CHECK_EQUAL(view[1].owner_name(), "alice");
+        BOOST_CHECK_EQUAL(view[0].cash().at(PlaychainUserId { 11 }).amount, 100u);
+    }
+
+    auto rooms_response = R"j({"id": 1, "result": [{
+                    "id": "3.2.1",
+                    "owner": "1.2.10",
+                    "metadata": "{}",
+                    "server_url": "stage.totalpoker.io:8092",
+                    "protocol_version": {"metadata": "", "base": {"v_num": 16842752}},
+                    "rating": 5}]})j";
+
+    auto&& rooms = parser.parseListRoomsView(rooms_response);
+    BOOST_REQUIRE(rooms.valid());
+
+    const PlaychainRoomsView& rooms_view = rooms;
+    BOOST_REQUIRE_EQUAL(rooms_view.size(), 1u);
+    BOOST_CHECK_EQUAL(rooms_view[0].rating(), 5);
+    BOOST_CHECK(rooms_view[0].owner_name().empty());
+    BOOST_CHECK(rooms_view[0].protocol_version() == rooms_view[0].info().protocol_version);
+
+    std::string malformed_rooms = rooms_response;
+    malformed_rooms.replace(malformed_rooms.find("\"rating\": 5"), std::strlen("\"rating\": 5"), "\"rating\": \"5\"");
+    BOOST_CHECK(!parser.parseListRoomsView(malformed_rooms).valid());
+}
+
 BOOST_AUTO_TEST_CASE(parseGetAccountIdByNameResponse_check)
 {
     auto response = R"j(
@@ -918,6 +1483,127 @@ BOOST_AUTO_TEST_CASE(parseChangeTableInfoNotification_check)
     BOOST_CHECK_EQUAL((int)tables[1].state, (int)PlaychainTableInfo::State::NO_GAME);
 }
 
+BOOST_AUTO_TEST_CASE(message_router_check)
+{
+    auto tables_response = R"j({"id": 7, "jsonrpc": "2.0", "result": [
+                              {"id": "3.4.1", "metadata": "", "required_witnesses": 0, "state": "free",
+                               "owner": "1.2.10", "owner_name": "andrew", "server_url": "",
+                               "min_accepted_proposal_asset": {"amount": 10000, "asset_id": "1.3.0"},
+                               "pending_proposals": [], "cash": [], "playing_cash": [], "missed_voters": []}]})j";
+    auto notice = R"j({"method": "notice", "params": [10, [[
+                     {"id": "3.4.2", "metadata": "", "required_witnesses": 0, "state": "free",
+                      "owner": "1.2.11", "owner_name": "andrew", "server_url": "",
+                      "min_accepted_proposal_asset": {"amount": 20000, "asset_id": "1.3.0"},
+                      "pending_proposals": [], "cash": [], "playing_cash": [], "missed_voters": []}]]]})j";
+    auto transaction_response = R"j({"id": 8, "jsonrpc": "2.0", "result": null})j";
+    auto error_response = R"j({"id": 9, "jsonrpc": "2.0", "error": {"code": 1, "message": "failed"}})j";
+
+    PlaychainMessageRouter router;
+
+    std::vector<PlaychainTableInfoExt> tables;
+    std::vector<PlaychainTableInfoExt> notified;
+    size_t transactions = 0;
+    size_t errors = 0;
+    size_t unhandled = 0;
+
+    router.expectResponse(7, [&](const PlaychainParsedMessage& message) {
+        BOOST_CHECK(message.kind() == PlaychainParsedMessage::Kind::RESPONSE);
+        BOOST_CHECK(parser.parseGetTablesInfoResponse(message, tables));
+        //message of other kind is not decoded
+        BOOST_CHECK(!parser.parseChangeTableInfoNotification(message, notified));
+    });
+    router.expectResponse(8, [&](const PlaychainParsedMessage& message) {
+        auto&& result = parser.parseTransactionResponse(message);
+        BOOST_CHECK(result.valid());
+        ++transactions;
+    });
+    router.expectResponse(9, [&](const PlaychainParsedMessage& message) {
+        BOOST_CHECK(message.error());
+        BOOST_CHECK(!parser.parseTransactionResponse(message).valid());
+        ++errors;
+    });
+    router.subscribe(10, [&](const PlaychainParsedMessage& message) {
+        BOOST_CHECK(message.kind() == PlaychainParsedMessage::Kind::NOTICE);
+        BOOST_CHECK(parser.parseChangeTableInfoNotification(message, notified));
+    });
+    router.setDefaultHandler([&](const PlaychainParsedMessage&) { ++unhandled; });
+
+    BOOST_CHECK_EQUAL(router.pendingResponses(), 3u);
+
+    BOOST_CHECK(router.route(tables_response));
+    BOOST_CHECK(router.route(notice));
+    BOOST_CHECK(router.route(notice));
+    BOOST_CHECK(router.route(transaction_response));
+    BOOST_CHECK(router.route(error_response));
+
+    BOOST_REQUIRE_EQUAL(tables.size(), 1u);
+    BOOST_CHECK_EQUAL((std::string)tables[0].id, (std::string)PlaychainTableId { 1 });
+    BOOST_REQUIRE_EQUAL(notified.size(), 1u);
+    BOOST_CHECK_EQUAL((std::string)notified[0].id, (std::string)PlaychainTableId { 2 });
+    BOOST_CHECK_EQUAL(transactions, 1u);
+    BOOST_CHECK_EQUAL(errors, 1u);
+
+    //response handlers are one-shot
+    BOOST_CHECK_EQUAL(router.pendingResponses(), 0u);
+    BOOST_CHECK(!router.route(transaction_response));
+    BOOST_CHECK_EQUAL(transactions, 1u);
+
+    router.unsubscribe(10);
+    BOOST_CHECK(!router.route(notice));
+    BOOST_CHECK(!router.route("{\"id\": "));
+    BOOST_CHECK(!router.route(R"j({"jsonrpc": "2.0"})j"));
+    BOOST_CHECK_EQUAL(unhandled, 4u);
+}
+
+BOOST_AUTO_TEST_CASE(message_router_batch_check)
+{
+    //elements of batch response may come in any order
+    auto response = R"j([
+                       {"id": 12, "jsonrpc": "2.0", "result": null},
+                       {"id": 11, "jsonrpc": "2.0", "result": [["alice", "1.2.10"], ["bob", "1.2.11"]]},
+                       {"id": 10, "jsonrpc": "2.0", "result": [{"id": "3.4.1"}, {"id": "3.4.2"}]}
+                   ])j";
+
+    PlaychainMessageRouter router;
+
+    std::vector<PlaychainTableId> tables;
+    std::map<std::string, PlaychainUserId> accounts;
+    size_t transactions = 0;
+    std::vector<int64_t> order;
+
+    router.expectResponse(10, [&](const PlaychainParsedMessage& message) {
+        BOOST_CHECK(parser.parseListTablesResponse(message, tables));
+        order.push_back(message.id());
+    });
+    router.expectResponse(11, [&](const PlaychainParsedMessage& message) {
+        BOOST_CHECK(parser.parseGetAccountIdByNameResponse(message, accounts));
+        order.push_back(message.id());
+    });
+    router.expectResponse(12, [&](const PlaychainParsedMessage& message) {
+        BOOST_CHECK(parser.parseTransactionResponse(message).valid());
+        ++transactions;
+        order.push_back(message.id());
+    });
+
+    BOOST_CHECK(router.route(response));
+    BOOST_CHECK_EQUAL(router.pendingResponses(), 0u);
+
+    BOOST_REQUIRE_EQUAL(tables.size(), 2u);
+    BOOST_CHECK_EQUAL((std::string)tables[1], (std::string)PlaychainTableId { 2 });
+    BOOST_REQUIRE_EQUAL(accounts.size(), 2u);
+    BOOST_CHECK_EQUAL((std::string)accounts["bob"], (std::string)PlaychainUserId { 11 });
+    BOOST_CHECK_EQUAL(transactions, 1u);
+    BOOST_REQUIRE_EQUAL(order.size(), 3u);
+    BOOST_CHECK_EQUAL(order[0], 12);
+    BOOST_CHECK_EQUAL(order[2], 10);
+
+    //not expected elements are reported but others are still routed
+    router.expectResponse(10, [&](const PlaychainParsedMessage&) { order.push_back(10); });
+    BOOST_CHECK(!router.route(R"j([{"id": 9, "result": null}, {"id": 10, "result": null}])j"));
+    BOOST_CHECK_EQUAL(order.size(), 4u);
+    BOOST_CHECK(!router.route("[]"));
+}
+
 BOOST_AUTO_TEST_CASE(parsePlaychainSettingFromProperties_check)
 {
     auto blockchain_response = R"j(
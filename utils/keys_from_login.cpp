@@ -1,10 +1,17 @@
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <thread>
+#include <vector>
 #include <termios.h>
 
 #include <playchain/playchain_helper.h>
+#include <playchain/public_key_cache.h>
 
 namespace {
 namespace bpo = boost::program_options;
@@ -21,13 +28,15 @@ void set_program_options(bpo::options_description& cli)
             ("print-public",  bpo::value<bool>()->default_value(true), "Print compressed and formatted public key")
             ("print-public-raw",  bpo::value<bool>()->default_value(false), "Print compressed raw public key")
             ("print-private",  bpo::value<bool>()->default_value(false), "Print private key")
-            ("print-address",  bpo::value<bool>()->default_value(false), "Print address from public key");
+            ("print-address",  bpo::value<bool>()->default_value(false), "Print address from public key")
+            ("batch,b", bpo::value<std::string>(), "File of 'name,secret' lines ('-' for stdin), prints 'name,wif,public,address' lines")
+            ("threads,j", bpo::value<size_t>()->default_value(0), "Threads of batch derivation (0 for all cores)");
     // clang-format on
 }
 
 bool check_mandatory_options(std::ostream& stream, const bpo::variables_map& options)
 {
-    if (!options.count("name") && !options.count("public"))
+    if (!options.count("name") && !options.count("public") && !options.count("batch"))
     {
         stream << "Account name is requied"
                << "\n";
@@ -84,6 +93,118 @@ std::string get_secret(const std::string& prompt, bool show_asterisk)
     std::cerr << std::endl;
     return ret;
 }
+
+struct batch_record
+{
+    std::string name;
+    std::string secret;
+};
+
+//records of one thread per pass, secp256k1 context is created once for them
+const size_t batch_chunk_size = 1024;
+
+bool read_batch_record(std::istream& input, size_t& line_number, batch_record& record)
+{
+    std::string line;
+    while (std::getline(input, line))
+    {
+        ++line_number;
+
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+
+        //account names have no commas, secret is the rest of line
+        auto pos = line.find(',');
+        if (pos == std::string::npos || pos == 0 || pos + 1 == line.size())
+            throw std::runtime_error("Invalid record at line " + std::to_string(line_number) + ", expected 'name,secret'");
+
+        record.name = line.substr(0, pos);
+        record.secret = line.substr(pos + 1);
+        return true;
+    }
+    return false;
+}
+
+void derive_batch_chunk(const batch_record* records, const size_t count, std::string& output)
+{
+    std::vector<tp::PrivateKey> priv_keys;
+    priv_keys.reserve(count);
+    for (size_t ci = 0; ci < count; ++ci)
+        priv_keys.push_back(tp::priv_key_from_brain_key(records[ci].name + "active" + records[ci].secret));
+
+    auto&& pub_keys = tp::public_keys_from_keys(priv_keys);
+
+    output.clear();
+    for (size_t ci = 0; ci < count; ++ci)
+    {
+        output += records[ci].name;
+        output += ',';
+        output += tp::priv_key_to_wif(priv_keys[ci]);
+        output += ',';
+        output += tp::public_key_to_string(pub_keys[ci], true);
+        output += ',';
+        output += tp::address_from_public_key(pub_keys[ci], true);
+        output += '\n';
+    }
+}
+
+size_t derive_batch(std::istream& input, std::ostream& output, size_t threads)
+{
+    if (!threads)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    //every key is converted once, cache would only add locks
+    tp::PlaychainPublicKeyCache::instance().setCapacity(0);
+
+    std::vector<batch_record> records(threads * batch_chunk_size);
+    std::vector<std::string> outputs(threads);
+    std::vector<std::exception_ptr> errors(threads);
+
+    size_t line_number = 0;
+    size_t derived = 0;
+    while (true)
+    {
+        size_t count = 0;
+        while (count < records.size() && read_batch_record(input, line_number, records[count]))
+            ++count;
+        if (!count)
+            break;
+
+        std::vector<std::thread> workers;
+        for (size_t ci = 0; ci * batch_chunk_size < count; ++ci)
+        {
+            const size_t from = ci * batch_chunk_size;
+            const size_t size = std::min(batch_chunk_size, count - from);
+            workers.emplace_back([&, ci, from, size]() {
+                try
+                {
+                    derive_batch_chunk(records.data() + from, size, outputs[ci]);
+                }
+                catch (...)
+                {
+                    errors[ci] = std::current_exception();
+                }
+            });
+        }
+        for (size_t ci = 0; ci < workers.size(); ++ci)
+        {
+            workers[ci].join();
+        }
+        for (size_t ci = 0; ci < workers.size(); ++ci)
+        {
+            if (errors[ci])
+                std::rethrow_exception(errors[ci]);
+            output << outputs[ci];
+        }
+
+        derived += count;
+    }
+    output << std::flush;
+
+    return derived;
+}
 } // namespace
 
 int main(int argc, char* argv[])
@@ -113,6 +234,29 @@ int main(int argc, char* argv[])
 
     try
     {
+        if (options.count("batch"))
+        {
+            const std::string& path = options["batch"].as<std::string>();
+
+            std::ifstream file;
+            if (path != "-")
+            {
+                file.open(path);
+                if (!file)
+                    throw std::runtime_error("Unable to open " + path);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+
+            size_t derived = derive_batch(path != "-" ? file : std::cin, std::cout, options["threads"].as<size_t>());
+
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cerr << "Derived " << derived << " keys in " << std::fixed << std::setprecision(2) << seconds << " s ("
+                      << std::setprecision(0) << (seconds > 0 ? derived / seconds : 0.) << " keys/sec)" << std::endl;
+
+            return 0;
+        }
+
         std::string name;
         tp::CompressedPublicKey pub_key;
 
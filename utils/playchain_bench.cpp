@@ -0,0 +1,706 @@
+#include <boost/program_options.hpp>
+
+#include <openssl/bn.h>
+#include <openssl/sha.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <playchain/response_parser.h>
+#include <playchain/playchain_helper.h>
+#include <playchain/public_key_cache.h>
+
+#include "../src/json_backend.h"
+#include "../src/number_codec.h"
+#include "../src/convert_helper.h"
+#include "../src/hex_codec.h"
+#include "../src/base58.h"
+#include "../src/sha256.h"
+#include "../src/sha256_kernels.h"
+
+namespace {
+namespace bpo = boost::program_options;
+
+using namespace tp;
+
+void set_program_options(bpo::options_description& cli)
+{
+    // clang-format off
+    cli.add_options()
+            ("help,h", "Print this help message and exit.")
+            ("filter,f", bpo::value<std::string>()->default_value(""), "Run benchmarks which names contain this string")
+            ("tables,t", bpo::value<size_t>()->default_value(1000), "Tables in generated responses")
+            ("cash,c", bpo::value<size_t>()->default_value(6), "Cash records per table")
+            ("min-time,m", bpo::value<double>()->default_value(0.5), "Min run time of benchmark (seconds)");
+    // clang-format on
+}
+
+struct bench_options
+{
+    size_t tables = 0;
+    size_t cash = 0;
+};
+
+struct bench_case
+{
+    std::string name;
+    //bytes processed by run
+    size_t bytes;
+    //returns number of processed items to prevent optimizing out
+    std::function<size_t()> run;
+};
+
+std::string make_table(const size_t table, const size_t cash)
+{
+    std::stringstream ss;
+
+    ss << R"j({"id": "3.4.)j" << table << R"j(",)j"
+       << R"j("metadata": "{\"bb_price\":100000,\"rake\":450,\"game\":\"TP\",\"info\":\"bench\",\"min_bb\":40,\"max_bb\":100,\"chips_bb\":10}",)j"
+       << R"j("required_witnesses": 2, "owner": "1.2.10", "owner_name": "andrew", "state": "playing",)j"
+       << R"j("server_url": "stage.totalpoker.io:8092",)j"
+       << R"j("min_accepted_proposal_asset": {"amount": 20000, "asset_id": "1.3.0"},)j"
+       << R"j("pending_proposals": [)j";
+    for (size_t ci = 0; ci < cash; ++ci)
+    {
+        if (ci)
+            ss << ',';
+        ss << R"j(["1.2.)j" << 100 + ci << R"j(", {"name": "player)j" << ci << R"j(", "id": "3.7.)j" << ci
+           << R"j(", "uid": "c3f4d5e6a7b8", "amount": {"amount": 10000, "asset_id": "1.3.0"}}])j";
+    }
+    ss << R"j(], "cash": [)j";
+    for (size_t ci = 0; ci < cash; ++ci)
+    {
+        if (ci)
+            ss << ',';
+        ss << R"j(["1.2.)j" << 200 + ci << R"j(", {"name": "player)j" << ci << R"j(", "amount": {"amount": 40000, "asset_id": "1.3.0"}}])j";
+    }
+    ss << R"j(], "playing_cash": [], "missed_voters": [["1.2.300", "voter"]]})j";
+
+    return ss.str();
+}
+
+std::string make_tables(const bench_options& options)
+{
+    std::string tables;
+    for (size_t ci = 0; ci < options.tables; ++ci)
+    {
+        if (ci)
+            tables += ',';
+        tables += make_table(ci + 1, options.cash);
+    }
+    return tables;
+}
+
+void add_table_benches(std::vector<bench_case>& benches, const bench_options& options)
+{
+    static const PlaychainTableFieldsMask id_and_state = PlaychainTableFields::ID | PlaychainTableFields::STATE;
+
+    auto parser = std::make_shared<PlaychainResponseParser>();
+    auto tables = std::make_shared<std::vector<PlaychainTableInfoExt>>();
+
+    const std::string list = make_tables(options);
+    const BlockchainResponse response = R"j({"id": 1, "jsonrpc": "2.0", "result": [)j" + list + "]}";
+    const BlockchainResponse notification = R"j({"method": "notice", "params": [10, [[)j" + list + "]]]}";
+
+    benches.push_back({ "tables/full", response.size(), [=]() {
+                           parser->parseGetTablesInfoResponse(response, *tables);
+                           return tables->size();
+                       } });
+    benches.push_back({ "tables/projected", response.size(), [=]() {
+                           parser->parseGetTablesInfoResponse(response, *tables, id_and_state);
+                           return tables->size();
+                       } });
+    benches.push_back({ "tables/stream_full", response.size(), [=]() {
+                           size_t count = 0;
+                           parser->streamGetTablesInfoResponse(response, [&count](PlaychainTableInfoExt&&) { ++count; });
+                           return count;
+                       } });
+    benches.push_back({ "tables/stream_projected", response.size(), [=]() {
+                           size_t count = 0;
+                           parser->streamGetTablesInfoResponse(
+                               response, [&count](PlaychainTableInfoExt&&) { ++count; }, id_and_state);
+                           return count;
+                       } });
+    benches.push_back({ "notification/full", notification.size(), [=]() {
+                           parser->parseChangeTableInfoNotification(notification, 10, *tables);
+                           return tables->size();
+                       } });
+    benches.push_back({ "notification/projected", notification.size(), [=]() {
+                           parser->parseChangeTableInfoNotification(notification, 10, *tables, id_and_state);
+                           return tables->size();
+                       } });
+    benches.push_back({ "notification/cookie_then_parse", notification.size(), [=]() {
+                           auto&& cookie = parser->parseNotificationCookie(notification);
+                           parser->parseChangeTableInfoNotification(notification, cookie, *tables);
+                           return tables->size();
+                       } });
+
+    auto router = std::make_shared<PlaychainMessageRouter>();
+    router->subscribe(10, [=](const PlaychainParsedMessage& message) {
+        parser->parseChangeTableInfoNotification(message, *tables);
+    });
+    benches.push_back({ "notification/routed", notification.size(), [=]() {
+                           router->route(notification);
+                           return tables->size();
+                       } });
+}
+
+//puts new line and indent after every structural character as pretty printed node responses
+std::string indent_json(const std::string& json)
+{
+    std::string result;
+    bool in_string = false;
+    bool escaped = false;
+    for (char ch : json)
+    {
+        result += ch;
+        if (in_string)
+        {
+            if (escaped)
+                escaped = false;
+            else if (ch == '\\')
+                escaped = true;
+            else if (ch == '"')
+                in_string = false;
+            continue;
+        }
+        if (ch == '"')
+            in_string = true;
+        else if (ch == '{' || ch == '[' || ch == ',')
+            result += "\n                ";
+    }
+    return result;
+}
+
+//JSON parser alone and parse paths of the same response
+void add_json_benches(std::vector<bench_case>& benches, const bench_options& options)
+{
+    auto parser = std::make_shared<PlaychainResponseParser>();
+    auto tables = std::make_shared<std::vector<PlaychainTableInfoExt>>();
+    auto insitu_buffer = std::make_shared<std::string>();
+
+    const std::string list = make_tables(options);
+    const BlockchainResponse compact = R"j({"id": 1, "jsonrpc": "2.0", "result": [)j" + list + "]}";
+
+    for (const auto& format : { std::make_pair(std::string { "compact" }, compact),
+                                std::make_pair(std::string { "pretty" }, indent_json(compact)) })
+    {
+        const std::string& name = format.first;
+        const BlockchainResponse& response = format.second;
+
+        benches.push_back({ "json/" + name + "/backend_dom", response.size(), [=]() {
+                               rapidjson::Document document;
+                               document.Parse(response.c_str());
+                               return (size_t)!document.HasParseError();
+                           } });
+        benches.push_back({ "json/" + name + "/backend_dom_insitu", response.size(), [=]() {
+                               *insitu_buffer = response;
+                               rapidjson::Document document;
+                               document.ParseInsitu(&(*insitu_buffer)[0]);
+                               return (size_t)!document.HasParseError();
+                           } });
+        benches.push_back({ "json/" + name + "/backend_sax", response.size(), [=]() {
+                               rapidjson::BaseReaderHandler<> handler;
+                               rapidjson::Reader reader;
+                               rapidjson::StringStream stream(response.c_str());
+                               return (size_t)!reader.Parse(stream, handler).IsError();
+                           } });
+        benches.push_back({ "json/" + name + "/parse", response.size(), [=]() {
+                               parser->parseGetTablesInfoResponse(response, *tables);
+                               return tables->size();
+                           } });
+        benches.push_back({ "json/" + name + "/parse_buffer", response.size(), [=]() {
+                               parser->parseGetTablesInfoResponse(BlockchainResponseView { response.data(), response.size() }, *tables);
+                               return tables->size();
+                           } });
+        benches.push_back({ "json/" + name + "/parse_insitu", response.size(), [=]() {
+                               *insitu_buffer = response;
+                               parser->parseGetTablesInfoResponse(BlockchainResponseView::insitu(*insitu_buffer), *tables);
+                               return tables->size();
+                           } });
+        benches.push_back({ "json/" + name + "/view", response.size(), [=]() {
+                               auto&& view = parser->parseGetTablesInfoView(response);
+                               size_t count = 0;
+                               for (const auto& table : (const PlaychainTablesView&)view)
+                                   count += table.state() != PlaychainTableInfo::State::NOP ? 1 : 0;
+                               return count;
+                           } });
+    }
+}
+
+//object ids and string amounts, stream based conversions are baselines
+void add_codec_benches(std::vector<bench_case>& benches, const bench_options& options)
+{
+    auto ids = std::make_shared<std::vector<std::string>>();
+    auto amounts = std::make_shared<std::vector<std::string>>();
+    for (size_t ci = 0; ci < options.tables; ++ci)
+    {
+        ids->push_back((std::string)PlaychainTableId { (int)(ci * 7919 + 1) });
+        amounts->push_back(std::to_string((uint64_t)ci * 1000000007ull));
+    }
+
+    size_t ids_bytes = 0;
+    for (const auto& id : *ids)
+        ids_bytes += id.size();
+    size_t amounts_bytes = 0;
+    for (const auto& amount : *amounts)
+        amounts_bytes += amount.size();
+
+    benches.push_back({ "codec/id_format", ids_bytes, [=]() {
+                           size_t result = 0;
+                           char buff[playchain::object_id_max_chars];
+                           for (size_t ci = 0; ci < ids->size(); ++ci)
+                               result += playchain::format_object_id(3, 4, (int64_t)ci, buff);
+                           return result;
+                       } });
+    benches.push_back({ "codec/id_to_string", ids_bytes, [=]() {
+                           size_t result = 0;
+                           for (size_t ci = 0; ci < ids->size(); ++ci)
+                               result += ((std::string)PlaychainTableId { (int)ci }).size();
+                           return result;
+                       } });
+    benches.push_back({ "codec/id_to_string_stream", ids_bytes, [=]() {
+                           size_t result = 0;
+                           for (size_t ci = 0; ci < ids->size(); ++ci)
+                           {
+                               std::stringstream ss;
+                               ss << 3 << '.' << 4 << '.' << ci;
+                               result += ss.str().size();
+                           }
+                           return result;
+                       } });
+    benches.push_back({ "codec/id_from_string", ids_bytes, [=]() {
+                           size_t result = 0;
+                           for (const auto& id : *ids)
+                               result += PlaychainTableId::from_string(id.data(), id.size()).valid() ? 1 : 0;
+                           return result;
+                       } });
+    benches.push_back({ "codec/id_from_string_substr", ids_bytes, [=]() {
+                           size_t result = 0;
+                           for (const auto& id : *ids)
+                           {
+                               auto first_dot = id.find('.');
+                               auto second_dot = id.find('.', first_dot + 1);
+                               result += std::stoull(id.substr(0, first_dot)) + std::stoull(id.substr(first_dot + 1, second_dot - first_dot - 1))
+                                   + std::stoull(id.substr(second_dot + 1));
+                           }
+                           return result;
+                       } });
+    benches.push_back({ "codec/amount_parse", amounts_bytes, [=]() {
+                           uint64_t result = 0;
+                           for (const auto& amount : *amounts)
+                           {
+                               uint64_t value = 0;
+                               playchain::parse_uint64(amount.data(), amount.data() + amount.size(), value);
+                               result += value;
+                           }
+                           return (size_t)result;
+                       } });
+    benches.push_back({ "codec/amount_parse_strtoull", amounts_bytes, [=]() {
+                           uint64_t result = 0;
+                           for (const auto& amount : *amounts)
+                               result += std::strtoull(amount.c_str(), nullptr, 10);
+                           return (size_t)result;
+                       } });
+
+    auto times = std::make_shared<std::vector<std::string>>();
+    for (size_t ci = 0; ci < options.tables; ++ci)
+        times->push_back(playchain::to_iso_string((time_t)(1544092100 + ci * 86413)));
+    const size_t times_bytes = times->size() * playchain::iso_time_chars;
+
+    benches.push_back({ "codec/time_format", times_bytes, [=]() {
+                           size_t result = 0;
+                           char buff[playchain::iso_time_chars];
+                           for (size_t ci = 0; ci < times->size(); ++ci)
+                               result += playchain::format_iso_time(1544092100 + ci * 86413, buff);
+                           return result;
+                       } });
+    benches.push_back({ "codec/time_format_put_time", times_bytes, [=]() {
+                           size_t result = 0;
+                           for (size_t ci = 0; ci < times->size(); ++ci)
+                           {
+                               const time_t t = (time_t)(1544092100 + ci * 86413);
+                               std::stringstream ss;
+                               ss << std::put_time(std::gmtime(&t), "%Y-%m-%dT%H:%M:%S");
+                               result += ss.str().size();
+                           }
+                           return result;
+                       } });
+    benches.push_back({ "codec/time_parse", times_bytes, [=]() {
+                           size_t result = 0;
+                           for (const auto& time : *times)
+                               result += (size_t)playchain::from_iso_string(time.data(), time.size());
+                           return result;
+                       } });
+    benches.push_back({ "codec/time_parse_get_time", times_bytes, [=]() {
+                           size_t result = 0;
+                           for (const auto& time : *times)
+                           {
+                               std::stringstream ss { time };
+                               std::tm tm {};
+                               ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+                               result += (size_t)std::mktime(&tm);
+                           }
+                           return result;
+                       } });
+
+    auto plcs = std::make_shared<std::vector<std::string>>();
+    auto versions = std::make_shared<std::vector<std::string>>();
+    for (size_t ci = 0; ci < options.tables; ++ci)
+    {
+        plcs->push_back(PlaychainPLC { (PlaychainMoney)ci * 12345 }.str());
+        versions->push_back(ProtocolVersion { (uint8_t)(ci % 3), (uint8_t)(ci % 7), (uint16_t)ci });
+    }
+
+    benches.push_back({ "codec/plc_to_string", 0, [=]() {
+                           size_t result = 0;
+                           for (size_t ci = 0; ci < plcs->size(); ++ci)
+                               result += PlaychainPLC { (PlaychainMoney)ci * 12345 }.str().size();
+                           return result;
+                       } });
+    benches.push_back({ "codec/plc_from_string", 0, [=]() {
+                           size_t result = 0;
+                           for (const auto& plc : *plcs)
+                               result += (size_t)PlaychainPLC::from_string(plc).amount();
+                           return result;
+                       } });
+    benches.push_back({ "codec/version_to_string", 0, [=]() {
+                           size_t result = 0;
+                           for (size_t ci = 0; ci < versions->size(); ++ci)
+                               result += ((std::string)ProtocolVersion { (uint8_t)(ci % 3), (uint8_t)(ci % 7), (uint16_t)ci }).size();
+                           return result;
+                       } });
+    benches.push_back({ "codec/version_to_string_stream", 0, [=]() {
+                           size_t result = 0;
+                           for (size_t ci = 0; ci < versions->size(); ++ci)
+                           {
+                               std::stringstream ss;
+                               ss << (int)(ci % 3) << '.' << (int)(ci % 7) << '.' << (uint16_t)ci;
+                               result += ss.str().size();
+                           }
+                           return result;
+                       } });
+    benches.push_back({ "codec/version_from_string", 0, [=]() {
+                           size_t result = 0;
+                           for (const auto& version : *versions)
+                               result += ProtocolVersion { version }.v_num;
+                           return result;
+                       } });
+}
+
+//hex kernels on digest, signature and multi-kilobyte sizes
+void add_hex_benches(std::vector<bench_case>& benches)
+{
+    for (const auto& kernel : playchain::supported_hex_kernels())
+    {
+        for (size_t size : { 32, 65, 4096 })
+        {
+            auto data = std::make_shared<std::vector<uint8_t>>(size);
+            for (size_t ci = 0; ci < size; ++ci)
+                (*data)[ci] = (uint8_t)(ci * 131 + 7);
+            auto hex = std::make_shared<std::string>(size * 2, '\0');
+            kernel.encode(data->data(), size, &(*hex)[0]);
+
+            const std::string suffix = std::string { kernel.name } + "/" + std::to_string(size);
+
+            benches.push_back({ "hex/encode/" + suffix, size, [=]() {
+                                   kernel.encode(data->data(), data->size(), &(*hex)[0]);
+                                   return (size_t)(*hex)[0];
+                               } });
+            benches.push_back({ "hex/decode/" + suffix, size * 2, [=]() {
+                                   return (size_t)kernel.decode(hex->data(), hex->size(), data->data());
+                               } });
+        }
+    }
+}
+
+//previous implementation through OpenSSL BIGNUM (division per character)
+std::string bignum_to_base58(const uint8_t* data, const size_t size)
+{
+    static const char digits[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+    BN_CTX* ctx = BN_CTX_new();
+    BIGNUM* bn = BN_bin2bn(data, (int)size, nullptr);
+    BIGNUM* bn58 = BN_new();
+    BIGNUM* dv = BN_new();
+    BIGNUM* rem = BN_new();
+    BN_set_word(bn58, 58);
+
+    std::string result;
+    while (!BN_is_zero(bn))
+    {
+        BN_div(dv, rem, bn, bn58, ctx);
+        BN_copy(bn, dv);
+        result += digits[BN_get_word(rem)];
+    }
+    for (size_t ci = 0; ci < size && data[ci] == 0; ++ci)
+        result += digits[0];
+    std::reverse(result.begin(), result.end());
+
+    BN_free(rem);
+    BN_free(dv);
+    BN_free(bn58);
+    BN_free(bn);
+    BN_CTX_free(ctx);
+    return result;
+}
+
+std::vector<uint8_t> bignum_from_base58(const std::string& str)
+{
+    static const std::string digits = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+    BIGNUM* bn = BN_new();
+    BN_zero(bn);
+    for (char ch : str)
+    {
+        BN_mul_word(bn, 58);
+        BN_add_word(bn, digits.find(ch));
+    }
+
+    const size_t ones = str.find_first_not_of('1') == std::string::npos ? str.size() : str.find_first_not_of('1');
+    std::vector<uint8_t> result(ones + BN_num_bytes(bn), 0);
+    BN_bn2bin(bn, result.data() + ones);
+    BN_free(bn);
+    return result;
+}
+
+void add_base58_benches(std::vector<bench_case>& benches)
+{
+    //address, public key with checksum, WIF
+    for (size_t size : { 24, 37, 37 + 1 })
+    {
+        auto data = std::make_shared<std::vector<uint8_t>>(size);
+        for (size_t ci = 0; ci < size; ++ci)
+            (*data)[ci] = (uint8_t)(ci * 131 + 7);
+        auto encoded = std::make_shared<std::string>(playchain::base58_max_chars(size), '\0');
+        encoded->resize(playchain::encode_base58(data->data(), size, &(*encoded)[0]));
+        auto out = std::make_shared<std::string>(playchain::base58_max_chars(size), '\0');
+
+        const std::string suffix = "/" + std::to_string(size);
+
+        benches.push_back({ "base58/encode" + suffix, size, [=]() {
+                               return playchain::encode_base58(data->data(), data->size(), &(*out)[0]);
+                           } });
+        benches.push_back({ "base58/encode_ct" + suffix, size, [=]() {
+                               return playchain::encode_base58_ct(data->data(), data->size(), &(*out)[0]);
+                           } });
+        benches.push_back({ "base58/encode_bignum" + suffix, size, [=]() {
+                               return bignum_to_base58(data->data(), data->size()).size();
+                           } });
+        benches.push_back({ "base58/decode" + suffix, encoded->size(), [=]() {
+                               size_t decoded = 0;
+                               playchain::decode_base58(encoded->data(), encoded->size(), data->data(), data->size(), decoded);
+                               return decoded;
+                           } });
+        benches.push_back({ "base58/decode_ct" + suffix, encoded->size(), [=]() {
+                               size_t decoded = 0;
+                               playchain::decode_base58_ct(encoded->data(), encoded->size(), data->data(), data->size(), decoded);
+                               return decoded;
+                           } });
+        benches.push_back({ "base58/decode_bignum" + suffix, encoded->size(), [=]() {
+                               return bignum_from_base58(*encoded).size();
+                           } });
+    }
+}
+
+void add_public_key_benches(std::vector<bench_case>& benches)
+{
+    //keys of room, witnesses and players repeated in requests and responses
+    const size_t keys_count = 16;
+    auto keys = std::make_shared<std::vector<CompressedPublicKey>>(keys_count);
+    auto strings = std::make_shared<std::vector<std::string>>();
+    for (size_t ci = 0; ci < keys_count; ++ci)
+    {
+        auto& key = (*keys)[ci];
+        key[0] = 0x02 + ci % 2;
+        for (size_t cj = 1; cj < key.size(); ++cj)
+            key[cj] = (uint8_t)(ci * 37 + cj * 131 + 7);
+        strings->push_back(public_key_to_string(key));
+    }
+
+    //capacity is set in every run because all benchmarks share cache
+    for (bool cached : { true, false })
+    {
+        const size_t capacity = cached ? PlaychainPublicKeyCache::DEFAULT_CAPACITY : 0;
+        const std::string suffix = cached ? "/cached" : "/uncached";
+
+        benches.push_back({ "public_key/from_string" + suffix, keys_count * strings->front().size(), [=]() {
+                               PlaychainPublicKeyCache::instance().setCapacity(capacity);
+                               size_t result = 0;
+                               for (const auto& str : *strings)
+                                   result += public_key_from_string(str)[1];
+                               return result;
+                           } });
+        benches.push_back({ "public_key/to_string" + suffix, keys_count * keys->front().size(), [=]() {
+                               PlaychainPublicKeyCache::instance().setCapacity(capacity);
+                               size_t result = 0;
+                               for (const auto& key : *keys)
+                                   result += public_key_to_string(key).size();
+                               return result;
+                           } });
+    }
+}
+
+void add_sha256_benches(std::vector<bench_case>& benches)
+{
+    const size_t blocks_size = 4096;
+    auto blocks = std::make_shared<std::vector<uint8_t>>(blocks_size);
+    for (size_t ci = 0; ci < blocks_size; ++ci)
+        (*blocks)[ci] = (uint8_t)(ci * 131 + 7);
+
+    for (const auto& kernel : playchain::supported_sha256_kernels())
+    {
+        benches.push_back({ std::string { "sha256/blocks/" } + kernel.name, blocks_size, [=]() {
+                               uint32_t state[8];
+                               memcpy(state, playchain::sha256_initial_state, sizeof(state));
+                               kernel.compress(state, blocks->data(), blocks->size() / playchain::sha256_block_size);
+                               return (size_t)state[0];
+                           } });
+    }
+
+    //transaction digest: a few hundred bytes of 2-8 bytes writes
+    const size_t fields = 60;
+    size_t digest_bytes = 0;
+    for (size_t ci = 0; ci < fields; ++ci)
+        digest_bytes += 2 + ci % 7;
+
+    benches.push_back({ "sha256/digest/encoder", digest_bytes, [=]() {
+                           playchain::sha256::encoder encoder;
+                           for (size_t ci = 0; ci < fields; ++ci)
+                               encoder.write((const char*)blocks->data() + ci, (uint32_t)(2 + ci % 7));
+                           return (size_t)(uint8_t)encoder.result().data()[0];
+                       } });
+    //batch of transaction bodies
+    const size_t batch = 64;
+    const size_t body_size = 200;
+    auto bodies = std::make_shared<std::vector<const char*>>();
+    auto sizes = std::make_shared<std::vector<size_t>>(batch, body_size);
+    for (size_t ci = 0; ci < batch; ++ci)
+        bodies->push_back((const char*)blocks->data() + ci * (blocks_size - body_size) / batch);
+    auto digests = std::make_shared<std::vector<uint8_t>>(batch * 32);
+
+    for (const auto& kernel : playchain::supported_sha256_lanes_kernels())
+    {
+        benches.push_back({ std::string { "sha256/batch/" } + kernel.name, batch * body_size, [=]() {
+                               playchain::sha256_hash_lanes(kernel, (const uint8_t* const*)bodies->data(), sizes->data(), batch, digests->data());
+                               return (size_t)(*digests)[0];
+                           } });
+    }
+    benches.push_back({ "sha256/batch/one_by_one", batch * body_size, [=]() {
+                           size_t result = 0;
+                           for (size_t ci = 0; ci < batch; ++ci)
+                               result += (uint8_t)playchain::sha256::hash((*bodies)[ci], (uint32_t)body_size).data()[0];
+                           return result;
+                       } });
+
+    benches.push_back({ "sha256/digest/openssl", digest_bytes, [=]() {
+                           SHA256_CTX context;
+                           SHA256_Init(&context);
+                           for (size_t ci = 0; ci < fields; ++ci)
+                               SHA256_Update(&context, blocks->data() + ci, 2 + ci % 7);
+                           uint8_t digest[SHA256_DIGEST_LENGTH];
+                           SHA256_Final(digest, &context);
+                           return (size_t)digest[0];
+                       } });
+}
+
+void run_bench(const bench_case& bench, const double min_time)
+{
+    using clock = std::chrono::steady_clock;
+
+    //warm up caches and reusable buffers
+    size_t items = bench.run();
+
+    size_t iterations = 0;
+    const auto start = clock::now();
+    std::chrono::duration<double> elapsed { 0 };
+    do
+    {
+        items += bench.run();
+        ++iterations;
+        elapsed = clock::now() - start;
+    } while (elapsed.count() < min_time);
+
+    const double ns_per_op = elapsed.count() * 1e9 / iterations;
+    const double mb_per_s = bench.bytes ? (double)bench.bytes * iterations / elapsed.count() / (1024 * 1024) : 0;
+
+    std::cout << std::left << std::setw(32) << bench.name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(0) << ns_per_op << " ns/op"
+              << std::setw(10) << std::setprecision(1) << mb_per_s << " MB/s"
+              << std::setw(10) << iterations << " runs"
+              << (items ? "" : " (no items)") << '\n';
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    static const char options_title[] = "Playchain Client Benchmarks";
+    bpo::options_description cli(options_title);
+    boost::program_options::variables_map options;
+
+    try
+    {
+        set_program_options(cli);
+
+        bpo::store(bpo::parse_command_line(argc, argv, cli), options);
+        bpo::notify(options);
+    }
+    catch (const bpo::error& e)
+    {
+        std::cerr << "Error parsing command line: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (options.count("help"))
+    {
+        cli.print(std::cout);
+        return 1;
+    }
+
+    try
+    {
+        bench_options bench_opts;
+        bench_opts.tables = options["tables"].as<size_t>();
+        bench_opts.cash = options["cash"].as<size_t>();
+
+        std::vector<bench_case> benches;
+        add_table_benches(benches, bench_opts);
+        add_json_benches(benches, bench_opts);
+        add_codec_benches(benches, bench_opts);
+        add_hex_benches(benches);
+        add_base58_benches(benches);
+        add_public_key_benches(benches);
+        add_sha256_benches(benches);
+
+        std::cout << "JSON SIMD: " << playchain::json_simd_name << '\n';
+
+        const std::string& filter = options["filter"].as<std::string>();
+        const double min_time = options["min-time"].as<double>();
+
+        for (const auto& bench : benches)
+        {
+            if (bench.name.find(filter) == std::string::npos)
+                continue;
+
+            run_bench(bench, min_time);
+        }
+        std::cout << std::flush;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,446 @@
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <grp.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <playchain/playchain_helper.h>
+
+#include "../src/private_key_sec.h"
+#include "signer_protocol.h"
+
+namespace {
+namespace bpo = boost::program_options;
+
+void set_program_options(bpo::options_description& cli)
+{
+    // clang-format off
+    cli.add_options()
+            ("help,h", "Print this help message and exit.")
+            ("socket,s", bpo::value<std::string>(), "Path of Unix domain socket")
+            ("keys,k", bpo::value<std::string>(), "File of WIF keys (one per line)")
+            ("group,g", bpo::value<std::string>(), "Group allowed to connect (only owner by default)")
+            ("threads,j", bpo::value<size_t>()->default_value(0), "Signing workers (0 for all cores)")
+            ("pin", bpo::value<bool>()->default_value(true), "Pin workers to cores");
+    // clang-format on
+}
+
+bool check_mandatory_options(std::ostream& stream, const bpo::variables_map& options)
+{
+    if (!options.count("socket") || !options.count("keys"))
+    {
+        stream << "Socket and keys are requied"
+               << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+using playchain::private_key_sec;
+
+//keys are kept encrypted and decrypted for every batch
+using key_store = std::map<tp::CompressedPublicKey, private_key_sec>;
+
+key_store load_keys(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Unable to open " + path);
+
+    std::vector<std::string> wif_keys;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
+        if (!line.empty())
+            wif_keys.push_back(line);
+    }
+
+    auto&& priv_keys = tp::priv_keys_from_wif(wif_keys);
+    auto&& pub_keys = tp::public_keys_from_keys(priv_keys);
+    std::fill(priv_keys.begin(), priv_keys.end(), tp::PrivateKey {});
+
+    std::random_device random;
+    std::uniform_int_distribution<uint64_t> noise;
+
+    key_store result;
+    for (size_t ci = 0; ci < wif_keys.size(); ++ci)
+        result.emplace(pub_keys[ci], private_key_sec(wif_keys[ci], noise(random)));
+    return result;
+}
+
+struct connection
+{
+    explicit connection(const int fd)
+        : fd(fd)
+    {
+    }
+    ~connection()
+    {
+        ::close(fd);
+    }
+
+    //responses of workers are not interleaved
+    bool send(const std::vector<uint8_t>& frame)
+    {
+        std::unique_lock<std::mutex> lck(write_lock);
+
+        return signer::write_all(fd, frame.data(), frame.size());
+    }
+
+    //waits for response to one of requests if client sent too many of them,
+    //client that does not read responses stops being read too
+    void begin_request()
+    {
+        std::unique_lock<std::mutex> lck(requests_lock);
+        request_done.wait(lck, [this]() { return requests < signer::max_connection_requests; });
+        ++requests;
+    }
+
+    void reply(const std::vector<uint8_t>& frame)
+    {
+        send(frame);
+        {
+            std::unique_lock<std::mutex> lck(requests_lock);
+            --requests;
+        }
+        request_done.notify_one();
+    }
+
+    const int fd;
+
+private:
+    std::mutex write_lock;
+
+    size_t requests = 0;
+    std::mutex requests_lock;
+    std::condition_variable request_done;
+};
+
+struct job
+{
+    std::shared_ptr<connection> client;
+    signer::request_header header;
+    std::vector<tp::Digest> digests;
+};
+
+class job_queue
+{
+public:
+    void push(job&& j)
+    {
+        {
+            std::unique_lock<std::mutex> lck(lock);
+            jobs.push_back(std::move(j));
+        }
+        ready.notify_one();
+    }
+
+    //waits for job and takes queued jobs of the same key after it,
+    //pipelined requests are signed together then
+    void pop(std::vector<job>& batch)
+    {
+        batch.clear();
+
+        std::unique_lock<std::mutex> lck(lock);
+        ready.wait(lck, [this]() { return !jobs.empty(); });
+
+        size_t digests = 0;
+        do
+        {
+            digests += jobs.front().digests.size();
+            batch.push_back(std::move(jobs.front()));
+            jobs.pop_front();
+        } while (!jobs.empty() && jobs.front().header.key == batch.front().header.key
+                 && digests + jobs.front().digests.size() <= signer::max_request_digests);
+    }
+
+private:
+    std::deque<job> jobs;
+    std::mutex lock;
+    std::condition_variable ready;
+};
+
+std::vector<uint8_t> make_response(const uint32_t id, const uint32_t status, const tp::CompactSignature* signs, const uint32_t count)
+{
+    signer::response_header header;
+    header.id = id;
+    header.status = status;
+    header.count = count;
+
+    std::vector<uint8_t> frame(signer::response_header_size + count * sizeof(tp::CompactSignature));
+    signer::write_response_header(header, frame.data());
+    if (count)
+        std::memcpy(frame.data() + signer::response_header_size, signs, count * sizeof(tp::CompactSignature));
+    return frame;
+}
+
+void sign_batch(const key_store& keys, std::vector<job>& batch)
+{
+    auto it = keys.find(batch.front().header.key);
+    if (it == keys.end())
+    {
+        for (auto&& j : batch)
+            j.client->reply(make_response(j.header.id, signer::status_unknown_key, nullptr, 0));
+        return;
+    }
+
+    std::vector<tp::Digest> digests;
+    for (auto&& j : batch)
+        digests.insert(digests.end(), j.digests.begin(), j.digests.end());
+
+    std::vector<tp::CompactSignature> signs;
+    uint32_t status = signer::status_ok;
+    try
+    {
+        auto&& key = it->second.decrypt();
+        signs = tp::sign_digests(digests, key);
+        std::fill(key.begin(), key.end(), 0);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        status = signer::status_error;
+    }
+
+    size_t offset = 0;
+    for (auto&& j : batch)
+    {
+        const uint32_t count = status == signer::status_ok ? j.header.count : 0;
+        j.client->reply(make_response(j.header.id, status, signs.data() + offset, count));
+        offset += count;
+    }
+}
+
+void run_worker(const key_store& keys, job_queue& queue, const size_t core, const bool pin)
+{
+#if defined(__linux__)
+    if (pin)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#endif
+
+    std::vector<job> batch;
+    while (true)
+    {
+        queue.pop(batch);
+        sign_batch(keys, batch);
+    }
+}
+
+//reads requests until client closes connection
+void read_requests(std::shared_ptr<connection> client, job_queue& queue)
+{
+    uint8_t header_data[signer::request_header_size];
+    while (signer::read_exact(client->fd, header_data, sizeof(header_data)))
+    {
+        job j;
+        j.client = client;
+        signer::read_request_header(header_data, j.header);
+
+        //digests can't be skipped without reading them, framing is lost
+        if (j.header.count > signer::max_request_digests)
+        {
+            client->send(make_response(j.header.id, signer::status_too_many_digests, nullptr, 0));
+            break;
+        }
+
+        j.digests.resize(j.header.count);
+        if (!signer::read_exact(client->fd, j.digests.data(), j.digests.size() * sizeof(tp::Digest)))
+            break;
+
+        client->begin_request();
+        queue.push(std::move(j));
+    }
+}
+
+char socket_path[sizeof(sockaddr_un::sun_path)] = {};
+
+void stop(int)
+{
+    ::unlink(socket_path);
+    ::_exit(0);
+}
+
+struct peer_policy
+{
+    uid_t uid = ::geteuid();
+    //group allowed to connect besides owner
+    bool group_allowed = false;
+    gid_t gid = 0;
+};
+
+peer_policy make_peer_policy(const bpo::variables_map& options)
+{
+    peer_policy result;
+    if (options.count("group"))
+    {
+        const std::string& name = options["group"].as<std::string>();
+        const group* info = ::getgrnam(name.c_str());
+        if (!info)
+            throw std::runtime_error("Unknown group " + name);
+
+        result.group_allowed = true;
+        result.gid = info->gr_gid;
+    }
+    return result;
+}
+
+//the socket file mode restricts who can connect, peer is checked too
+//in case directory or file permissions are changed
+bool check_peer(const int fd, const peer_policy& policy)
+{
+    uid_t uid = 0;
+    gid_t gid = 0;
+#if defined(__linux__)
+    ucred peer = {};
+    socklen_t length = sizeof(peer);
+    if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &peer, &length) != 0)
+        return false;
+    uid = peer.uid;
+    gid = peer.gid;
+#else
+    if (::getpeereid(fd, &uid, &gid) != 0)
+        return false;
+#endif
+
+    return uid == policy.uid || (policy.group_allowed && gid == policy.gid);
+}
+
+int listen_socket(const std::string& path, const peer_policy& policy)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Too long socket path " + path);
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw std::runtime_error("Unable to create socket");
+
+    ::unlink(path.c_str());
+
+    //socket file is created with permissions of owner (and group) only,
+    //there is no time when others can connect
+    const mode_t mode = policy.group_allowed ? 0660 : 0600;
+    const mode_t previous_umask = ::umask(0777 & ~mode);
+    const bool bound = ::bind(fd, (const sockaddr*)&address, sizeof(address)) == 0;
+    ::umask(previous_umask);
+
+    if (!bound
+        || (policy.group_allowed && ::chown(path.c_str(), (uid_t)-1, policy.gid) != 0)
+        || ::listen(fd, SOMAXCONN) != 0)
+    {
+        const int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Unable to listen " + path + ": " + std::strerror(error));
+    }
+
+    std::strcpy(socket_path, path.c_str());
+    return fd;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    static const char options_title[] = "Playchain Signer";
+    bpo::options_description cli(options_title);
+    boost::program_options::variables_map options;
+
+    try
+    {
+        set_program_options(cli);
+
+        bpo::store(bpo::parse_command_line(argc, argv, cli), options);
+        bpo::notify(options);
+    }
+    catch (const bpo::error& e)
+    {
+        std::cerr << "Error parsing command line: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (options.count("help") || !check_mandatory_options(std::cerr, options))
+    {
+        cli.print(std::cout);
+        return 1;
+    }
+
+    try
+    {
+        const key_store keys = load_keys(options["keys"].as<std::string>());
+
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        size_t threads = options["threads"].as<size_t>();
+        if (!threads)
+            threads = cores;
+
+        //responses to closed connections should not kill signer
+        std::signal(SIGPIPE, SIG_IGN);
+
+        const peer_policy policy = make_peer_policy(options);
+
+        int fd = listen_socket(options["socket"].as<std::string>(), policy);
+        std::signal(SIGINT, stop);
+        std::signal(SIGTERM, stop);
+
+        job_queue queue;
+        for (size_t ci = 0; ci < threads; ++ci)
+        {
+            std::thread(run_worker, std::cref(keys), std::ref(queue), ci % cores, options["pin"].as<bool>()).detach();
+        }
+
+        std::cerr << "Loaded " << keys.size() << " keys, " << threads << " workers, listening " << socket_path << std::endl;
+
+        while (true)
+        {
+            int client_fd = ::accept(fd, nullptr, nullptr);
+            if (client_fd < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                throw std::runtime_error(std::string("Unable to accept connection: ") + std::strerror(errno));
+            }
+
+            if (!check_peer(client_fd, policy))
+            {
+                std::cerr << "Connection of not allowed user is refused" << std::endl;
+                ::close(client_fd);
+                continue;
+            }
+
+            std::thread(read_requests, std::make_shared<connection>(client_fd), std::ref(queue)).detach();
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <playchain/playchain_helper.h>
+
+#include "signer_protocol.h"
+
+namespace {
+namespace bpo = boost::program_options;
+
+using clock_type = std::chrono::steady_clock;
+
+void set_program_options(bpo::options_description& cli)
+{
+    // clang-format off
+    cli.add_options()
+            ("help,h", "Print this help message and exit.")
+            ("socket,s", bpo::value<std::string>(), "Path of signer socket")
+            ("public,p", bpo::value<std::string>(), "Public key of signer key")
+            ("requests,r", bpo::value<size_t>()->default_value(10000), "Requests to send")
+            ("digests,d", bpo::value<size_t>()->default_value(1), "Digests per request")
+            ("pipeline,q", bpo::value<size_t>()->default_value(1), "Requests in flight");
+    // clang-format on
+}
+
+bool check_mandatory_options(std::ostream& stream, const bpo::variables_map& options)
+{
+    if (!options.count("socket") || !options.count("public"))
+    {
+        stream << "Socket and public key are requied"
+               << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+int connect_socket(const std::string& path)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Too long socket path " + path);
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, (const sockaddr*)&address, sizeof(address)) != 0)
+        throw std::runtime_error("Unable to connect " + path + ": " + std::strerror(errno));
+    return fd;
+}
+
+double percentile(const std::vector<double>& sorted, const double p)
+{
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+}
+} // namespace
+
+//stands in for game server: sends digests to signer and measures latency of responses
+int main(int argc, char* argv[])
+{
+    static const char options_title[] = "Playchain Signer Benchmark";
+    bpo::options_description cli(options_title);
+    boost::program_options::variables_map options;
+
+    try
+    {
+        set_program_options(cli);
+
+        bpo::store(bpo::parse_command_line(argc, argv, cli), options);
+        bpo::notify(options);
+    }
+    catch (const bpo::error& e)
+    {
+        std::cerr << "Error parsing command line: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (options.count("help") || !check_mandatory_options(std::cerr, options))
+    {
+        cli.print(std::cout);
+        return 1;
+    }
+
+    try
+    {
+        const size_t requests = options["requests"].as<size_t>();
+        const size_t digests = std::min<size_t>(options["digests"].as<size_t>(), signer::max_request_digests);
+        const size_t pipeline = std::max<size_t>(options["pipeline"].as<size_t>(), 1);
+        if (!requests)
+            throw std::runtime_error("No requests to send");
+
+        signer::request_header header;
+        header.count = (uint32_t)digests;
+        header.key = tp::public_key_from_string(options["public"].as<std::string>());
+
+        std::vector<uint8_t> request(signer::request_header_size + digests * sizeof(tp::Digest));
+        for (size_t ci = signer::request_header_size; ci < request.size(); ++ci)
+            request[ci] = (uint8_t)(ci * 131 + 7);
+
+        std::vector<uint8_t> signs(signer::max_request_digests * sizeof(tp::CompactSignature));
+        uint8_t response_data[signer::response_header_size];
+
+        const int fd = connect_socket(options["socket"].as<std::string>());
+
+        std::vector<clock_type::time_point> sent_at(requests);
+        std::vector<double> latencies;
+        latencies.reserve(requests);
+
+        auto start = clock_type::now();
+
+        size_t sent = 0;
+        while (latencies.size() < requests)
+        {
+            while (sent < requests && sent - latencies.size() < pipeline)
+            {
+                header.id = (uint32_t)sent;
+                signer::write_request_header(header, request.data());
+                //every request has other digests
+                std::memcpy(request.data() + signer::request_header_size, &header.id, sizeof(header.id));
+
+                sent_at[sent] = clock_type::now();
+                if (!signer::write_all(fd, request.data(), request.size()))
+                    throw std::runtime_error("Signer closed connection");
+                ++sent;
+            }
+
+            signer::response_header response;
+            if (!signer::read_exact(fd, response_data, sizeof(response_data)))
+                throw std::runtime_error("Signer closed connection");
+            signer::read_response_header(response_data, response);
+            if (response.status != signer::status_ok || response.count != digests || response.id >= sent)
+                throw std::runtime_error("Signer failed request " + std::to_string(response.id) + ", status " + std::to_string(response.status));
+            if (!signer::read_exact(fd, signs.data(), response.count * sizeof(tp::CompactSignature)))
+                throw std::runtime_error("Signer closed connection");
+
+            latencies.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - sent_at[response.id]).count());
+        }
+
+        const double seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+        ::close(fd);
+
+        std::sort(latencies.begin(), latencies.end());
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << requests << " requests of " << digests << " digests, pipeline " << pipeline << '\n'
+                  << std::setw(12) << requests * digests / seconds << " signatures/sec\n"
+                  << "latency, us: p50 " << percentile(latencies, 0.5)
+                  << ", p90 " << percentile(latencies, 0.9)
+                  << ", p99 " << percentile(latencies, 0.99)
+                  << ", max " << latencies.back() << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+
+    return 0;
+}
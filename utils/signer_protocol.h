@@ -0,0 +1,120 @@
+#pragma once
+
+#include <playchain/playchain_types.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+
+/* Framing of playchain_signer requests over Unix domain socket.
+ *
+ * Peers are on the same host, integers are in host byte order.
+ *
+ * request:  id (4) | count (4) | public key (33) | count digests (32 each)
+ * response: id (4) | status (4) | count (4) | count signatures (65 each)
+ *
+ * Client may send next requests without waiting for responses.
+ * Requests are signed by pool of workers, so responses can come
+ * in other order, client matches them by id.
+ * Signer reads no more requests of connection while it has
+ * max_connection_requests ones not answered.
+*/
+
+namespace signer {
+
+enum status : uint32_t
+{
+    status_ok = 0,
+    status_unknown_key = 1,
+    status_too_many_digests = 2,
+    status_error = 3,
+};
+
+//digests in one request
+constexpr uint32_t max_request_digests = 4096;
+
+//requests of one connection queued or being signed
+constexpr size_t max_connection_requests = 64;
+
+constexpr size_t request_header_size = 4 + 4 + sizeof(tp::CompressedPublicKey);
+constexpr size_t response_header_size = 4 + 4 + 4;
+
+struct request_header
+{
+    uint32_t id = 0;
+    uint32_t count = 0;
+    tp::CompressedPublicKey key;
+};
+
+struct response_header
+{
+    uint32_t id = 0;
+    uint32_t status = status_ok;
+    uint32_t count = 0;
+};
+
+inline void write_request_header(const request_header& header, uint8_t* out)
+{
+    std::memcpy(out, &header.id, 4);
+    std::memcpy(out + 4, &header.count, 4);
+    std::memcpy(out + 8, header.key.data(), header.key.size());
+}
+
+inline void read_request_header(const uint8_t* in, request_header& header)
+{
+    std::memcpy(&header.id, in, 4);
+    std::memcpy(&header.count, in + 4, 4);
+    std::memcpy(header.key.data(), in + 8, header.key.size());
+}
+
+inline void write_response_header(const response_header& header, uint8_t* out)
+{
+    std::memcpy(out, &header.id, 4);
+    std::memcpy(out + 4, &header.status, 4);
+    std::memcpy(out + 8, &header.count, 4);
+}
+
+inline void read_response_header(const uint8_t* in, response_header& header)
+{
+    std::memcpy(&header.id, in, 4);
+    std::memcpy(&header.status, in + 4, 4);
+    std::memcpy(&header.count, in + 8, 4);
+}
+
+//false if peer closed socket or on error
+inline bool read_exact(int fd, void* data, size_t size)
+{
+    uint8_t* p = static_cast<uint8_t*>(data);
+    while (size)
+    {
+        ssize_t n = ::read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+inline bool write_all(int fd, const void* data, size_t size)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (size)
+    {
+        ssize_t n = ::write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+} // namespace signer